@@ -3,7 +3,6 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <time.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,7 +17,8 @@ typedef enum {
     ALARM_TYPE_SMOKE,              // 烟雾报警
     ALARM_TYPE_LIGHT_HIGH,         // 光照过强报警
     ALARM_TYPE_LIGHT_LOW,          // 光照不足报警
-    ALARM_TYPE_SYSTEM_ERROR        // 系统错误报警
+    ALARM_TYPE_SYSTEM_ERROR,       // 系统错误报警
+    ALARM_TYPE_HEAT_INDEX_HIGH     // 体感温度过高报警
 } AlarmType;
 
 // 报警级别定义
@@ -42,7 +42,7 @@ typedef struct {
 typedef struct {
     AlarmType type;           // 报警类型
     AlarmLevel level;         // 报警级别
-    time_t timestamp;         // 触发时间
+    uint64_t timestamp;       // 触发时间(单调时钟, us)
     float value;              // 触发值
     char description[128];    // 报警描述
 } AlarmRecord;
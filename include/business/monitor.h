@@ -0,0 +1,59 @@
+#ifndef BUSINESS_MONITOR_H
+#define BUSINESS_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 各分辨率保留的桶数量: 60秒, 60分钟, 24小时
+#define MONITOR_SECOND_BUCKETS  60
+#define MONITOR_MINUTE_BUCKETS  60
+#define MONITOR_HOUR_BUCKETS    24
+
+// 汇总分辨率
+typedef enum {
+    MONITOR_RESOLUTION_SECOND,  // 1秒
+    MONITOR_RESOLUTION_MINUTE,  // 1分钟
+    MONITOR_RESOLUTION_HOUR,    // 1小时
+    MONITOR_RESOLUTION_MAX
+} MonitorResolution;
+
+// 汇总桶, 同时也用作时间窗口的汇总结果
+typedef struct {
+    uint64_t start;   // 桶起始时间戳(us, 按桶宽度对齐)
+    float min;        // 最小值
+    float max;        // 最大值
+    float sum;        // 累加和
+    float last;       // 最新值
+    uint32_t count;   // 样本数量
+} RollupBucket;
+
+// 初始化监测汇总模块
+int MonitorInit(void);
+
+// 输入一个通道样本(时间戳单位us), 每个分辨率只更新当前桶, 跨越桶边界时复用最旧的桶
+int MonitorFeed(SensorChannel channel, uint64_t timestamp, float value);
+
+// 获取指定分辨率下仍在保留范围内的桶(从旧到新)
+int MonitorGetBuckets(SensorChannel channel, MonitorResolution resolution,
+    RollupBucket* buckets, uint32_t max_count, uint32_t* actual_count);
+
+// 汇总最近window_ms毫秒内的数据, 自动选择能覆盖该窗口的最细分辨率
+// 窗口按桶宽度对齐, 即包含当前桶在内的最近window_ms/桶宽度个桶
+int MonitorGetWindow(SensorChannel channel, uint32_t window_ms, RollupBucket* summary);
+
+// 清空所有汇总数据
+int MonitorReset(void);
+
+// 反初始化监测汇总模块
+int MonitorDeinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BUSINESS_MONITOR_H
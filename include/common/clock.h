@@ -0,0 +1,35 @@
+#ifndef COMMON_CLOCK_H
+#define COMMON_CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 时间单位换算
+#define CLOCK_US_PER_MS   1000ULL
+#define CLOCK_US_PER_SEC  1000000ULL
+
+// 获取单调时钟(us), 从系统启动开始计时, 64位不会回绕
+// 各模块的时间戳统一使用该时钟, 可直接比较先后及计算延迟
+uint64_t ClockNowUs(void);
+
+// 获取单调时钟(ms)的低32位, 仅用于计算时间间隔, 约49.7天回绕一次
+uint32_t ClockNowMs(void);
+
+// 设置当前墙上时间(Unix时间, us), 例如网络校时后调用, 不影响单调时钟
+int ClockSetWallTime(uint64_t wall_us);
+
+// 墙上时间是否已设置
+bool ClockHasWallTime(void);
+
+// 将单调时钟时间换算为墙上时间(us), 未设置墙上时间时返回-1
+int ClockToWallTime(uint64_t mono_us, uint64_t* wall_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMON_CLOCK_H
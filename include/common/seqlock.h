@@ -0,0 +1,53 @@
+#ifndef COMMON_SEQLOCK_H
+#define COMMON_SEQLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 双缓冲版本锁(单写者/多读者)
+// 写者交替写入两个缓冲区, 写完后发布版本号; 读者读取版本号对应的缓冲区,
+// 复制后确认写者没有开始覆盖该缓冲区即可. 读者从不等待写者, 只有在复制期间
+// 写者又完成一次完整更新时才需要重读, 高优先级读者也不会因写者被抢占而自旋
+typedef struct {
+    uint32_t seq;      // 已发布的版本号, 缓冲区下标为seq & 1
+    uint32_t writing;  // 正在写入或已写完的版本号
+} SeqLock;
+
+// 写者开始更新, 返回本次应写入的缓冲区下标
+static inline uint32_t SeqLockWriteBegin(SeqLock* lock)
+{
+    uint32_t next = lock->seq + 1;
+
+    __atomic_store_n(&lock->writing, next, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return next & 1;
+}
+
+// 写者完成更新并发布新版本
+static inline void SeqLockWriteEnd(SeqLock* lock)
+{
+    __atomic_store_n(&lock->seq, lock->writing, __ATOMIC_RELEASE);
+}
+
+// 读者获取当前版本号, 应读取的缓冲区下标为返回值 & 1
+static inline uint32_t SeqLockReadBegin(const SeqLock* lock)
+{
+    return __atomic_load_n(&lock->seq, __ATOMIC_ACQUIRE);
+}
+
+// 读者复制完成后检查快照是否一致
+static inline bool SeqLockReadValid(const SeqLock* lock, uint32_t seq)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->writing, __ATOMIC_RELAXED) - seq < 2;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMON_SEQLOCK_H
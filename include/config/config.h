@@ -4,13 +4,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "business/alarm.h"
+#include "data/calibration.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 // 配置版本号
-#define CONFIG_VERSION 1
+#define CONFIG_VERSION 2
 
 // 配置错误码定义
 typedef enum {
@@ -36,6 +37,7 @@ typedef struct {
     bool mq2_enabled;             // 是否启用MQ2
     bool bh1750_enabled;          // 是否启用BH1750
     uint32_t cache_size;          // 数据缓存大小
+    ChannelCalibration calibration[SENSOR_CHANNEL_MAX];  // 各通道定点校准系数, 加载或修改时下发到采集器
 } SensorConfig;
 
 // LED配置
@@ -63,7 +65,7 @@ typedef struct {
     uint32_t rule_count;        // 实际的报警规则数量
 } Config;
 
-// 初始化配置管理模块
+// 初始化配置管理模块, 应在CollectorInit之后调用, 传感器配置中的校准系数随即下发到采集器
 int ConfigInit(void);
 
 // 加载配置
@@ -78,7 +80,7 @@ const Config* ConfigGet(void);
 // 设置系统配置
 int ConfigSetSystem(const SystemConfig* config);
 
-// 设置传感器配置
+// 设置传感器配置, 校准系数立即下发到采集器
 int ConfigSetSensor(const SensorConfig* config);
 
 // 设置LED配置
@@ -66,7 +66,7 @@ typedef struct {
 
 // 控制历史记录
 typedef struct {
-    uint32_t timestamp;          // 时间戳
+    uint64_t timestamp;          // 时间戳(单调时钟, us)
     uint8_t device_id;           // 设备ID
     uint8_t action;              // 控制动作
     uint8_t result;              // 执行结果
@@ -0,0 +1,31 @@
+#ifndef ADAPTIVE_RATE_H
+#define ADAPTIVE_RATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单个传感器的自适应采样状态
+// 有变化时立即切换到最短周期, 平稳时每个样本放慢1/4, 快升慢降避免周期来回抖动
+typedef struct {
+    uint32_t period_ms;                // 当前采样周期(ms)
+    bool valid;                        // 是否已有上一样本
+    float last[SENSOR_CHANNEL_MAX];    // 上一样本各通道的数值
+} AdaptiveRate;
+
+// 初始化自适应采样状态, 从基础周期开始
+void AdaptiveRateInit(AdaptiveRate* rate, uint32_t base_period_ms);
+
+// 输入一个样本, dt_ms为与上一样本的间隔, 返回下一次采样的周期(ms)
+uint32_t AdaptiveRateUpdate(AdaptiveRate* rate, const AdaptiveConfig* config, const SensorData* data,
+    uint32_t dt_ms, uint32_t base_period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADAPTIVE_RATE_H
@@ -0,0 +1,49 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/sensor_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 校准多项式最高阶数
+#define CALIBRATION_MAX_ORDER 3
+
+// 通道校准系数(定点)
+// 输入为按满量程归一化的原始读数u(0 <= |u| < 1), 输出 = coef[0] + coef[1]*u + coef[2]*u^2 + coef[3]*u^3,
+// 系数以输出单位的1/256表示. 各通道原始读数: 温度/湿度为0.1℃/0.1%(满量程1024),
+// 烟雾为12位ADC值, 光照为BH1750的16位计数
+typedef struct {
+    uint8_t order;                              // 多项式阶数(1为偏移+增益), 0表示使用默认系数
+    int32_t coef[CALIBRATION_MAX_ORDER + 1];    // coef[0]为偏移, coef[1]为增益, 其余为可选的高阶项
+} ChannelCalibration;
+
+// 校准系数及定点输出的小数位数
+#define CALIBRATION_FRAC_BITS 8
+
+// 默认校准系数, 与驱动原来的浮点换算一致
+#define CALIBRATION_DEFAULT_TEMPERATURE  {1, {0, 26214}}     // 0.1℃/LSB
+#define CALIBRATION_DEFAULT_HUMIDITY     {1, {0, 26214}}     // 0.1%/LSB
+#define CALIBRATION_DEFAULT_SMOKE        {1, {0, 104858}}    // 0.1ppm/LSB
+#define CALIBRATION_DEFAULT_LIGHT        {1, {0, 13981013}}  // 1/1.2lux/LSB
+
+// 获取通道的默认校准系数
+void CalibrationDefault(SensorChannel channel, ChannelCalibration* calibration);
+
+// 检查校准系数是否有效, order为0(使用默认系数)也视为有效
+bool CalibrationIsValid(const ChannelCalibration* calibration);
+
+// 按校准系数换算原始读数, 返回定点值(输出单位的1/256), 只使用整数运算
+int32_t CalibrationApplyFixed(const ChannelCalibration* calibration, SensorChannel channel, int32_t raw);
+
+// 按校准系数换算原始读数, 定点结果只做一次整数到浮点的转换
+float CalibrationApply(const ChannelCalibration* calibration, SensorChannel channel, int32_t raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALIBRATION_H
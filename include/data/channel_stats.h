@@ -0,0 +1,39 @@
+#ifndef CHANNEL_STATS_H
+#define CHANNEL_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 通道在线统计状态, 内存占用固定, 每个样本O(1)更新
+// 均值/方差使用Welford算法, 避免累加平方和带来的精度损失;
+// EWMA按实际采样间隔计算系数 alpha = dt / (tau + dt), 采样间隔变化时时间常数不变
+typedef struct {
+    uint32_t tau_ms[COLLECTOR_EWMA_COUNT];  // EWMA时间常数(ms)
+    uint32_t count;                          // 样本数量
+    float mean;                              // 均值
+    float m2;                                // 与均值之差的平方和
+    float ewma[COLLECTOR_EWMA_COUNT];        // 指数加权移动平均
+} ChannelStatsState;
+
+// 初始化在线统计, tau_ms为各EWMA的时间常数
+void ChannelStatsInit(ChannelStatsState* state, const uint32_t* tau_ms);
+
+// 清空统计值, 保留时间常数
+void ChannelStatsReset(ChannelStatsState* state);
+
+// 输入一个样本, dt_ms为与前一样本的间隔
+void ChannelStatsUpdate(ChannelStatsState* state, float value, uint32_t dt_ms);
+
+// 导出统计结果(不含时间戳)
+void ChannelStatsGet(const ChannelStatsState* state, ChannelStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHANNEL_STATS_H
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "data/sensor_channel.h"
+#include "data/calibration.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,10 +32,19 @@ typedef enum {
     SENSOR_TYPE_DHT11 = 0,  // DHT11温湿度传感器
     SENSOR_TYPE_MQ2,        // MQ2烟雾传感器
     SENSOR_TYPE_BH1750,     // BH1750光照传感器
-    SENSOR_TYPE_MAX,
+    SENSOR_TYPE_MAX,        // 真实传感器数量
+    // 虚拟传感器, 由真实传感器的最新数据派生, 读取时按需计算
+    SENSOR_TYPE_DEW_POINT,          // 露点(℃), 来自DHT11
+    SENSOR_TYPE_HEAT_INDEX,         // 体感温度(℃), 来自DHT11
+    SENSOR_TYPE_ABS_HUMIDITY,       // 绝对湿度(g/m³), 来自DHT11
+    SENSOR_TYPE_SMOKE_LIGHT_RATIO,  // 烟雾浓度与光照强度之比, 来自MQ2和BH1750
+    SENSOR_TYPE_VIRTUAL_MAX,
     SENSOR_TYPE_ALL = 0xFF  // 所有传感器
 } SensorType;
 
+// 虚拟传感器数量
+#define SENSOR_TYPE_VIRTUAL_COUNT (SENSOR_TYPE_VIRTUAL_MAX - SENSOR_TYPE_MAX - 1)
+
 // DHT11传感器数据
 typedef struct {
     float temperature;  // 温度值(℃)
@@ -50,29 +61,316 @@ typedef struct {
     float light;  // 光照强度(lux)
 } BH1750Data;
 
+// 虚拟传感器数据
+typedef struct {
+    float value;  // 派生值
+} DerivedData;
+
 // 传感器数据联合体
 typedef union {
-    DHT11Data dht11;    // DHT11数据
-    MQ2Data mq2;        // MQ2数据
-    BH1750Data bh1750;  // BH1750数据
+    DHT11Data dht11;      // DHT11数据
+    MQ2Data mq2;          // MQ2数据
+    BH1750Data bh1750;    // BH1750数据
+    DerivedData derived;  // 虚拟传感器数据
 } SensorDataUnion;
 
 // 传感器数据结构
 typedef struct {
     SensorType type;        // 传感器类型
     SensorDataUnion data;   // 传感器数据
-    uint32_t timestamp;     // 数据采集时间戳
+    uint64_t timestamp;     // 数据采集时间戳(单调时钟, us)
 } SensorData;
 
+// 多传感器数据帧, 采集任务在写入新样本的采集周期组装一次, 包含所有通道的最新值
+typedef struct {
+    uint32_t seq;                            // 帧序号, 每组装一次加1
+    uint32_t valid_mask;                     // 有效通道掩码(按SensorChannel置位), 尚无数据或传感器已降级时无效
+    uint32_t updated_mask;                   // 本周期更新的通道掩码
+    float value[SENSOR_CHANNEL_MAX];         // 各通道最新数值
+    uint64_t timestamp[SENSOR_CHANNEL_MAX];  // 各通道数值的采集时间戳(us)
+} SensorFrame;
+
+// 数据帧中的通道是否有效
+#define SENSOR_FRAME_VALID(frame, channel)  ((((frame)->valid_mask) >> (channel)) & 1U)
+
+// 单个传感器的采样调度参数
+typedef struct {
+    uint32_t period_ms;   // 采样周期(ms), 0表示使用collect_interval
+    uint32_t phase_ms;    // 相对启动时刻的相位偏移(ms)
+    uint8_t priority;     // 优先级(同时到期时数值大者先采), 0表示使用默认优先级
+} SensorSchedule;
+
+// 每通道最多的滤波级数及中值滤波最大窗口
+#define COLLECTOR_FILTER_STAGES  4
+#define COLLECTOR_MEDIAN_MAX     7
+
+// 滤波级类型
+typedef enum {
+    FILTER_STAGE_NONE = 0,     // 不滤波
+    FILTER_STAGE_MEDIAN,       // N点中值, 去除孤立毛刺
+    FILTER_STAGE_RATE_LIMIT,   // 变化率限制, 单位时间变化量超过上限时截断
+    FILTER_STAGE_EMA,          // 指数平滑 y += alpha * (x - y)
+    FILTER_STAGE_IIR           // 定点一阶低通 y += (x - y) >> shift
+} FilterStageType;
+
+// 单级滤波参数, 只有与type对应的参数有效
+typedef struct {
+    FilterStageType type;   // 滤波类型
+    uint8_t window;         // 中值窗口(奇数, 不超过COLLECTOR_MEDIAN_MAX)
+    uint8_t shift;          // 定点低通移位数(1-8)
+    float max_rate;         // 每秒最大变化量
+    float alpha;            // 平滑系数(0-1)
+} FilterStage;
+
+// 通道滤波链配置, 按顺序依次执行
+typedef struct {
+    uint8_t stage_count;                        // 滤波级数
+    FilterStage stages[COLLECTOR_FILTER_STAGES];  // 各级参数
+} ChannelFilterConfig;
+
+// 传感器健康状态
+typedef enum {
+    SENSOR_HEALTH_OK = 0,      // 正常
+    SENSOR_HEALTH_RETRYING,    // 读取失败, 正在重试
+    SENSOR_HEALTH_DEGRADED     // 连续失败, 按退避间隔降频读取
+} SensorHealthState;
+
+// 传感器故障处理策略
+typedef struct {
+    uint8_t max_retries;            // 每个采样周期内最多的快速重试次数, 0表示不重试
+    uint32_t retry_delay_ms;        // 第一次重试的延迟(ms), 之后每次加倍
+    uint32_t degrade_threshold;     // 连续失败达到该次数后进入降级状态
+    uint32_t max_backoff_ms;        // 降级状态下的最大读取间隔(ms)
+} HealthPolicy;
+
+// 传感器健康信息
+typedef struct {
+    SensorHealthState state;        // 健康状态
+    uint32_t consecutive_failures;  // 连续失败次数
+    uint32_t total_reads;           // 读取总次数
+    uint32_t total_failures;        // 失败总次数
+    uint32_t retries;               // 当前周期已用的重试次数
+    uint32_t backoff_ms;            // 降级状态下的当前读取间隔(ms)
+    uint64_t last_success_ts;       // 最近一次读取成功的时间戳(us)
+} SensorHealth;
+
+// 回调投递方式
+typedef enum {
+    DELIVERY_MODE_SYNC = 0,    // 在采集任务中直接回调
+    DELIVERY_MODE_ASYNC        // 经消息队列交给投递任务回调, 采集不受回调耗时影响
+} DeliveryMode;
+
+// 异步投递队列满时的处理策略
+typedef enum {
+    DELIVERY_DROP_OLDEST = 0,  // 丢弃队列中最旧的样本
+    DELIVERY_DROP_NEWEST,      // 丢弃新样本
+    DELIVERY_COALESCE          // 每种传感器只保留最新一个待投递样本
+} DeliveryPolicy;
+
+// 回调投递配置
+typedef struct {
+    DeliveryMode mode;         // 投递方式
+    DeliveryPolicy policy;     // 队列满时的处理策略
+    uint32_t queue_size;       // 队列长度, 0表示默认值
+} DeliveryConfig;
+
+// 异步投递统计
+typedef struct {
+    uint32_t enqueued;         // 入队样本数
+    uint32_t delivered;        // 已投递样本数
+    uint32_t dropped;          // 因队列满丢弃的样本数
+    uint32_t coalesced;        // 被同类新样本覆盖的样本数
+    uint32_t max_depth;        // 队列最大深度
+} DeliveryStats;
+
+// 通道自适应采样参数
+// 变化率达到rate或数值进入阈值附近margin范围内时切换到最短周期;
+// 变化率低于rate的一半时逐步放慢到最长周期, 两者之间保持当前周期
+typedef struct {
+    float rate;      // 视为快速变化的变化率(单位/秒), 0表示不按变化率调整
+    float high;      // 上限报警阈值, 不使用时设为较大值
+    float low;       // 下限报警阈值, 不使用时设为较小值
+    float margin;    // 接近阈值的判定范围, 0表示不按阈值调整
+} AdaptiveChannel;
+
+// 自适应采样配置
+typedef struct {
+    bool enabled;                               // 是否启用自适应采样
+    uint32_t min_period_ms;                     // 最短采样周期(ms), 0表示基础周期的1/4
+    uint32_t max_period_ms;                     // 最长采样周期(ms), 0表示基础周期的4倍
+    AdaptiveChannel channel[SENSOR_CHANNEL_MAX];  // 各通道参数
+} AdaptiveConfig;
+
+// 报警触发捕获配置("示波器模式")
+// 平时保留最近pre_ms的原始样本, 触发后所有传感器按突发周期采样post_ms, 捕获冻结直到释放
+typedef struct {
+    uint32_t pre_ms;            // 触发前保留的时长(ms), 0表示不启用
+    uint32_t post_ms;           // 触发后采集的时长(ms)
+    uint32_t burst_period_ms;   // 触发后的采样周期(ms), 0表示默认值(100ms), DHT11不低于1秒
+    uint32_t capacity;          // 捕获缓冲区容量(样本数), 0表示按最短采样周期估算(含自适应采样)
+} CaptureConfig;
+
+// 已完成的触发捕获, 指向捕获缓冲区内部, 释放前保持不变
+// 所有传感器的原始样本(滤波前)按时间顺序排列, 缓冲区回绕时分为两段
+typedef struct {
+    uint64_t trigger_ts;         // 触发时间戳(us)
+    uint32_t pre_count;          // 触发前的样本数, 之后的样本在触发后采集
+    const SensorData* part[2];   // 两段样本, 第一段在前
+    uint32_t count[2];           // 两段的样本数
+    bool truncated;              // 缓冲区容量不足, 触发前窗口最旧的样本被覆盖或触发后窗口提前结束
+} CaptureView;
+
+// 传感器读取统计
+typedef struct {
+    uint32_t bus_reads;   // 完成的物理读取次数, 异步转换未完成后的重读计为一次
+    uint32_t joined;      // 合并到其他任务尚未完成的读取请求的请求数
+    uint32_t cache_hits;  // 直接返回有效期内结果的请求数
+} SensorReadStats;
+
+// 持久化日志读取游标
+typedef struct {
+    uint32_t seq;   // 扇区顺序号
+    uint32_t slot;  // 扇区内记录槽位
+} FlashLogCursor;
+
+// 持久化日志记录标志
+#define FLASH_LOG_FLAG_CAPTURE 0x0001  // 触发捕获的原始样本(滤波前), 与同时间戳的常规记录并存
+
+// 持久化日志记录
+typedef struct {
+    uint16_t boot;    // 写入时的启动序号, 时间戳只在同一次启动内可比较
+    uint16_t flags;   // 记录标志(FLASH_LOG_FLAG_*)
+    SensorData data;  // 传感器数据
+} FlashLogEntry;
+
+// 持久化日志统计
+typedef struct {
+    uint32_t appended;         // 追加的记录数
+    uint32_t page_writes;      // 页写入次数
+    uint32_t erases;           // 扇区擦除次数
+    uint32_t crc_errors;       // 读取时校验失败的记录数
+    uint32_t write_errors;     // 写入或擦除失败次数
+    uint32_t min_erase_count;  // 各扇区最少擦除次数
+    uint32_t max_erase_count;  // 各扇区最多擦除次数
+    uint32_t foreign_sectors;  // 不属于日志而被跳过的扇区数
+} FlashLogStats;
+
+// 持久化日志, 定义见data/flash_log.h
+typedef struct FlashLog FlashLog;
+
+// 每通道的EWMA数量
+#define COLLECTOR_EWMA_COUNT 2
+
 // 采集器配置结构
 typedef struct {
-    uint32_t collect_interval;  // 采集间隔(ms)
-    uint32_t cache_size;        // 缓存大小
+    uint32_t collect_interval;                  // 默认采集间隔(ms)
+    uint32_t cache_size;                        // 每个传感器的缓存内存预算(按完整样本计), 最近几个样本保留完整格式, 其余用于定点压缩历史
+    SensorSchedule schedule[SENSOR_TYPE_MAX];   // 各传感器独立的调度参数
+    uint32_t history_size;                      // 定点压缩历史容量, 0表示按cache_size的剩余预算换算
+    uint32_t archive_blocks;                    // 每通道长期归档的压缩块数量(256字节/块), 0表示默认值
+    uint32_t ewma_tau_ms[COLLECTOR_EWMA_COUNT]; // EWMA时间常数(ms), 0表示默认值(10s/60s)
+    uint32_t window_ms[SENSOR_CHANNEL_MAX];     // 各通道滑动窗口长度(ms), 0表示默认值(60s)
+    uint32_t window_capacity;                   // 滑动窗口队列容量, 0表示按窗口长度和最短采样周期估算
+    ChannelFilterConfig filter[SENSOR_CHANNEL_MAX];  // 各通道滤波链, 默认不滤波
+    DeliveryConfig delivery;                    // 回调投递配置, 默认同步回调
+    HealthPolicy health;                        // 传感器故障处理策略, 全0表示默认值
+    AdaptiveConfig adaptive;                    // 自适应采样配置, 基础周期为各传感器的调度周期
+    FlashLog* flash_log;                        // 持久化日志(需已打开), 由低优先级任务写入, NULL表示不持久化
+    uint32_t fresh_ttl_ms[SENSOR_TYPE_MAX];     // 按需读取结果的新鲜度有效期(ms), 0表示默认值(100ms, 不低于驱动的最小读取间隔)
+    CaptureConfig capture;                      // 报警触发捕获配置, 默认不启用
 } CollectorConfig;
 
+// 单通道样本
+typedef struct {
+    uint64_t timestamp;  // 时间戳(us)
+    float value;         // 数值
+} ChannelSample;
+
+// 通道统计摘要
+typedef struct {
+    float min;          // 最小值
+    float max;          // 最大值
+    float mean;         // 平均值
+    uint32_t count;     // 样本数量
+} ChannelSummary;
+
+// 通道在线统计, 每个样本O(1)更新
+typedef struct {
+    uint32_t count;                      // 样本数量
+    float mean;                          // 均值(Welford)
+    float variance;                      // 样本方差(Welford)
+    float ewma[COLLECTOR_EWMA_COUNT];    // 各时间常数的指数加权移动平均
+    uint64_t last_ts;                    // 最新样本时间戳(us)
+} ChannelStats;
+
+// 通道滑动窗口最小/最大值
+typedef struct {
+    uint32_t window_ms;   // 窗口长度(ms)
+    bool valid;           // 窗口内是否有样本且极值准确(队列溢出期间为false)
+    ChannelSample min;    // 窗口内最小值样本
+    ChannelSample max;    // 窗口内最大值样本
+} ChannelMinMax;
+
+// 唤醒延迟直方图桶数, 桶上限依次为1/2/5/10/20/50/100ms, 最后一桶为100ms以上
+#define COLLECTOR_JITTER_BUCKETS 8
+
+// 最近采集周期记录数量
+#define COLLECTOR_CYCLE_LOG_SIZE 16
+
+// 单个采集周期的时间记录
+typedef struct {
+    uint32_t due;      // 本周期第一次读取的计划时间(tick), 异步传感器为截止时间
+    uint32_t start;    // 实际开始时间(tick)
+    uint32_t finish;   // 结束时间(tick)
+    uint8_t sensors;   // 本周期采集的传感器掩码
+} CollectorCycleRecord;
+
+// 采集任务时序统计
+typedef struct {
+    uint32_t cycles;                                      // 采集周期数
+    uint32_t skipped;                                     // 因超时跳过的采样周期数
+    uint32_t max_jitter_ms;                               // 最大唤醒延迟(ms)
+    uint32_t max_busy_ms;                                 // 最长单周期耗时(ms)
+    uint32_t jitter_histogram[COLLECTOR_JITTER_BUCKETS];  // 唤醒延迟直方图
+} CollectorTimingStats;
+
+// 历史数据迭代器每批解码的样本数量
+#define COLLECTOR_HISTORY_ITER_BATCH 8
+
+// 历史数据迭代器, 字段由采集器内部使用
+typedef struct {
+    SensorType type;      // 传感器类型
+    uint64_t until_ts;    // 结束时间戳(含)
+    uint32_t next_seq;    // 下一批样本的起始序号
+    uint32_t first_seq;   // 当前批第一个样本的序号
+    uint32_t index;       // 当前批下一个返回的样本
+    uint32_t count;       // 当前批的样本数量
+    SensorData batch[COLLECTOR_HISTORY_ITER_BATCH];  // 当前批已解码的样本
+} CollectorHistoryIter;
+
 // 数据回调函数类型
 typedef void (*DataCallback)(const SensorData* data);
 
+// 数据帧回调函数类型
+typedef void (*FrameCallback)(const SensorFrame* frame);
+
+// 触发捕获完成回调函数类型
+typedef void (*CaptureCallback)(const CaptureView* capture);
+
+// 最多的数据订阅者数量(含CollectorRegisterCallback占用的一个)
+#define COLLECTOR_MAX_SUBSCRIBERS 8
+
+// 传感器类型掩码
+#define COLLECTOR_SENSOR_MASK(type)  (1U << (type))
+#define COLLECTOR_SENSOR_MASK_ALL    ((1U << SENSOR_TYPE_MAX) - 1)
+
+// 订阅过滤条件, 每个样本只对满足条件的订阅者回调
+typedef struct {
+    uint32_t sensor_mask;                  // 关注的传感器类型掩码
+    uint32_t min_interval_ms;              // 同一传感器两次通知的最小间隔(ms), 0表示不限
+    float deadband[SENSOR_CHANNEL_MAX];    // 通道死区, 与上次通知的值相差不足时不通知, 0表示不启用
+} SubscriptionFilter;
+
 // 初始化数据采集模块
 int CollectorInit(const CollectorConfig* config);
 
@@ -88,15 +386,165 @@ CollectorState CollectorGetState(void);
 // 获取采集器错误码
 CollectorError CollectorGetError(void);
 
-// 手动触发数据采集
+// 手动触发数据采集, 由采集任务执行, 调用者等待采集完成; 异步传感器先触发转换, 转换完成后采集
+// 在采集任务内部(如回调中)调用时不等待, 转换尚未完成的传感器稍后采集, 不计入返回值
 int CollectorTrigger(SensorType type);
 
+// 无锁读取最近样本缓存中的数据
+// cursor为读取起点序号(0表示从最旧的样本开始), 返回时更新为下一次读取的起点;
+// 若cursor跳跃超过actual_count, 说明读取间隔内有样本被覆盖
+int CollectorReadCache(SensorType type, uint32_t* cursor, SensorData* data, uint32_t max_count,
+    uint32_t* actual_count);
+
+// 修改单个传感器的采样调度参数, 由采集任务在下一轮循环中应用并重建该传感器的调度项
+int CollectorSetSchedule(SensorType type, const SensorSchedule* schedule);
+
+// 按时间范围查询定点压缩历史, 返回since_ts <= timestamp <= until_ts的样本(从旧到新)
+// 超过max_count时返回范围内最早的max_count个样本, 数值精度为存储的定点单位
+int CollectorGetHistory(SensorType type, uint64_t since_ts, uint64_t until_ts,
+    SensorData* data, uint32_t max_count, uint32_t* actual_count);
+
+// 获取全部定点压缩历史, count输入为data容量, 输出为实际数量, 超出容量时返回最新的样本
+int CollectorGetHistoryData(SensorType type, SensorData* data, uint32_t* count);
+
+// 清除历史数据
+int CollectorClearHistory(SensorType type);
+
+// 创建时间范围内定点压缩历史的迭代器, 与CollectorGetHistory覆盖相同的样本(从旧到新)
+// 每批在锁内复制COLLECTOR_HISTORY_ITER_BATCH个定点样本并解码到迭代器内, 不需要调用者提供整个结果缓冲区
+int CollectorHistoryIterInit(SensorType type, uint64_t since_ts, uint64_t until_ts,
+    CollectorHistoryIter* iter);
+
+// 获取迭代器的下一个样本, 返回指向迭代器内部的指针(下次调用前有效), 无更多样本时返回NULL
+// 遍历期间被覆盖的样本跳过, 从最旧的样本继续
+const SensorData* CollectorHistoryIterNext(CollectorHistoryIter* iter);
+
+// 检查最近一次返回的样本是否仍在历史中, 遍历期间被覆盖或清除时返回false
+bool CollectorHistoryIterValid(const CollectorHistoryIter* iter);
+
+// 获取通道所属的传感器类型
+SensorType CollectorGetChannelSensor(SensorChannel channel);
+
+// 从传感器数据中取出指定通道的数值
+int CollectorGetChannelValue(const SensorData* data, SensorChannel channel, float* value);
+
+// 从定点压缩历史中查询since_ts之后的样本(从旧到新), 超过max_count时返回最新的max_count个
+int CollectorGetCompactHistory(SensorType type, uint64_t since_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count);
+
+// 扫描定点压缩历史, 统计since_ts之后通道的最小/最大/平均值
+int CollectorScanChannel(SensorChannel channel, uint64_t since_ts, ChannelSummary* summary);
+
+// 从长期压缩归档中查询since_ts到until_ts之间的通道样本(从旧到新)
+int CollectorGetArchive(SensorChannel channel, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count, uint32_t* actual_count);
+
+// 获取通道在线统计(均值/方差/EWMA)
+int CollectorGetStats(SensorChannel channel, ChannelStats* stats);
+
+// 重置通道在线统计, 在下一个样本到达时生效
+int CollectorResetStats(SensorChannel channel);
+
+// 设置通道滑动窗口长度, 在下一个样本到达时生效, 队列容量随之调整
+int CollectorSetWindow(SensorChannel channel, uint32_t window_ms);
+
+// 获取通道最近窗口内的最小/最大值, 截止到该通道的最新样本
+int CollectorGetWindowMinMax(SensorChannel channel, ChannelMinMax* minmax);
+
+// 设置通道滤波链, 在下一个样本到达时生效, 滤波状态随之清空
+int CollectorSetFilter(SensorChannel channel, const ChannelFilterConfig* config);
+
+// 获取通道当前的滤波链配置
+int CollectorGetFilter(SensorChannel channel, ChannelFilterConfig* config);
+
+// 设置通道校准系数, 下一次读取传感器时生效, order为0时恢复默认系数
+// 初始化后各通道使用默认系数, 配置管理模块加载或修改配置时调用本接口下发
+int CollectorSetCalibration(SensorChannel channel, const ChannelCalibration* calibration);
+
+// 获取通道当前的校准系数
+int CollectorGetCalibration(SensorChannel channel, ChannelCalibration* calibration);
+
+// 获取采集任务时序统计, 读取无锁且不会读到写入中的快照
+int CollectorGetTimingStats(CollectorTimingStats* stats);
+
+// 获取最近的采集周期记录, 按时间从旧到新排列
+int CollectorGetCycleLog(CollectorCycleRecord* records, uint32_t max_count, uint32_t* actual_count);
+
+// 清除采集任务时序统计, 在下一个采集周期生效
+int CollectorResetTimingStats(void);
+
 // 获取最新的传感器数据
+// 虚拟传感器在输入数据更新后的第一次读取时计算并缓存, 输入尚无数据时返回-1
 int CollectorGetLatestData(SensorType type, SensorData* data);
 
-// 注册数据回调函数
+// 获取最新传感器数据的一致快照及其序号
+// 序号随每次更新单调递增, 0表示尚无数据; 与上次读取的序号相同说明数据未变化
+// 虚拟传感器的序号为各输入序号之和
+int CollectorGetLatestSnapshot(SensorType type, SensorData* data, uint32_t* seq);
+
+// 获取最新传感器数据的序号, 不复制数据
+uint32_t CollectorGetLatestSeq(SensorType type);
+
+// 获取最新的多传感器数据帧, 尚未组装过数据帧时返回-1
+// 与上次读取的帧序号相同说明没有新的采集周期
+int CollectorGetLatestFrame(SensorFrame* frame);
+
+// 注册数据帧回调函数, 写入新样本的采集周期在采集任务中回调一次, 回调应尽快返回
+// 再次注册时替换之前的回调, NULL表示取消
+int CollectorRegisterFrameCallback(FrameCallback callback);
+
+// 注册数据回调函数(兼容接口, 接收所有传感器的每个样本, 再次注册时替换之前的回调)
 int CollectorRegisterCallback(DataCallback callback);
 
+// 添加数据订阅, 返回订阅编号, 失败返回-1
+// 带死区的传感器只有在某个启用死区的通道变化超过死区时才通知
+int CollectorSubscribe(DataCallback callback, const SubscriptionFilter* filter);
+
+// 取消数据订阅
+int CollectorUnsubscribe(int id);
+
+// 获取传感器当前的采样周期(ms), 启用自适应采样时随信号变化调整
+int CollectorGetSamplePeriod(SensorType type, uint32_t* period_ms);
+
+// 获取传感器健康信息, 单个传感器故障只影响自身的采样
+int CollectorGetSensorHealth(SensorType type, SensorHealth* health);
+
+// 获取异步投递统计
+int CollectorGetDeliveryStats(DeliveryStats* stats);
+
+// 清零异步投递统计
+int CollectorResetDeliveryStats(void);
+
+// 按需读取传感器, 不写入缓存: 有效期内的最近一次结果直接返回, 否则由采集任务代为读取,
+// 多个任务同时请求同一传感器时合并为一次总线读取; 在采集任务内部调用时不等待异步转换, 转换未完成时返回-1
+int CollectorReadSensor(SensorType type, SensorData* data);
+
+// 获取传感器读取统计
+int CollectorGetReadStats(SensorType type, SensorReadStats* stats);
+
+// 触发捕获, 可在任意任务中调用; 上一次捕获尚未释放或未启用捕获时返回-1
+int CollectorTriggerCapture(void);
+
+// 获取已完成的触发捕获, 不复制样本, 使用完毕后调用CollectorReleaseCapture
+int CollectorGetCapture(CaptureView* view);
+
+// 释放已完成的触发捕获, 重新等待触发
+int CollectorReleaseCapture(void);
+
+// 注册触发捕获完成回调函数, 在采集任务中回调, 可直接持久化或发布捕获的样本
+int CollectorRegisterCaptureCallback(CaptureCallback callback);
+
+// 把已完成的触发捕获交给持久化日志写入任务, 带FLASH_LOG_FLAG_CAPTURE标志按顺序写入后自动释放
+// 未配置持久化日志、没有已完成的捕获或上一次捕获尚未写完时返回-1, 捕获保持不变
+int CollectorLogCapture(void);
+
+// 从持久化日志读取记录(从旧到新), 未配置持久化日志时返回-1
+int CollectorReadLog(FlashLogCursor* cursor, FlashLogEntry* entries, uint32_t max_count,
+    uint32_t* actual_count);
+
+// 把持久化日志页缓冲中的记录写入闪存
+int CollectorFlushLog(void);
+
 // 反初始化数据采集模块
 int CollectorDeinit(void);
 
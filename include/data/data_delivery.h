@@ -0,0 +1,31 @@
+#ifndef DATA_DELIVERY_H
+#define DATA_DELIVERY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 初始化回调投递, 异步模式下创建消息队列和投递任务, deliver在投递任务中执行
+int DeliveryInit(const DeliveryConfig* config, DataCallback deliver);
+
+// 投递一个样本, 同步模式下直接调用deliver, 异步模式下只入队不阻塞
+void DeliveryPost(const SensorData* data);
+
+// 获取投递统计
+void DeliveryGetStats(DeliveryStats* stats);
+
+// 清零投递统计
+void DeliveryResetStats(void);
+
+// 退出投递任务并释放队列, 未投递的样本被丢弃
+void DeliveryDeinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DATA_DELIVERY_H
@@ -0,0 +1,31 @@
+#ifndef FLASH_BACKEND_H
+#define FLASH_BACKEND_H
+
+#include <stdint.h>
+#include "data/flash_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Hi3861片上闪存的扇区及编程页大小
+#define FLASH_BACKEND_HI_SECTOR_SIZE 4096
+#define FLASH_BACKEND_HI_PAGE_SIZE   256
+
+// 片上闪存后端, 使用SDK分区表中的用户预留分区(HI_FLASH_PARTITON_USR_RESERVE),
+// 分区未配置、未按扇区对齐或不足2个扇区时失败
+int FlashBackendHiInit(FlashBackend* backend);
+
+// 主机文件后端, 用mmap把文件映射为闪存, 用于在Linux上测量吞吐量和恢复时间
+// 文件不存在时创建并按擦除状态(全0xFF)初始化, 写入按位与以模拟NOR闪存
+int FlashBackendPosixOpen(FlashBackend* backend, const char* path, uint32_t sector_size,
+    uint32_t sector_count, uint32_t page_size);
+
+// 关闭主机文件后端
+void FlashBackendPosixClose(FlashBackend* backend);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLASH_BACKEND_H
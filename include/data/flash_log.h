@@ -0,0 +1,91 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 扇区头大小(字节), 位于每个扇区起始处
+#define FLASH_LOG_HEADER_SIZE 16
+
+// 记录大小(字节), 记录在扇区内按固定槽位排列
+#define FLASH_LOG_RECORD_SIZE 24
+
+// 闪存后端接口, 语义与NOR闪存一致: 擦除后全为0xFF, 写入只能把1改为0
+// 地址为日志分区内的偏移, sector_size需为page_size的整数倍
+typedef struct {
+    uint32_t sector_size;   // 擦除扇区大小(字节)
+    uint32_t sector_count;  // 扇区数量(至少2个)
+    uint32_t page_size;     // 编程页大小(字节)
+    int (*read)(void* ctx, uint32_t addr, void* buf, uint32_t len);
+    int (*write)(void* ctx, uint32_t addr, const void* buf, uint32_t len);
+    int (*erase)(void* ctx, uint32_t addr);  // 擦除addr所在扇区
+    void* ctx;
+} FlashBackend;
+
+// 扇区头缓存
+typedef struct {
+    bool valid;            // 扇区头有效
+    bool foreign;          // 扇区头无效且内容不属于日志, 可能是其他数据, 不擦除也不写入
+    uint16_t boot;         // 扇区启用时的启动序号
+    uint32_t seq;          // 扇区启用顺序号, 单调递增
+    uint32_t erase_count;  // 擦除次数(扇区头无效时为估计值)
+} FlashSectorInfo;
+
+// 持久化日志
+struct FlashLog {
+    const FlashBackend* backend;
+    FlashSectorInfo* sectors;  // 各扇区头缓存
+    uint32_t slots;            // 每扇区记录槽数量
+    bool has_active;           // 是否已有写入扇区
+    uint32_t active;           // 当前写入扇区
+    uint32_t write_slot;       // 当前扇区下一个空闲槽位
+    uint32_t next_seq;         // 下一个启用扇区的顺序号
+    bool prepared;             // 下一个扇区已提前擦除
+    uint16_t boot;             // 本次启动序号, 每次打开日志加1
+    uint8_t* page;             // 当前页缓冲
+    uint32_t page_addr;        // 当前页地址
+    uint32_t page_fill;        // 当前页已填充字节数
+    uint32_t page_written;     // 当前页已写入闪存的字节数
+    FlashLogStats stats;
+};
+
+// 打开日志: 只扫描各扇区头恢复写入位置, 并在当前扇区内二分查找第一个空闲槽位
+// 扇区头无效的扇区只有已擦除、第一个槽位是有效记录或是掉电时正在启用的下一个扇区时才会被重用,
+// 其他扇区视为不属于日志的数据, 轮换时跳过, 不会被擦除
+int FlashLogOpen(FlashLog* log, const FlashBackend* backend);
+
+// 追加一条记录, 记录先进入页缓冲, 凑满一页后一次写入闪存;
+// 当前扇区写满时擦除下一个扇区(按环形顺序轮换, 覆盖最旧的数据), 已提前擦除时直接启用
+int FlashLogAppend(FlashLog* log, const SensorData* data);
+
+// 追加一条带标志(FLASH_LOG_FLAG_*)的记录, 其余同FlashLogAppend
+int FlashLogAppendFlags(FlashLog* log, const SensorData* data, uint16_t flags);
+
+// 当前扇区剩余槽位不足1/4时提前擦除下一个扇区, 供写入者空闲时调用, 使追加不再等待擦除;
+// 下一个扇区中最旧的数据随之提前丢弃
+int FlashLogPrepare(FlashLog* log);
+
+// 把页缓冲中尚未写入的记录写入闪存
+int FlashLogFlush(FlashLog* log);
+
+// 从游标位置起按写入顺序读取记录(包括页缓冲中尚未写入的记录), 并推进游标
+// 游标初始化为全0表示从最旧的记录开始, 游标指向的数据已被覆盖时从最旧的记录继续
+int FlashLogRead(FlashLog* log, FlashLogCursor* cursor, FlashLogEntry* entries,
+    uint32_t max_count, uint32_t* actual_count);
+
+// 获取统计信息
+int FlashLogGetStats(const FlashLog* log, FlashLogStats* stats);
+
+// 写入页缓冲并释放资源
+int FlashLogClose(FlashLog* log);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLASH_LOG_H
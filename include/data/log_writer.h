@@ -0,0 +1,39 @@
+#ifndef LOG_WRITER_H
+#define LOG_WRITER_H
+
+#include <stdint.h>
+#include "data/data_collector.h"
+#include "data/flash_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 初始化日志写入, 创建消息队列和低优先级写入任务, log需已打开
+// 闪存写入和擦除都在写入任务中进行, 写入任务空闲时提前擦除下一个扇区
+int LogWriterInit(FlashLog* log, uint32_t queue_size);
+
+// 提交一个样本, 只入队不阻塞, 队列满时丢弃该样本
+void LogWriterPost(const SensorData* data);
+
+// 捕获写入完成回调函数类型, 在写入任务中调用
+typedef void (*LogWriterDone)(void);
+
+// 提交触发捕获, 只入队不阻塞; 写入任务按顺序写入各段样本(带FLASH_LOG_FLAG_CAPTURE标志)后调用done
+// 捕获的样本在done之前须保持不变, 上一次提交的捕获尚未写完或队列满时返回-1
+int LogWriterPostCapture(const CaptureView* capture, LogWriterDone done);
+
+// 从游标位置起读取日志记录, 与写入任务互斥
+int LogWriterRead(FlashLogCursor* cursor, FlashLogEntry* entries, uint32_t max_count, uint32_t* actual_count);
+
+// 把页缓冲中的记录写入闪存
+int LogWriterFlush(void);
+
+// 写入队列中剩余的样本后退出写入任务, 并把页缓冲写入闪存, 日志由调用者关闭
+void LogWriterDeinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LOG_WRITER_H
@@ -0,0 +1,42 @@
+#ifndef SAMPLE_FILTER_H
+#define SAMPLE_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单级滤波状态, 所有缓冲区预先分配
+typedef struct {
+    bool primed;                              // 是否已有输出
+    uint8_t count;                            // 中值窗口内的样本数量
+    uint8_t index;                            // 中值窗口下一个写入位置
+    float history[COLLECTOR_MEDIAN_MAX];      // 中值窗口
+    float output;                             // 上一次输出
+    int32_t acc;                              // 定点低通累加器(通道定点值 << 8)
+} FilterStageState;
+
+// 通道滤波链
+typedef struct {
+    SensorChannel channel;                              // 数据通道, 决定定点低通使用的定点单位
+    ChannelFilterConfig config;                         // 滤波链配置
+    FilterStageState state[COLLECTOR_FILTER_STAGES];    // 各级状态
+} SampleFilter;
+
+// 初始化滤波链, 参数非法时返回-1且不修改滤波链
+int SampleFilterInit(SampleFilter* filter, SensorChannel channel, const ChannelFilterConfig* config);
+
+// 清空滤波状态, 保留配置
+void SampleFilterReset(SampleFilter* filter);
+
+// 输入一个样本并返回滤波结果, dt_ms为与前一样本的间隔
+float SampleFilterApply(SampleFilter* filter, float value, uint32_t dt_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_FILTER_H
@@ -0,0 +1,75 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单生产者/多读者无锁环形缓存
+// 生产者写槽位前先公布writing, 写完后以release语义发布head; 读者复制后重新读取writing,
+// 丢弃复制期间可能被覆盖的样本, 因此读者无需加锁也不会阻塞生产者
+typedef struct {
+    SensorData* slots;    // 样本存储
+    uint32_t size;        // 容量
+    uint32_t head;        // 已发布的样本总数(下一个写入序号), 原子访问
+    uint32_t writing;     // 正在写入或已写完的样本总数, 原子访问
+    uint32_t base;        // 清除点, 序号小于base的样本不再可见, 原子访问
+} SampleRing;
+
+// 环形缓存迭代器, 按序号从旧到新遍历
+typedef struct {
+    const SampleRing* ring;  // 所属缓存
+    uint32_t seq;            // 下一个读取序号
+    uint32_t end;            // 迭代结束序号(不含)
+} SampleRingIter;
+
+// 初始化环形缓存, storage由调用者分配
+int SampleRingInit(SampleRing* ring, SensorData* storage, uint32_t size);
+
+// 写入一个样本, 只能由唯一的生产者调用
+void SampleRingPush(SampleRing* ring, const SensorData* data);
+
+// 获取已发布的样本总数
+uint32_t SampleRingHead(const SampleRing* ring);
+
+// 获取当前仍可读取的最旧序号
+uint32_t SampleRingOldest(const SampleRing* ring);
+
+// 清除缓存(对读者而言), 可在任意任务中调用
+void SampleRingClear(SampleRing* ring);
+
+// 从seq开始复制最多max_count个样本, first_seq返回第一个样本的实际序号
+// seq早于最旧样本时从最旧样本开始
+int SampleRingRead(const SampleRing* ring, uint32_t seq, SensorData* out, uint32_t max_count,
+    uint32_t* actual_count, uint32_t* first_seq);
+
+// 二分查找第一个时间戳不早于(upper为true时为晚于)timestamp的样本序号
+// 缓存中的时间戳单调递增, 无匹配样本时返回head
+uint32_t SampleRingFindTime(const SampleRing* ring, uint64_t timestamp, bool upper);
+
+// 检查序号为seq的样本是否仍未被覆盖
+bool SampleRingIsValid(const SampleRing* ring, uint32_t seq);
+
+// 创建覆盖当前全部可读样本的迭代器
+void SampleRingIterInit(const SampleRing* ring, SampleRingIter* iter);
+
+// 创建覆盖序号[begin, end)的迭代器
+void SampleRingIterInitRange(const SampleRing* ring, SampleRingIter* iter, uint32_t begin, uint32_t end);
+
+// 返回迭代器下一个样本在缓存中的地址(零拷贝), seq返回其序号, 无更多样本时返回NULL
+// 使用完数据后须调用SampleRingIsValid确认该样本在读取期间未被覆盖
+const SensorData* SampleRingIterNextRef(SampleRingIter* iter, uint32_t* seq);
+
+// 复制迭代器的下一个样本, 无更多样本时返回false
+// 迭代过程中被生产者覆盖的样本会被跳过
+bool SampleRingIterNext(SampleRingIter* iter, SensorData* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_RING_H
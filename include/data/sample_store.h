@@ -0,0 +1,112 @@
+#ifndef SAMPLE_STORE_H
+#define SAMPLE_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单个传感器最多的数据通道数
+#define SAMPLE_STORE_MAX_CHANNELS 2
+
+// 最多记录的长间隔数量, 超出时丢弃最早一段样本
+#define SAMPLE_STORE_MAX_GAPS 4
+
+// 时间戳锚点间隔: 每隔这么多个位置保存一个绝对时间戳, 按时间查找时最多累加这么多个差值
+#define SAMPLE_STORE_ANCHOR_INTERVAL 32
+
+// 样本块大小: 读者在锁内每次只复制一块定点样本, 解码在锁外进行
+#define SAMPLE_STORE_CHUNK_SIZE 16
+
+// 长间隔记录: 16位时间差无法表示的间隔单独保存
+typedef struct {
+    uint32_t index;   // 间隔之后第一个样本的位置
+    uint32_t gap_ms;  // 与前一样本的时间差(ms)
+} SampleStoreGap;
+
+// 定点列式样本存储(每个传感器一个)
+// 各通道数值以int16定点保存, 时间戳以相邻样本的16位毫秒差值保存, 每个样本只占
+// 2字节时间列加每通道2字节数值列, 按通道扫描时访问的是连续内存.
+// 另外每SAMPLE_STORE_ANCHOR_INTERVAL个位置保存一个绝对时间戳锚点, 按时间查找时先二分查找锚点.
+// 定点单位: 温度0.01℃, 湿度0.1%RH, 烟雾0.1ppm, 光照1lux(偏移-32768)
+typedef struct {
+    SensorType type;                                 // 传感器类型
+    uint8_t channel_count;                           // 通道数量
+    SensorChannel channels[SAMPLE_STORE_MAX_CHANNELS];  // 通道列表
+    int16_t* values[SAMPLE_STORE_MAX_CHANNELS];      // 各通道数值列
+    uint16_t* deltas;                                // 与前一样本的时间差列(ms)
+    uint64_t* anchors;                               // 位置为锚点间隔整数倍的样本的时间戳(us)
+    uint32_t capacity;                               // 容量
+    uint32_t count;                                  // 样本数量
+    uint32_t head;                                   // 下一个写入位置
+    uint32_t total;                                  // 累计追加的样本数, 即下一个样本的序号
+    uint64_t first_ts;                               // 最旧样本的时间戳(us)
+    uint64_t last_ts;                                // 最新样本的时间戳(us)
+    SampleStoreGap gaps[SAMPLE_STORE_MAX_GAPS];      // 长间隔记录(从旧到新)
+    uint8_t gap_count;                               // 长间隔记录数量
+} SampleStore;
+
+// 复制出的定点样本块
+typedef struct {
+    uint32_t count;                                                      // 块内样本数量
+    uint32_t next;                                                       // 下一块的起始序号
+    uint64_t timestamps[SAMPLE_STORE_CHUNK_SIZE];                        // 时间戳(us)
+    int16_t values[SAMPLE_STORE_MAX_CHANNELS][SAMPLE_STORE_CHUNK_SIZE];  // 各通道定点值
+} SampleStoreChunk;
+
+// 浮点值编码为通道定点值(超出范围时饱和)
+int16_t SampleStoreEncode(SensorChannel channel, float value);
+
+// 通道定点值解码为浮点值
+float SampleStoreDecode(SensorChannel channel, int16_t value);
+
+// 每个样本占用的字节数(时间列加各通道数值列)
+uint32_t SampleStoreSampleBytes(SensorType type);
+
+// 初始化样本存储并分配列内存
+int SampleStoreInit(SampleStore* store, SensorType type, uint32_t capacity);
+
+// 释放样本存储
+void SampleStoreDeinit(SampleStore* store);
+
+// 追加一个样本, 已满时覆盖最旧样本
+// 与上一样本的间隔超过16位时差可表示的范围(约65秒)时(如停止后重新启动), 间隔记入长间隔表,
+// 长间隔超过SAMPLE_STORE_MAX_GAPS个时丢弃最早一段样本; 时间倒退时之前的样本被丢弃;
+// 差分以毫秒保存, 读出的时间戳相对写入时有不足1ms的误差
+int SampleStoreAppend(SampleStore* store, const SensorData* data);
+
+// 清空样本存储
+void SampleStoreClear(SampleStore* store);
+
+// 读取since_ts之后的样本(从旧到新), 超过max_count时返回最新的max_count个
+// 按时间查找起点时二分查找锚点, 不随存储容量线性增长
+int SampleStoreRead(const SampleStore* store, uint64_t since_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count);
+
+// 读取since_ts到until_ts之间的样本(从旧到新), 超过max_count时返回最早的max_count个
+int SampleStoreReadRange(const SampleStore* store, uint64_t since_ts, uint64_t until_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count);
+
+// 查找第一个不早于since_ts的样本的序号, 超过max_count个时返回最新的max_count个的起点
+// 没有这样的样本时返回下一个样本的序号
+uint32_t SampleStoreSeek(const SampleStore* store, uint64_t since_ts, uint32_t max_count);
+
+// 从序号sequence起复制不晚于until_ts的至多SAMPLE_STORE_CHUNK_SIZE个样本, 不解码
+// 序号对应的样本已被覆盖时从最旧的样本开始; 块内样本不足SAMPLE_STORE_CHUNK_SIZE个时已读到末尾
+int SampleStoreCopy(const SampleStore* store, uint32_t sequence, uint64_t until_ts, SampleStoreChunk* chunk);
+
+// 把块中第i个样本解码为传感器数据, 只访问存储中初始化后不再变化的字段
+void SampleStoreDecodeChunk(const SampleStore* store, const SampleStoreChunk* chunk, uint32_t i, SensorData* data);
+
+// 扫描since_ts之后指定通道的定点值, 返回最小值/最大值/累加和/数量
+int SampleStoreScan(const SampleStore* store, SensorChannel channel, uint64_t since_ts,
+    int16_t* min, int16_t* max, int32_t* sum, uint32_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_STORE_H
@@ -0,0 +1,21 @@
+#ifndef SENSOR_CHANNEL_H
+#define SENSOR_CHANNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 数据通道定义, 一个传感器可以产生多个通道
+typedef enum {
+    SENSOR_CHANNEL_TEMPERATURE = 0,  // 温度(DHT11)
+    SENSOR_CHANNEL_HUMIDITY,         // 湿度(DHT11)
+    SENSOR_CHANNEL_SMOKE,            // 烟雾浓度(MQ2)
+    SENSOR_CHANNEL_LIGHT,            // 光照强度(BH1750)
+    SENSOR_CHANNEL_MAX
+} SensorChannel;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_CHANNEL_H
@@ -0,0 +1,25 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 初始化传感器健康信息
+void SensorHealthInit(SensorHealth* health);
+
+// 记录一次读取结果, 返回距下次读取的延迟(ms), 0表示按正常周期读取
+// 失败时先在周期内按加倍延迟快速重试, 重试次数用完后等下一周期;
+// 连续失败达到阈值后进入降级状态, 读取间隔从两个周期起逐次加倍直至上限
+uint32_t SensorHealthReport(SensorHealth* health, const HealthPolicy* policy, bool success,
+    uint32_t period_ms, uint64_t timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_HEALTH_H
@@ -0,0 +1,39 @@
+#ifndef SENSOR_READ_H
+#define SENSOR_READ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 异步转换已触发但尚未完成, 稍后再次读取
+#define SENSOR_READ_BUSY 1
+
+// 传感器物理读取函数, 成功时填写数据及时间戳, 异步转换未完成时返回SENSOR_READ_BUSY
+typedef int (*SensorReadFunc)(SensorType type, SensorData* data);
+
+// 初始化按需读取
+int SensorReadInit(SensorReadFunc read);
+
+// 读取传感器: 上一次成功结果的时间不超过max_age_ms时直接返回, 否则执行一次物理读取,
+// 返回读取函数的结果
+// 只由采集任务调用, 其他任务的按需读取交给采集任务执行, 不会等待低优先级任务的读取
+int SensorReadShared(SensorType type, uint32_t max_age_ms, SensorData* data);
+
+// 记录一次合并到尚未执行的读取的请求, 可在任意任务中调用
+void SensorReadCountJoined(SensorType type);
+
+// 获取读取统计, 可在任意任务中调用, 各计数器分别原子读取
+void SensorReadGetStats(SensorType type, SensorReadStats* stats);
+
+// 释放按需读取资源
+void SensorReadDeinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_READ_H
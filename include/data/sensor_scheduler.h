@@ -0,0 +1,50 @@
+#ifndef SENSOR_SCHEDULER_H
+#define SENSOR_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 调度器最大调度项数量
+#define SCHEDULER_MAX_ENTRIES 8
+
+// 调度项
+typedef struct {
+    uint32_t due;        // 下次到期时间(tick)
+    uint32_t period;     // 采样周期(tick)
+    uint8_t priority;    // 优先级(同时到期时数值大者先执行)
+    uint8_t id;          // 调度项标识(传感器类型)
+} SchedulerEntry;
+
+// 截止时间调度器, 按到期时间组织的最小堆
+typedef struct {
+    SchedulerEntry heap[SCHEDULER_MAX_ENTRIES];  // 堆数组
+    uint32_t count;                              // 调度项数量
+} SensorScheduler;
+
+// 初始化调度器
+void SchedulerInit(SensorScheduler* sched);
+
+// 添加调度项, first_due为首次到期时间
+int SchedulerAdd(SensorScheduler* sched, uint8_t id, uint32_t period, uint32_t first_due, uint8_t priority);
+
+// 移除调度项
+int SchedulerRemove(SensorScheduler* sched, uint8_t id);
+
+// 查看最早到期的调度项(不出堆)
+int SchedulerPeek(const SensorScheduler* sched, SchedulerEntry* entry);
+
+// 取出一个已到期的调度项, 无到期项时返回-1
+int SchedulerPopDue(SensorScheduler* sched, uint32_t now, SchedulerEntry* entry);
+
+// 将已执行的调度项按周期重新入堆, 错过的周期会被跳过并计入skipped
+int SchedulerReschedule(SensorScheduler* sched, const SchedulerEntry* entry, uint32_t now, uint32_t* skipped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_SCHEDULER_H
@@ -0,0 +1,49 @@
+#ifndef SUBSCRIPTION_H
+#define SUBSCRIPTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 订阅者
+typedef struct {
+    bool used;                               // 是否已占用
+    DataCallback callback;                   // 回调函数
+    SubscriptionFilter filter;               // 过滤条件
+    uint64_t min_interval;                   // 最小通知间隔(与时间戳同单位)
+    uint32_t reported;                       // 已通知过的传感器类型掩码
+    uint64_t last_ts[SENSOR_TYPE_MAX];       // 各传感器上次通知的时间戳
+    float last_value[SENSOR_CHANNEL_MAX];    // 各通道上次通知的数值
+} Subscriber;
+
+// 订阅表, 固定容量
+typedef struct {
+    Subscriber entries[COLLECTOR_MAX_SUBSCRIBERS];  // 订阅者
+    uint32_t count;                                  // 订阅者数量
+} SubscriptionTable;
+
+// 清空订阅表
+void SubscriptionInit(SubscriptionTable* table);
+
+// 添加订阅, min_interval为已换算成时间戳单位的最小通知间隔, 返回订阅编号, 表满时返回-1
+int SubscriptionAdd(SubscriptionTable* table, DataCallback callback, const SubscriptionFilter* filter,
+    uint64_t min_interval);
+
+// 删除订阅
+int SubscriptionRemove(SubscriptionTable* table, int id);
+
+// 按过滤条件判断订阅者是否需要该样本, 需要时记录本次通知的时间和数值
+bool SubscriptionAccept(Subscriber* subscriber, const SensorData* data);
+
+// 对所有需要该样本的订阅者回调, 返回回调次数
+uint32_t SubscriptionDispatch(SubscriptionTable* table, const SensorData* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SUBSCRIPTION_H
@@ -0,0 +1,60 @@
+#ifndef TRIGGER_CAPTURE_H
+#define TRIGGER_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 触发捕获状态
+typedef enum {
+    CAPTURE_STATE_ARMED = 0,   // 等待触发, 环形缓冲区持续覆盖最旧样本
+    CAPTURE_STATE_TRIGGERED,   // 已触发, 追加触发后的样本, 不再覆盖
+    CAPTURE_STATE_COMPLETE     // 捕获完成并冻结, 释放前丢弃新样本
+} CaptureState;
+
+// 触发捕获缓冲区(单写者)
+// 平时作为触发前环形缓冲区; 触发时丢弃早于触发前窗口的样本, 之后追加到触发后窗口结束
+// 或缓冲区写满为止. 完成后样本原地冻结, 读者通过CaptureView直接访问, 无需复制
+typedef struct {
+    SensorData* slots;     // 样本存储
+    uint32_t capacity;     // 容量
+    uint32_t head;         // 下一个写入位置
+    uint32_t count;        // 保留的样本数
+    uint32_t pre_count;    // 触发前的样本数
+    uint64_t pre_us;       // 触发前窗口(us)
+    uint64_t post_us;      // 触发后窗口(us)
+    uint64_t trigger_ts;   // 触发时间戳(us)
+    CaptureState state;    // 状态
+    bool truncated;        // 容量不足, 本次捕获丢失了窗口内的样本
+} TriggerCapture;
+
+// 初始化触发捕获缓冲区
+int TriggerCaptureInit(TriggerCapture* capture, uint32_t capacity, uint32_t pre_ms, uint32_t post_ms);
+
+// 写入一个原始样本, 本次写入使捕获完成时返回true
+bool TriggerCapturePush(TriggerCapture* capture, const SensorData* data);
+
+// 触发捕获, 只在等待触发状态下有效
+int TriggerCaptureFire(TriggerCapture* capture, uint64_t trigger_ts);
+
+// 检查触发后窗口是否已结束, 本次检查使捕获完成时返回true
+bool TriggerCaptureUpdate(TriggerCapture* capture, uint64_t now);
+
+// 获取已完成捕获的样本视图, 指向缓冲区内部, 重新进入等待触发状态前保持不变
+int TriggerCaptureGet(const TriggerCapture* capture, CaptureView* view);
+
+// 释放已完成的捕获, 重新等待触发, 保留的样本继续作为触发前样本
+void TriggerCaptureRearm(TriggerCapture* capture);
+
+// 释放触发捕获缓冲区
+void TriggerCaptureDeinit(TriggerCapture* capture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRIGGER_CAPTURE_H
@@ -0,0 +1,100 @@
+#ifndef TS_BLOCK_H
+#define TS_BLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 压缩块大小(字节), 含块头
+#define TS_BLOCK_SIZE        256
+#define TS_BLOCK_HEADER_SIZE 20
+#define TS_BLOCK_DATA_SIZE   (TS_BLOCK_SIZE - TS_BLOCK_HEADER_SIZE)
+
+// 压缩时间序列块
+// 时间戳按差值的差值(delta-of-delta)编码, 数值按通道定点值的差值编码,
+// 两者均为变长前缀码, 采样间隔稳定且数值变化缓慢时每个样本只需2比特左右
+// 块内时间戳的单位由使用者决定, 归档按毫秒写入
+typedef struct {
+    uint64_t start_ts;                  // 第一个样本的时间戳
+    uint64_t end_ts;                    // 最后一个样本的时间戳
+    uint16_t count;                     // 样本数量
+    uint16_t bit_len;                   // 已使用的比特数
+    uint8_t data[TS_BLOCK_DATA_SIZE];   // 比特流
+} TsBlock;
+
+// 块写入器, 保存流式追加所需的前一样本状态
+typedef struct {
+    TsBlock* block;      // 当前块
+    uint64_t prev_ts;    // 前一样本时间戳
+    int32_t prev_delta;  // 前一时间差
+    int16_t prev_value;  // 前一定点值
+} TsBlockWriter;
+
+// 块顺序解码器
+typedef struct {
+    const TsBlock* block;  // 被解码的块
+    uint32_t bit_pos;      // 当前比特位置
+    uint16_t index;        // 已解码的样本数量
+    uint64_t ts;           // 前一样本时间戳
+    int32_t delta;         // 前一时间差
+    int16_t value;         // 前一定点值
+} TsBlockReader;
+
+// 压缩归档, 由固定数量的块组成的环形缓冲, 写满后覆盖最旧的块
+typedef struct {
+    SensorChannel channel;   // 数据通道
+    TsBlock* blocks;         // 块数组
+    uint32_t block_count;    // 块数量
+    uint32_t current;        // 当前写入块的下标
+    uint32_t used;           // 已使用的块数量
+    uint32_t sequence;       // 当前写入块的累计序号, 每切换一个块加1
+    TsBlockWriter writer;    // 当前块写入器
+} TsArchive;
+
+// 初始化块写入器并清空块
+void TsBlockWriterInit(TsBlockWriter* writer, TsBlock* block);
+
+// 追加一个样本, 块已满时返回-1, 时间戳不得早于前一样本
+int TsBlockAppend(TsBlockWriter* writer, uint64_t ts, int16_t value);
+
+// 初始化块解码器
+void TsBlockReaderInit(TsBlockReader* reader, const TsBlock* block);
+
+// 顺序解码下一个样本, 无更多样本时返回false
+bool TsBlockReaderNext(TsBlockReader* reader, uint64_t* ts, int16_t* value);
+
+// 解码块内since_ts <= timestamp <= until_ts的样本(时间戳单位us), 返回样本数量
+// 块内时间戳按毫秒解释, 与归档写入的单位一致
+uint32_t TsBlockQuery(const TsBlock* block, SensorChannel channel, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count);
+
+// 初始化压缩归档并分配块内存
+int TsArchiveInit(TsArchive* archive, SensorChannel channel, uint32_t block_count);
+
+// 释放压缩归档
+void TsArchiveDeinit(TsArchive* archive);
+
+// 追加一个样本(时间戳单位us), 当前块写满时切换到下一个块
+// 归档内时间戳按毫秒保存, 查询结果的时间戳截断到整毫秒
+int TsArchiveAppend(TsArchive* archive, uint64_t ts, float value);
+
+// 查找第一个包含不早于since_ts的样本的块, 返回其累计序号(没有时为当前块之后的序号)
+uint32_t TsArchiveSeek(const TsArchive* archive, uint64_t since_ts);
+
+// 复制累计序号为*sequence的块, 该块已被覆盖时复制最旧的块并更新*sequence, 该块尚未写入时返回-1
+// 供读者在锁内只复制块、在锁外解码
+int TsArchiveCopyBlock(const TsArchive* archive, uint32_t* sequence, TsBlock* block);
+
+// 解码查询since_ts <= timestamp <= until_ts的样本(从旧到新, 时间戳单位us)
+int TsArchiveQuery(const TsArchive* archive, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count, uint32_t* actual_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TS_BLOCK_H
@@ -0,0 +1,35 @@
+#ifndef VIRTUAL_SENSOR_H
+#define VIRTUAL_SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 是否为虚拟传感器
+bool VirtualSensorIsVirtual(SensorType type);
+
+// 虚拟传感器依赖的真实传感器(按SensorType置位), 非虚拟传感器返回0
+uint32_t VirtualSensorInputMask(SensorType type);
+
+// 根据各真实传感器的最新数据计算虚拟传感器的值, 时间戳取输入中最新的时间戳
+// latest按SensorType索引, 只读取输入掩码中的传感器
+int VirtualSensorCompute(SensorType type, const SensorData latest[SENSOR_TYPE_MAX], SensorData* data);
+
+// 露点(℃), Magnus公式
+float VirtualDewPoint(float temperature, float humidity);
+
+// 体感温度(℃), 美国国家气象局的热指数算法
+float VirtualHeatIndex(float temperature, float humidity);
+
+// 绝对湿度(g/m³)
+float VirtualAbsoluteHumidity(float temperature, float humidity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VIRTUAL_SENSOR_H
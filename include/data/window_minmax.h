@@ -0,0 +1,58 @@
+#ifndef WINDOW_MINMAX_H
+#define WINDOW_MINMAX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data/data_collector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单调双端队列(环形缓冲)
+typedef struct {
+    ChannelSample* items;  // 样本数组
+    uint32_t capacity;     // 容量
+    uint32_t head;         // 队首位置
+    uint32_t count;        // 样本数量
+} MonoDeque;
+
+// 滑动窗口最小/最大值
+// 最大值队列中数值单调递减, 最小值队列中数值单调递增, 队首即为窗口内的极值.
+// 每个样本最多入队出队各一次, 更新均摊O(1), 查询O(1).
+// 队列写满时只能丢弃队首(当前极值), 在被丢弃的样本过期之前查询返回false而不是错误的极值,
+// capacity应不小于窗口内的样本数
+typedef struct {
+    uint64_t window;          // 窗口长度(与时间戳同单位)
+    MonoDeque min;            // 最小值候选队列
+    MonoDeque max;            // 最大值候选队列
+    uint64_t last_ts;         // 最新样本的时间戳
+    uint64_t overflow_until;  // 队列溢出丢弃的样本全部过期的时间, 此前极值不准确
+} WindowMinMax;
+
+// 初始化滑动窗口并分配队列内存
+int WindowMinMaxInit(WindowMinMax* win, uint64_t window, uint32_t capacity);
+
+// 释放滑动窗口
+void WindowMinMaxDeinit(WindowMinMax* win);
+
+// 清空窗口内的样本
+void WindowMinMaxReset(WindowMinMax* win);
+
+// 修改窗口长度, 已有样本在下一次更新时按新长度过期
+void WindowMinMaxSetWindow(WindowMinMax* win, uint64_t window);
+
+// 修改队列容量, 保留已有的候选; 容量不足以保留全部候选时按队列溢出处理
+int WindowMinMaxResize(WindowMinMax* win, uint32_t capacity);
+
+// 输入一个样本, 时间戳不得早于前一样本
+void WindowMinMaxPush(WindowMinMax* win, uint64_t timestamp, float value);
+
+// 获取窗口内的最小/最大值样本, 窗口为空或队列溢出导致极值不准确时返回false
+bool WindowMinMaxGet(const WindowMinMax* win, ChannelSample* min, ChannelSample* max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WINDOW_MINMAX_H
@@ -2,6 +2,7 @@
 #define DRIVERS_SENSOR_BH1750_H
 
 #include <stdint.h>
+#include "drivers/sensor/sensor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,15 +22,36 @@ extern "C" {
 #define BH1750_ONE_H_MODE2   0x21  // 单次高分辨率模式2
 #define BH1750_ONE_L_MODE    0x23  // 单次低分辨率模式
 
+// 高分辨率模式的最长转换时间(ms), 典型值120ms
+#define BH1750_CONVERSION_MS 180
+
 // 初始化BH1750传感器
 int BH1750Init(void);
 
 // 获取BH1750传感器数据
 int BH1750GetData(float* light);
 
+// 获取BH1750原始计数(16位), 由采集器按校准系数换算
+int BH1750GetRaw(uint16_t* count);
+
 // 反初始化BH1750传感器
 int BH1750Deinit(void);
 
+// 以单次测量模式初始化BH1750, 测量之间传感器保持断电
+int BH1750InitOneShot(void);
+
+// 触发一次单次高分辨率转换并立即返回, 转换进行中时不重新触发
+int BH1750StartOneShot(void);
+
+// 读取单次转换的原始计数: 成功返回0, 转换未完成返回1, 未触发转换或读取失败返回-1
+int BH1750ReadOneShot(uint16_t* count);
+
+// BH1750操作接口, 可注册到传感器驱动注册表
+extern const sensor_ops_t bh1750_ops;
+
+// BH1750单次测量模式操作接口, 异步读取
+extern const sensor_ops_t bh1750_oneshot_ops;
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,19 +1,31 @@
 #ifndef DRIVERS_SENSOR_DHT11_H
 #define DRIVERS_SENSOR_DHT11_H
 
+#include <stdint.h>
+#include "drivers/sensor/sensor.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// DHT11两次读取之间的最小间隔(ms)
+#define DHT11_MIN_INTERVAL_MS 1000
+
 // 初始化DHT11传感器
 int DHT11Init(void);
 
 // 获取DHT11传感器数据
 int DHT11GetData(float* temperature, float* humidity);
 
+// 获取DHT11原始读数(单位0.1℃/0.1%), 由采集器按校准系数换算
+int DHT11GetRaw(int16_t* temperature, int16_t* humidity);
+
 // 反初始化DHT11传感器
 int DHT11Deinit(void);
 
+// DHT11操作接口, 可注册到传感器驱动注册表
+extern const sensor_ops_t dht11_ops;
+
 #ifdef __cplusplus
 }
 #endif
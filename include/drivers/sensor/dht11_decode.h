@@ -0,0 +1,49 @@
+#ifndef DRIVERS_SENSOR_DHT11_DECODE_H
+#define DRIVERS_SENSOR_DHT11_DECODE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 一帧数据的字节数(湿度整数/小数, 温度整数/小数, 校验和)
+#define DHT11_FRAME_BYTES   5
+
+// 一次完整传输的边沿数: 响应低/高电平2个, 40位各2个, 结束低电平1个
+#define DHT11_EDGE_COUNT    83
+
+// 脉宽判定范围(us), 标称值为响应80/80, 数据位低电平50, 高电平26-28(0)或70(1)
+#define DHT11_RESPONSE_MIN_US   40
+#define DHT11_RESPONSE_MAX_US   120
+#define DHT11_LOW_MIN_US        20
+#define DHT11_LOW_MAX_US        100
+#define DHT11_HIGH_MIN_US       10
+#define DHT11_HIGH_MAX_US       100
+#define DHT11_BIT_THRESHOLD_US  48   // 高电平超过该宽度为1
+
+// 解码结果
+typedef enum {
+    DHT11_DECODE_OK = 0,        // 成功
+    DHT11_DECODE_SHORT,         // 边沿不足, 传输未完成
+    DHT11_DECODE_TIMING,        // 脉宽超出范围或电平不交替
+    DHT11_DECODE_CHECKSUM       // 校验和错误
+} DHT11DecodeResult;
+
+// 数据线边沿, 时间只用于计算差值, 允许32位回绕
+typedef struct {
+    uint32_t time_us;   // 边沿时间(us)
+    uint8_t level;      // 边沿之后的电平
+} DHT11Edge;
+
+// 按脉宽解码一帧数据, edges从主机释放数据线之后开始记录
+DHT11DecodeResult DHT11Decode(const DHT11Edge* edges, uint32_t count, uint8_t frame[DHT11_FRAME_BYTES]);
+
+// 将一帧数据转换为0.1℃/0.1%为单位的整数, 温度小数字节最高位为负温度标志
+void DHT11FrameToRaw(const uint8_t frame[DHT11_FRAME_BYTES], int16_t* temperature, int16_t* humidity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVERS_SENSOR_DHT11_DECODE_H
@@ -2,6 +2,7 @@
 #define DRIVERS_SENSOR_MQ2_H
 
 #include <stdint.h>
+#include "drivers/sensor/sensor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +21,9 @@ int MQ2Init(void);
 // 获取MQ2传感器数据
 int MQ2GetData(float* smoke);
 
+// 获取MQ2原始ADC值(12位), 由采集器按校准系数换算
+int MQ2GetRaw(uint16_t* adc);
+
 // 反初始化MQ2传感器
 int MQ2Deinit(void);
 
@@ -27,6 +31,9 @@ int MQ2Deinit(void);
 int MQ2HeatOn(void);
 int MQ2HeatOff(void);
 
+// MQ2操作接口, 可注册到传感器驱动注册表
+extern const sensor_ops_t mq2_ops;
+
 #ifdef __cplusplus
 }
 #endif
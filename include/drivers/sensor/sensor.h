@@ -8,6 +8,7 @@ typedef enum {
     SENSOR_TYPE_TEMP_HUMID = 0,  // 温湿度传感器
     SENSOR_TYPE_SMOKE,           // 烟雾传感器
     SENSOR_TYPE_LIGHT,           // 光照传感器
+    SENSOR_TYPE_COUNT            // 传感器类型数量
 } sensor_type_t;
 
 // 传感器数据结构
@@ -18,13 +19,48 @@ typedef struct {
     float light;                // 光照值
 } sensor_data_t;
 
+// 原始读数通道, 顺序与采集器的通道一致
+typedef enum {
+    SENSOR_RAW_TEMPERATURE = 0,  // 温度, 单位0.1℃
+    SENSOR_RAW_HUMIDITY,         // 湿度, 单位0.1%
+    SENSOR_RAW_SMOKE,            // 烟雾, ADC值
+    SENSOR_RAW_LIGHT,            // 光照, 传感器计数
+    SENSOR_RAW_MAX
+} sensor_raw_channel_t;
+
+// 传感器原始读数, 由采集器按校准系数换算
+typedef struct {
+    uint32_t mask;                   // 有效通道掩码(按sensor_raw_channel_t置位)
+    int32_t value[SENSOR_RAW_MAX];   // 各通道原始值
+} sensor_raw_t;
+
+// 传感器使用的总线
+typedef enum {
+    SENSOR_BUS_NONE = 0,         // 不占用总线(模拟驱动)
+    SENSOR_BUS_GPIO,             // 单总线GPIO
+    SENSOR_BUS_ADC,              // ADC
+    SENSOR_BUS_I2C               // I2C
+} sensor_bus_t;
+
+// 传感器能力标志
+#define SENSOR_CAP_ASYNC    0x01    // 异步读取, 先由start触发转换, 转换完成后read_raw读取结果; 未置位时read阻塞到得到结果
+
+// 传感器能力
+typedef struct {
+    uint32_t min_interval_ms;    // 两次读取的最小间隔(ms), 0表示不限制
+    sensor_bus_t bus;            // 使用的总线
+    uint8_t flags;               // 能力标志
+    uint32_t conversion_ms;      // 异步读取从触发到结果可用的时间(ms)
+} sensor_caps_t;
+
 // 传感器状态
 typedef enum {
     SENSOR_OK = 0,              // 正常
     SENSOR_ERROR_TIMEOUT,       // 超时错误
     SENSOR_ERROR_CHECKSUM,      // 校验错误
     SENSOR_ERROR_GPIO,          // GPIO错误
-    SENSOR_ERROR_DATA           // 数据错误
+    SENSOR_ERROR_DATA,          // 数据错误
+    SENSOR_ERROR_BUSY           // 异步转换尚未完成
 } sensor_status_t;
 
 // 传感器操作接口
@@ -33,6 +69,9 @@ typedef struct {
     sensor_status_t (*init)(void);          // 初始化函数
     sensor_status_t (*read)(sensor_data_t*);// 读取数据函数
     sensor_status_t (*deinit)(void);        // 反初始化函数
+    sensor_status_t (*read_raw)(sensor_raw_t*); // 读取原始数据函数
+    sensor_caps_t caps;                     // 传感器能力
+    sensor_status_t (*start)(void);         // 触发一次异步转换, 转换进行中时不重新触发
 } sensor_ops_t;
 
 #endif /* SENSOR_H */
@@ -0,0 +1,31 @@
+#ifndef DRIVERS_SENSOR_SENSOR_REGISTRY_H
+#define DRIVERS_SENSOR_SENSOR_REGISTRY_H
+
+#include <stdint.h>
+#include "drivers/sensor/sensor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 注册传感器驱动, 同一类型已注册时替换原驱动
+// 替换只影响之后的读取, 原驱动由调用者负责反初始化
+int SensorRegister(const sensor_ops_t* ops);
+
+// 注销指定类型的传感器驱动
+void SensorUnregister(sensor_type_t type);
+
+// 获取指定类型的传感器驱动, 未注册时返回NULL
+const sensor_ops_t* SensorGetOps(sensor_type_t type);
+
+// 初始化所有已注册的传感器, 返回第一个失败的错误码
+sensor_status_t SensorInitAll(void);
+
+// 反初始化所有已注册的传感器
+void SensorDeinitAll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVERS_SENSOR_SENSOR_REGISTRY_H
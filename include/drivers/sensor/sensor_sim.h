@@ -0,0 +1,33 @@
+#ifndef DRIVERS_SENSOR_SENSOR_SIM_H
+#define DRIVERS_SENSOR_SENSOR_SIM_H
+
+#include <stdint.h>
+#include "drivers/sensor/sensor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 模拟驱动, 不访问硬件, 用于主机测试和无传感器的板子
+// 读数默认为25.0℃、50.0%、烟雾ADC值100、光照计数360
+
+// 注册所有类型的模拟驱动, 替换已注册的驱动
+int SensorSimRegister(void);
+
+// 设置模拟读数, 之后的读取返回该值
+int SensorSimSetRaw(sensor_type_t type, const sensor_raw_t* raw);
+
+// 设置模拟读取结果, 非SENSOR_OK时读取失败
+int SensorSimSetStatus(sensor_type_t type, sensor_status_t status);
+
+// 设置模拟转换时间, 非0时按异步驱动工作, 0恢复同步读取; 在注册前或采集器启动前调用
+int SensorSimSetConversion(sensor_type_t type, uint32_t conversion_ms);
+
+// 获取模拟驱动的累计读取次数
+uint32_t SensorSimGetReads(sensor_type_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVERS_SENSOR_SENSOR_SIM_H
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config/config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,20 +29,13 @@ typedef enum {
     SYSTEM_ERROR_MAX
 } SystemError;
 
-// 系统配置结构体
-typedef struct {
-    uint32_t collect_interval;   // 数据采集间隔(ms)
-    uint32_t check_interval;     // 报警检查间隔(ms)
-    uint32_t record_capacity;    // 报警记录容量
-} SystemConfig;
-
 // 获取系统状态
 SystemState GetSystemState(void);
 
 // 获取系统错误码
 SystemError GetSystemError(void);
 
-// 获取系统运行时间
+// 获取系统运行时间(ms)
 uint32_t GetSystemUptime(void);
 
 // 系统初始化
@@ -6,9 +6,10 @@
 #include "drivers/output/buzzer.h"
 #include "data/data_collector.h"
 #include "cmsis_os2.h"
+#include "common/clock.h"
 
 // 定义报警类型数量
-#define ALARM_TYPE_COUNT 8
+#define ALARM_TYPE_COUNT 9
 
 // 报警规则数组
 static AlarmRule g_alarm_rules[ALARM_TYPE_COUNT] = {0};
@@ -52,6 +53,8 @@ static SensorType GetSensorType(AlarmType type)
         case ALARM_TYPE_LIGHT_HIGH:
         case ALARM_TYPE_LIGHT_LOW:
             return SENSOR_TYPE_BH1750;
+        case ALARM_TYPE_HEAT_INDEX_HIGH:
+            return SENSOR_TYPE_HEAT_INDEX;
         default:
             return SENSOR_TYPE_MAX;
     }
@@ -72,6 +75,8 @@ static float GetSensorValue(AlarmType type, const SensorData* data)
         case ALARM_TYPE_LIGHT_HIGH:
         case ALARM_TYPE_LIGHT_LOW:
             return data->data.bh1750.light;
+        case ALARM_TYPE_HEAT_INDEX_HIGH:
+            return data->data.derived.value;
         default:
             return 0.0f;
     }
@@ -90,6 +95,7 @@ static bool CheckThreshold(AlarmType type, float value, const AlarmRule* rule)
         case ALARM_TYPE_LIGHT_LOW:
             return value <= rule->thresholdLow;
         case ALARM_TYPE_SMOKE:
+        case ALARM_TYPE_HEAT_INDEX_HIGH:
             return value >= rule->thresholdHigh;
         default:
             return false;
@@ -125,6 +131,9 @@ static void GenerateDescription(char* desc, size_t size, AlarmType type, float v
         case ALARM_TYPE_SYSTEM_ERROR:
             type_str = "系统错误";
             break;
+        case ALARM_TYPE_HEAT_INDEX_HIGH:
+            type_str = "体感温度过高";
+            break;
         default:
             type_str = "未知";
             break;
@@ -141,7 +150,7 @@ static void TriggerAlarm(const AlarmRule* rule, float value)
         .type = rule->type,
         .level = rule->level,
         .value = value,
-        .timestamp = time(NULL)
+        .timestamp = ClockNowUs()
     };
     
     // 生成报警描述
@@ -163,9 +172,10 @@ static void TriggerAlarm(const AlarmRule* rule, float value)
         LEDSetBlink(true, 500);  // 警告及以上级别报警LED闪烁
     }
     
-    // 控制蜂鸣器
+    // 控制蜂鸣器, 并保存报警前后的原始样本
     if (rule->level >= ALARM_LEVEL_CRITICAL) {
         BuzzerStart(1000, 500);  // 严重级别报警蜂鸣器报警
+        CollectorTriggerCapture();
     }
     
     // 调用回调函数
@@ -186,9 +196,9 @@ int AlarmCheck(void)
             continue;
         }
         
-        // 获取对应的传感器数据
+        // 获取对应的传感器数据, 虚拟传感器在读取时按需计算
         SensorType sensor_type = GetSensorType(rule->type);
-        if (sensor_type >= SENSOR_TYPE_MAX) {
+        if (sensor_type == SENSOR_TYPE_MAX) {
             continue;
         }
         
@@ -0,0 +1,267 @@
+#include "business/monitor.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "cmsis_os2.h"
+#include "common/clock.h"
+
+// 每个通道的桶总数
+#define MONITOR_CHANNEL_BUCKETS (MONITOR_SECOND_BUCKETS + MONITOR_MINUTE_BUCKETS + MONITOR_HOUR_BUCKETS)
+
+// 各分辨率的桶数量
+static const uint32_t g_bucket_count[MONITOR_RESOLUTION_MAX] = {
+    MONITOR_SECOND_BUCKETS,
+    MONITOR_MINUTE_BUCKETS,
+    MONITOR_HOUR_BUCKETS
+};
+
+// 各分辨率在通道桶数组中的起始位置
+static const uint32_t g_bucket_offset[MONITOR_RESOLUTION_MAX] = {
+    0,
+    MONITOR_SECOND_BUCKETS,
+    MONITOR_SECOND_BUCKETS + MONITOR_MINUTE_BUCKETS
+};
+
+// 各分辨率的桶宽度(us)
+static const uint64_t g_bucket_width[MONITOR_RESOLUTION_MAX] = {
+    CLOCK_US_PER_SEC,
+    60 * CLOCK_US_PER_SEC,
+    3600 * CLOCK_US_PER_SEC
+};
+
+// 全局变量
+static RollupBucket* g_buckets = NULL;
+static osMutexId_t g_monitor_mutex = NULL;
+
+// 获取通道在指定分辨率下的桶数组
+static RollupBucket* GetLevel(SensorChannel channel, MonitorResolution resolution)
+{
+    return &g_buckets[channel * MONITOR_CHANNEL_BUCKETS + g_bucket_offset[resolution]];
+}
+
+// 判断桶是否仍在保留范围内
+static bool IsBucketValid(const RollupBucket* bucket, MonitorResolution resolution, uint64_t now)
+{
+    uint64_t width = g_bucket_width[resolution];
+    uint64_t current = now - now % width;
+
+    return bucket->count > 0 && bucket->start <= current &&
+        current - bucket->start < g_bucket_count[resolution] * width;
+}
+
+// 将桶合并到汇总结果(最新值由调用者按桶时间确定)
+static void MergeBucket(RollupBucket* summary, const RollupBucket* bucket)
+{
+    if (summary->count == 0) {
+        memcpy(summary, bucket, sizeof(RollupBucket));
+        return;
+    }
+
+    if (bucket->min < summary->min) {
+        summary->min = bucket->min;
+    }
+    if (bucket->max > summary->max) {
+        summary->max = bucket->max;
+    }
+    if (bucket->start < summary->start) {
+        summary->start = bucket->start;
+    }
+    summary->sum += bucket->sum;
+    summary->count += bucket->count;
+}
+
+// 更新单个分辨率的当前桶
+static void FeedLevel(SensorChannel channel, MonitorResolution resolution, uint64_t timestamp, float value)
+{
+    uint64_t width = g_bucket_width[resolution];
+    uint64_t start = timestamp - timestamp % width;
+    uint32_t index = (uint32_t)((timestamp / width) % g_bucket_count[resolution]);
+    RollupBucket* bucket = &GetLevel(channel, resolution)[index];
+
+    if (bucket->count > 0 && bucket->start == start) {
+        if (value < bucket->min) {
+            bucket->min = value;
+        }
+        if (value > bucket->max) {
+            bucket->max = value;
+        }
+        bucket->sum += value;
+        bucket->last = value;
+        bucket->count++;
+        return;
+    }
+
+    // 迟到的旧样本不覆盖更新的桶
+    if (bucket->count > 0 && start < bucket->start) {
+        return;
+    }
+
+    // 跨越桶边界, 复用该位置上已过期的桶
+    bucket->start = start;
+    bucket->min = value;
+    bucket->max = value;
+    bucket->sum = value;
+    bucket->last = value;
+    bucket->count = 1;
+}
+
+// 初始化监测汇总模块
+int MonitorInit(void)
+{
+    if (g_buckets != NULL) {
+        return 0;
+    }
+
+    g_buckets = malloc(sizeof(RollupBucket) * MONITOR_CHANNEL_BUCKETS * SENSOR_CHANNEL_MAX);
+    if (g_buckets == NULL) {
+        return -1;
+    }
+    memset(g_buckets, 0, sizeof(RollupBucket) * MONITOR_CHANNEL_BUCKETS * SENSOR_CHANNEL_MAX);
+
+    g_monitor_mutex = osMutexNew(NULL);
+    if (g_monitor_mutex == NULL) {
+        free(g_buckets);
+        g_buckets = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+// 输入一个通道样本
+int MonitorFeed(SensorChannel channel, uint64_t timestamp, float value)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || g_buckets == NULL) {
+        return -1;
+    }
+
+    if (osMutexAcquire(g_monitor_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    for (int i = 0; i < MONITOR_RESOLUTION_MAX; i++) {
+        FeedLevel(channel, (MonitorResolution)i, timestamp, value);
+    }
+    osMutexRelease(g_monitor_mutex);
+
+    return 0;
+}
+
+// 获取指定分辨率下的桶
+int MonitorGetBuckets(SensorChannel channel, MonitorResolution resolution,
+    RollupBucket* buckets, uint32_t max_count, uint32_t* actual_count)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || resolution >= MONITOR_RESOLUTION_MAX ||
+        buckets == NULL || actual_count == NULL || g_buckets == NULL) {
+        return -1;
+    }
+
+    if (osMutexAcquire(g_monitor_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+
+    uint64_t now = ClockNowUs();
+    uint32_t size = g_bucket_count[resolution];
+    uint32_t oldest = (uint32_t)((now / g_bucket_width[resolution] + 1) % size);
+    const RollupBucket* level = GetLevel(channel, resolution);
+
+    // 超过max_count时只返回最新的桶
+    uint32_t valid = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        valid += IsBucketValid(&level[i], resolution, now);
+    }
+    uint32_t skip = valid > max_count ? valid - max_count : 0;
+
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        const RollupBucket* bucket = &level[(oldest + i) % size];
+        if (!IsBucketValid(bucket, resolution, now)) {
+            continue;
+        }
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+        memcpy(&buckets[found++], bucket, sizeof(RollupBucket));
+    }
+    osMutexRelease(g_monitor_mutex);
+
+    *actual_count = found;
+    return 0;
+}
+
+// 汇总最近一段时间的数据
+int MonitorGetWindow(SensorChannel channel, uint32_t window_ms, RollupBucket* summary)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || summary == NULL || g_buckets == NULL) {
+        return -1;
+    }
+
+    uint64_t window = window_ms * CLOCK_US_PER_MS;
+
+    // 选择能覆盖窗口的最细分辨率
+    MonitorResolution resolution = MONITOR_RESOLUTION_HOUR;
+    for (int i = 0; i < MONITOR_RESOLUTION_MAX; i++) {
+        if (window <= g_bucket_count[i] * g_bucket_width[i]) {
+            resolution = (MonitorResolution)i;
+            break;
+        }
+    }
+
+    memset(summary, 0, sizeof(RollupBucket));
+    if (osMutexAcquire(g_monitor_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+
+    uint64_t now = ClockNowUs();
+    uint64_t since = now > window ? now - window : 0;
+    const RollupBucket* level = GetLevel(channel, resolution);
+    const RollupBucket* newest = NULL;
+
+    for (uint32_t i = 0; i < g_bucket_count[resolution]; i++) {
+        const RollupBucket* bucket = &level[i];
+        if (IsBucketValid(bucket, resolution, now) && (bucket->start > since || since == 0)) {
+            MergeBucket(summary, bucket);
+            if (newest == NULL || bucket->start > newest->start) {
+                newest = bucket;
+            }
+        }
+    }
+    if (newest != NULL) {
+        summary->last = newest->last;
+    }
+    osMutexRelease(g_monitor_mutex);
+
+    return 0;
+}
+
+// 清空所有汇总数据
+int MonitorReset(void)
+{
+    if (g_buckets == NULL) {
+        return -1;
+    }
+
+    if (osMutexAcquire(g_monitor_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    memset(g_buckets, 0, sizeof(RollupBucket) * MONITOR_CHANNEL_BUCKETS * SENSOR_CHANNEL_MAX);
+    osMutexRelease(g_monitor_mutex);
+
+    return 0;
+}
+
+// 反初始化监测汇总模块
+int MonitorDeinit(void)
+{
+    if (g_monitor_mutex != NULL) {
+        osMutexDelete(g_monitor_mutex);
+        g_monitor_mutex = NULL;
+    }
+
+    if (g_buckets != NULL) {
+        free(g_buckets);
+        g_buckets = NULL;
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "common/clock.h"
+#include <stddef.h>
+#include "los_tick.h"
+#include "common/seqlock.h"
+
+// 墙上时间与单调时钟的差值, 由校时任务写入, 通过版本锁发布
+static SeqLock g_wall_lock = {0};
+static uint64_t g_wall_offset[2] = {0};
+static volatile bool g_wall_valid = false;
+
+// 获取单调时钟(us)
+uint64_t ClockNowUs(void)
+{
+    return LOS_CurrNanosec() / 1000;
+}
+
+// 获取单调时钟(ms)的低32位
+uint32_t ClockNowMs(void)
+{
+    return (uint32_t)(ClockNowUs() / CLOCK_US_PER_MS);
+}
+
+// 设置当前墙上时间
+int ClockSetWallTime(uint64_t wall_us)
+{
+    uint64_t now = ClockNowUs();
+    if (wall_us < now) {
+        return -1;
+    }
+
+    uint32_t index = SeqLockWriteBegin(&g_wall_lock);
+    g_wall_offset[index] = wall_us - now;
+    SeqLockWriteEnd(&g_wall_lock);
+    g_wall_valid = true;
+
+    return 0;
+}
+
+// 墙上时间是否已设置
+bool ClockHasWallTime(void)
+{
+    return g_wall_valid;
+}
+
+// 将单调时钟时间换算为墙上时间
+int ClockToWallTime(uint64_t mono_us, uint64_t* wall_us)
+{
+    if (wall_us == NULL || !g_wall_valid) {
+        return -1;
+    }
+
+    uint64_t offset = 0;
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&g_wall_lock);
+        offset = g_wall_offset[seq & 1];
+    } while (!SeqLockReadValid(&g_wall_lock, seq));
+
+    *wall_us = mono_us + offset;
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "config/config.h"
+#include "data/calibration.h"
+#include "data/data_collector.h"
 #include "utils/kv_store/kv_store.h"
 
 // 配置存储的键名
@@ -23,7 +25,13 @@ static const SensorConfig g_default_sensor_config = {
     .dht11_enabled = true,      // 默认启用DHT11
     .mq2_enabled = true,        // 默认启用MQ2
     .bh1750_enabled = true,     // 默认启用BH1750
-    .cache_size = 10           // 默认缓存10条数据
+    .cache_size = 10,          // 默认缓存10条数据
+    .calibration = {           // 默认与驱动的换算一致
+        [SENSOR_CHANNEL_TEMPERATURE] = CALIBRATION_DEFAULT_TEMPERATURE,
+        [SENSOR_CHANNEL_HUMIDITY] = CALIBRATION_DEFAULT_HUMIDITY,
+        [SENSOR_CHANNEL_SMOKE] = CALIBRATION_DEFAULT_SMOKE,
+        [SENSOR_CHANNEL_LIGHT] = CALIBRATION_DEFAULT_LIGHT
+    }
 };
 
 // 默认LED配置
@@ -84,6 +92,11 @@ static bool ValidateConfig(const Config* config)
     if (config->sensor.cache_size == 0) {
         return false;
     }
+    for (int i = 0; i < SENSOR_CHANNEL_MAX; i++) {
+        if (!CalibrationIsValid(&config->sensor.calibration[i])) {
+            return false;
+        }
+    }
     
     // 验证LED配置
     if (config->led.brightness > 100) {
@@ -103,6 +116,14 @@ static bool ValidateConfig(const Config* config)
     return true;
 }
 
+// 把传感器配置中的校准系数下发到采集器, 采集器尚未初始化时忽略
+static void ApplyCalibration(void)
+{
+    for (int i = 0; i < SENSOR_CHANNEL_MAX; i++) {
+        CollectorSetCalibration((SensorChannel)i, &g_config.sensor.calibration[i]);
+    }
+}
+
 // 加载默认配置
 static void LoadDefaultConfig(void)
 {
@@ -143,6 +164,9 @@ int ConfigInit(void)
         LoadDefaultConfig();
     }
     
+    // 采集器按配置中的系数换算原始读数
+    ApplyCalibration();
+    
     return 0;
 }
 
@@ -218,7 +242,15 @@ int ConfigSetSensor(const SensorConfig* config)
         return -1;
     }
     
+    for (int i = 0; i < SENSOR_CHANNEL_MAX; i++) {
+        if (!CalibrationIsValid(&config->calibration[i])) {
+            g_error = CONFIG_ERROR_VALIDATE;
+            return -1;
+        }
+    }
+    
     memcpy(&g_config.sensor, config, sizeof(SensorConfig));
+    ApplyCalibration();
     return ConfigSave();
 }
 
@@ -299,6 +331,7 @@ ConfigError ConfigGetError(void)
 int ConfigRestoreDefaults(void)
 {
     LoadDefaultConfig();
+    ApplyCalibration();
     return ConfigSave();
 }
 
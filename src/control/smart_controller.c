@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include "cmsis_os2.h"
 #include "control/smart_controller.h"
+#include "common/clock.h"
 #include "drivers/output/relay.h"
 #include "drivers/output/buzzer.h"
 #include "drivers/output/led.h"
@@ -37,7 +38,7 @@ static void RecordHistory(uint8_t device_id, uint8_t action, uint8_t result)
     }
 
     ControlHistory* history = &g_history[g_history_index];
-    history->timestamp = osKernelGetTickCount();
+    history->timestamp = ClockNowUs();
     history->device_id = device_id;
     history->action = action;
     history->result = result;
@@ -109,8 +110,10 @@ static void CheckTimingRule(const RuleEntry* rule)
     }
 
     const TimingConfig* config = &rule->rule.config.timing;
-    uint32_t current_time = osKernelGetTickCount() / 1000; // 转换为秒
-    uint32_t day_seconds = current_time % (24 * 3600);
+    // 按墙上时间计算一天中的秒数, 未校时前按启动后的时间计算
+    uint64_t now = ClockNowUs();
+    ClockToWallTime(now, &now);
+    uint32_t day_seconds = (uint32_t)((now / CLOCK_US_PER_SEC) % (24 * 3600));
 
     if (day_seconds >= config->start_time && day_seconds < config->end_time) {
         if (config->interval == 0 || (day_seconds - config->start_time) % config->interval == 0) {
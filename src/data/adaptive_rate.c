@@ -0,0 +1,93 @@
+#include "data/adaptive_rate.h"
+#include <string.h>
+
+// 通道活动程度
+typedef enum {
+    ACTIVITY_FLAT = 0,   // 平稳, 放慢采样
+    ACTIVITY_HOLD,       // 有一定变化, 保持当前周期
+    ACTIVITY_FAST        // 快速变化或接近阈值, 切换到最短周期
+} Activity;
+
+// 计算周期上下限
+static void GetPeriodRange(const AdaptiveConfig* config, uint32_t base_period_ms,
+    uint32_t* min_period, uint32_t* max_period)
+{
+    *min_period = config->min_period_ms != 0 ? config->min_period_ms : base_period_ms / 4;
+    *max_period = config->max_period_ms != 0 ? config->max_period_ms : base_period_ms * 4;
+
+    if (*min_period == 0) {
+        *min_period = 1;
+    }
+    if (*max_period < *min_period) {
+        *max_period = *min_period;
+    }
+}
+
+// 判断单个通道的活动程度
+static Activity GetActivity(const AdaptiveChannel* channel, float value, float last, bool valid, uint32_t dt_ms)
+{
+    // 接近报警阈值时需要尽快确认是否越限
+    if (channel->margin > 0.0f &&
+        (value >= channel->high - channel->margin || value <= channel->low + channel->margin)) {
+        return ACTIVITY_FAST;
+    }
+
+    if (channel->rate <= 0.0f || !valid || dt_ms == 0) {
+        return ACTIVITY_FLAT;
+    }
+
+    float diff = value - last;
+    float rate = (diff < 0.0f ? -diff : diff) * 1000.0f / (float)dt_ms;
+    if (rate >= channel->rate) {
+        return ACTIVITY_FAST;
+    }
+    return rate >= channel->rate * 0.5f ? ACTIVITY_HOLD : ACTIVITY_FLAT;
+}
+
+// 初始化自适应采样状态
+void AdaptiveRateInit(AdaptiveRate* rate, uint32_t base_period_ms)
+{
+    memset(rate, 0, sizeof(AdaptiveRate));
+    rate->period_ms = base_period_ms;
+}
+
+// 输入一个样本
+uint32_t AdaptiveRateUpdate(AdaptiveRate* rate, const AdaptiveConfig* config, const SensorData* data,
+    uint32_t dt_ms, uint32_t base_period_ms)
+{
+    uint32_t min_period = 0;
+    uint32_t max_period = 0;
+    Activity activity = ACTIVITY_FLAT;
+
+    GetPeriodRange(config, base_period_ms, &min_period, &max_period);
+
+    // 取该传感器所有通道中最活跃的一个
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        float value = 0.0f;
+        if (CollectorGetChannelValue(data, channel, &value) != 0) {
+            continue;
+        }
+        Activity current = GetActivity(&config->channel[channel], value, rate->last[channel], rate->valid, dt_ms);
+        if (current > activity) {
+            activity = current;
+        }
+        rate->last[channel] = value;
+    }
+    rate->valid = true;
+
+    if (activity == ACTIVITY_FAST) {
+        rate->period_ms = min_period;
+    } else if (activity == ACTIVITY_FLAT) {
+        rate->period_ms += rate->period_ms / 4 != 0 ? rate->period_ms / 4 : 1;
+    }
+
+    // 基础周期或配置变化后重新落入上下限
+    if (rate->period_ms < min_period) {
+        rate->period_ms = min_period;
+    }
+    if (rate->period_ms > max_period) {
+        rate->period_ms = max_period;
+    }
+
+    return rate->period_ms;
+}
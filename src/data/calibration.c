@@ -0,0 +1,70 @@
+#include "data/calibration.h"
+#include <string.h>
+
+// 归一化读数的小数位数
+#define CALIBRATION_INPUT_BITS 16
+
+// 各通道原始读数的满量程位数
+static const uint8_t g_raw_bits[SENSOR_CHANNEL_MAX] = {
+    [SENSOR_CHANNEL_TEMPERATURE] = 10,
+    [SENSOR_CHANNEL_HUMIDITY] = 10,
+    [SENSOR_CHANNEL_SMOKE] = 12,
+    [SENSOR_CHANNEL_LIGHT] = 16
+};
+
+// 各通道默认校准系数
+static const ChannelCalibration g_default_calibration[SENSOR_CHANNEL_MAX] = {
+    [SENSOR_CHANNEL_TEMPERATURE] = CALIBRATION_DEFAULT_TEMPERATURE,
+    [SENSOR_CHANNEL_HUMIDITY] = CALIBRATION_DEFAULT_HUMIDITY,
+    [SENSOR_CHANNEL_SMOKE] = CALIBRATION_DEFAULT_SMOKE,
+    [SENSOR_CHANNEL_LIGHT] = CALIBRATION_DEFAULT_LIGHT
+};
+
+// 获取通道的默认校准系数
+void CalibrationDefault(SensorChannel channel, ChannelCalibration* calibration)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || calibration == NULL) {
+        return;
+    }
+
+    memcpy(calibration, &g_default_calibration[channel], sizeof(ChannelCalibration));
+}
+
+// 检查校准系数是否有效
+bool CalibrationIsValid(const ChannelCalibration* calibration)
+{
+    return calibration != NULL && calibration->order <= CALIBRATION_MAX_ORDER;
+}
+
+// 按校准系数换算原始读数, 返回定点值
+int32_t CalibrationApplyFixed(const ChannelCalibration* calibration, SensorChannel channel, int32_t raw)
+{
+    if (channel >= SENSOR_CHANNEL_MAX) {
+        return 0;
+    }
+    if (calibration == NULL || calibration->order == 0 || calibration->order > CALIBRATION_MAX_ORDER) {
+        calibration = &g_default_calibration[channel];
+    }
+
+    // 读数归一化为Q16, 各项系数按Horner法累加, 中间结果不超过50位
+    int64_t u = (int64_t)raw * (1 << (CALIBRATION_INPUT_BITS - g_raw_bits[channel]));
+    int64_t acc = calibration->coef[calibration->order];
+    for (int k = calibration->order - 1; k >= 0; k--) {
+        acc = ((acc * u + (1 << (CALIBRATION_INPUT_BITS - 1))) >> CALIBRATION_INPUT_BITS) + calibration->coef[k];
+    }
+
+    if (acc > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (acc < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)acc;
+}
+
+// 按校准系数换算原始读数
+float CalibrationApply(const ChannelCalibration* calibration, SensorChannel channel, int32_t raw)
+{
+    // 乘以2的负整数次幂, 只调整指数
+    return (float)CalibrationApplyFixed(calibration, channel, raw) * (1.0f / (1 << CALIBRATION_FRAC_BITS));
+}
@@ -0,0 +1,54 @@
+#include "data/channel_stats.h"
+#include <string.h>
+
+// 初始化在线统计
+void ChannelStatsInit(ChannelStatsState* state, const uint32_t* tau_ms)
+{
+    memset(state, 0, sizeof(ChannelStatsState));
+    for (int i = 0; i < COLLECTOR_EWMA_COUNT; i++) {
+        state->tau_ms[i] = tau_ms[i];
+    }
+}
+
+// 清空统计值
+void ChannelStatsReset(ChannelStatsState* state)
+{
+    state->count = 0;
+    state->mean = 0.0f;
+    state->m2 = 0.0f;
+    memset(state->ewma, 0, sizeof(state->ewma));
+}
+
+// 输入一个样本
+void ChannelStatsUpdate(ChannelStatsState* state, float value, uint32_t dt_ms)
+{
+    if (state->count < UINT32_MAX) {
+        state->count++;
+    }
+
+    // Welford: 先用旧均值求偏差, 再用新均值更新平方和
+    float delta = value - state->mean;
+    state->mean += delta / (float)state->count;
+    state->m2 += delta * (value - state->mean);
+
+    for (int i = 0; i < COLLECTOR_EWMA_COUNT; i++) {
+        if (state->count == 1) {
+            state->ewma[i] = value;
+            continue;
+        }
+        // 时间常数为0时不做平滑
+        float alpha = state->tau_ms[i] == 0 ? 1.0f : (float)dt_ms / (float)(state->tau_ms[i] + dt_ms);
+        state->ewma[i] += alpha * (value - state->ewma[i]);
+    }
+}
+
+// 导出统计结果
+void ChannelStatsGet(const ChannelStatsState* state, ChannelStats* stats)
+{
+    stats->count = state->count;
+    stats->mean = state->mean;
+    stats->variance = state->count > 1 ? state->m2 / (float)(state->count - 1) : 0.0f;
+    for (int i = 0; i < COLLECTOR_EWMA_COUNT; i++) {
+        stats->ewma[i] = state->ewma[i];
+    }
+}
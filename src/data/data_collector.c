@@ -1,315 +1,2243 @@
 #include "data/data_collector.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "cmsis_os2.h"
+#include "common/clock.h"
 #include "iot_gpio.h"
 #include "iot_adc.h"
+#include "data/sensor_scheduler.h"
+#include "data/sample_ring.h"
+#include "common/seqlock.h"
+#include "data/sample_store.h"
+#include "data/ts_block.h"
+#include "data/channel_stats.h"
+#include "data/window_minmax.h"
+#include "data/sample_filter.h"
+#include "data/subscription.h"
+#include "data/data_delivery.h"
+#include "data/sensor_health.h"
+#include "data/adaptive_rate.h"
+#include "data/flash_log.h"
+#include "data/log_writer.h"
+#include "data/virtual_sensor.h"
+#include "data/sensor_read.h"
+#include "data/trigger_capture.h"
+#include "data/calibration.h"
+#include "business/monitor.h"
+#include "drivers/sensor/sensor_registry.h"
 
-// 数据缓存结构
+// 采集任务参数
+#define COLLECTOR_TASK_STACK_SIZE   4096
+#define COLLECTOR_TASK_PRIORITY     osPriorityHigh
+#define COLLECTOR_TASK_EXIT_WAIT    100     // 等待采集任务退出的最长时间(tick)
+#define COLLECTOR_TRIGGER_TIMEOUT   2000    // 等待手动触发完成的最长时间(ms)
+
+// 完整样本环形缓存的最大容量, 只保留最近的样本供CollectorReadCache无锁读取, 历史查询及迭代由定点存储提供
+#define COLLECTOR_RECENT_SIZE       4
+
+// 每通道长期归档的默认压缩块数量
+#define COLLECTOR_ARCHIVE_BLOCKS    16
+
+// 默认EWMA时间常数(ms)
+#define COLLECTOR_EWMA_FAST_TAU     10000
+#define COLLECTOR_EWMA_SLOW_TAU     60000
+
+// 默认故障处理策略
+#define COLLECTOR_MAX_RETRIES       2
+#define COLLECTOR_RETRY_DELAY_MS    100
+#define COLLECTOR_DEGRADE_THRESHOLD 5
+#define COLLECTOR_MAX_BACKOFF_MS    60000
+
+// 按需读取结果的默认新鲜度有效期(ms), 不低于驱动的最小读取间隔
+#define COLLECTOR_FRESH_TTL_MS      100
+
+// 触发捕获的默认突发采样周期(ms)
+#define COLLECTOR_BURST_PERIOD_MS   100
+
+// 滑动窗口默认参数
+#define COLLECTOR_WINDOW_MS         60000
+#define COLLECTOR_WINDOW_MAX_CAPACITY 256   // 按采样周期估算的队列容量上限, 超出时溢出期间极值无效
+
+// 采集任务事件标志
+#define COLLECTOR_FLAG_START        0x0001  // 启动采集, 重置调度
+#define COLLECTOR_FLAG_RESCHEDULE   0x0002  // 调度参数变化
+#define COLLECTOR_FLAG_EXIT         0x0004  // 退出采集任务
+#define COLLECTOR_FLAG_TRIGGER      0x0008  // 手动触发采集或按需读取
+#define COLLECTOR_FLAG_CAPTURE      0x0010  // 触发捕获或释放捕获
+#define COLLECTOR_FLAG_ALL          (COLLECTOR_FLAG_START | COLLECTOR_FLAG_RESCHEDULE | \
+                                     COLLECTOR_FLAG_EXIT | COLLECTOR_FLAG_TRIGGER | \
+                                     COLLECTOR_FLAG_CAPTURE)
+
+// 按需读取完成标志在g_trigger_done中的起始位, 低位为手动采集完成标志
+#define COLLECTOR_READ_DONE_SHIFT   SENSOR_TYPE_MAX
+
+// 等待异步转换完成的请求(仅采集任务访问)
+typedef struct {
+    uint32_t mask;                      // 等待中的传感器掩码
+    uint32_t ready[SENSOR_TYPE_MAX];    // 转换完成时间(tick)
+} DeferredRequests;
+
+// 最新数据槽, 双缓冲版本锁保护, 读者无需加锁
+typedef struct {
+    SeqLock lock;        // 版本锁
+    SensorData buf[2];   // 双缓冲
+} LatestSlot;
+
+// 虚拟传感器缓存, 以各输入序号之和作为版本号
+typedef struct {
+    uint32_t stamp;   // 计算时的版本号, 0表示尚未计算
+    SensorData data;  // 计算结果
+} VirtualSlot;
+
+// 数据帧槽, 采集任务每个周期组装一次并通过版本锁发布
 typedef struct {
-    SensorData* data;     // 数据缓存数组
-    uint32_t size;        // 缓存大小
-    uint32_t count;       // 当前数据数量
-    uint32_t index;       // 当前写入位置
-} DataCache;
+    SeqLock lock;          // 版本锁
+    SensorFrame buf[2];    // 双缓冲
+} FrameSlot;
+
+// 通道校准系数表, 双缓冲版本锁保护, 任意任务执行传感器读取时无锁获取
+typedef struct {
+    SeqLock lock;                                       // 版本锁
+    ChannelCalibration buf[2][SENSOR_CHANNEL_MAX];      // 双缓冲
+} CalibrationTable;
+
+// 待生效的调度参数, 设置者由互斥锁串行并通过版本锁发布, 采集任务无锁读取后应用
+typedef struct {
+    SeqLock lock;             // 版本锁
+    SensorSchedule buf[2];    // 双缓冲
+} ScheduleSlot;
+
+// 通道统计槽, 采集任务维护统计状态并通过版本锁发布快照
+typedef struct {
+    ChannelStatsState state;  // 统计状态(仅采集任务访问)
+    SeqLock lock;             // 版本锁
+    ChannelStats buf[2];      // 双缓冲快照
+} StatsSlot;
+
+// 通道滑动窗口槽, 采集任务维护单调队列并通过版本锁发布极值
+typedef struct {
+    WindowMinMax win;         // 单调队列(仅采集任务访问)
+    uint32_t window_ms;       // 当前窗口长度(ms)
+    SeqLock lock;             // 版本锁
+    ChannelMinMax buf[2];     // 双缓冲快照
+} WindowSlot;
+
+// 传感器健康槽, 采集任务维护健康状态并通过版本锁发布快照
+typedef struct {
+    SensorHealth state;       // 健康状态(仅采集任务访问)
+    SeqLock lock;             // 版本锁
+    SensorHealth buf[2];      // 双缓冲快照
+} HealthSlot;
+
+// 时序统计槽, 统计通过版本锁发布快照, 周期记录按序号写入环形缓冲, 读者丢弃复制期间被覆盖的记录
+typedef struct {
+    CollectorTimingStats state;                          // 统计(仅采集任务访问)
+    SeqLock lock;                                        // 版本锁
+    CollectorTimingStats buf[2];                         // 双缓冲快照
+    CollectorCycleRecord log[COLLECTOR_CYCLE_LOG_SIZE];  // 最近的周期记录
+    uint32_t log_head;                                   // 已发布的记录总数, 原子访问
+    uint32_t log_writing;                                // 正在写入或已写完的记录总数, 原子访问
+    uint32_t log_base;                                   // 清除点, 序号小于base的记录不再可见, 原子访问
+} TimingSlot;
+
+// 唤醒延迟直方图各桶的上限(ms)
+static const uint32_t g_jitter_bounds_ms[COLLECTOR_JITTER_BUCKETS - 1] = {
+    1, 2, 5, 10, 20, 50, 100
+};
+
+// 默认调度优先级: 烟雾检测最重要, 温湿度读取最慢
+static const uint8_t g_default_priority[SENSOR_TYPE_MAX] = {
+    [SENSOR_TYPE_DHT11] = 1,
+    [SENSOR_TYPE_MQ2] = 3,
+    [SENSOR_TYPE_BH1750] = 2
+};
 
 // 全局变量
 static CollectorState g_state = COLLECTOR_STATE_IDLE;
 static CollectorError g_error = COLLECTOR_ERROR_NONE;
 static CollectorConfig g_config = {0};
-static DataCallback g_callback = NULL;
-static osTimerId_t g_timer = NULL;
-static DataCache g_cache[SENSOR_TYPE_MAX] = {0};
-static SensorData g_latest[SENSOR_TYPE_MAX] = {0};
+static HealthPolicy g_health_policy = {0};
+static HealthSlot g_health[SENSOR_TYPE_MAX] = {0};
+static AdaptiveRate g_adaptive[SENSOR_TYPE_MAX] = {0};
+static uint64_t g_adaptive_ts[SENSOR_TYPE_MAX] = {0};
+static SubscriptionTable g_subscriptions = {0};
+static osMutexId_t g_subscription_mutex = NULL;
+static int g_legacy_subscriber = -1;
+static osThreadId_t g_task = NULL;
+static volatile bool g_task_running = false;
+static uint32_t g_schedule_dirty = 0;
+static ScheduleSlot g_schedule_pending[SENSOR_TYPE_MAX] = {0};
+static osMutexId_t g_config_mutex = NULL;
+static SensorScheduler g_scheduler;
+static bool g_async_started[SENSOR_TYPE_MAX] = {false};   // 异步传感器已提前触发转换(仅采集任务访问)
+static uint32_t g_async_due[SENSOR_TYPE_MAX] = {0};       // 触发转换时调度项的到期时间(tick)
+static uint32_t g_trigger_mask = 0;
+static int g_trigger_result[SENSOR_TYPE_MAX] = {0};
+static osEventFlagsId_t g_trigger_done = NULL;
+static DeferredRequests g_trigger_deferred = {0};
+static uint32_t g_read_mask = 0;
+static DeferredRequests g_read_deferred = {0};
+static int g_read_result[SENSOR_TYPE_MAX] = {0};
+static LatestSlot g_read_data[SENSOR_TYPE_MAX] = {0};   // 按需读取结果, 采集任务发布
+static TimingSlot g_timing = {0};
+static uint32_t g_timing_reset = 0;
+static SampleRing g_cache[SENSOR_TYPE_MAX] = {0};
+static SampleStore g_store[SENSOR_TYPE_MAX] = {0};
+static osMutexId_t g_store_mutex = NULL;
+static TsArchive g_archive[SENSOR_CHANNEL_MAX] = {0};
+static LatestSlot g_latest[SENSOR_TYPE_MAX] = {0};
+static VirtualSlot g_virtual[SENSOR_TYPE_VIRTUAL_COUNT] = {0};
+static osMutexId_t g_virtual_mutex = NULL;
+static FrameSlot g_frame = {0};
+static uint32_t g_frame_pending = 0;
+static FrameCallback g_frame_callback = NULL;
+static TriggerCapture g_capture = {0};
+static uint32_t g_capture_burst_ms = 0;
+static bool g_capture_request = false;
+static bool g_capture_release = false;
+static bool g_capture_ready = false;
+static bool g_capture_done = false;
+static CaptureCallback g_capture_callback = NULL;
+static CalibrationTable g_calibration = {0};
+static StatsSlot g_stats[SENSOR_CHANNEL_MAX] = {0};
+static uint32_t g_stats_reset = 0;
+static WindowSlot g_window[SENSOR_CHANNEL_MAX] = {0};
+static uint32_t g_window_pending[SENSOR_CHANNEL_MAX] = {0};
+static uint32_t g_window_dirty = 0;
+static SampleFilter g_filter[SENSOR_CHANNEL_MAX];
+static uint64_t g_filter_ts[SENSOR_CHANNEL_MAX] = {0};
+static ChannelFilterConfig g_filter_pending[SENSOR_CHANNEL_MAX];
+static uint32_t g_filter_dirty = 0;
+
+// 读取最新数据的一致快照, 返回其版本号
+static uint32_t ReadLatest(SensorType type, SensorData* data)
+{
+    const LatestSlot* latest = &g_latest[type];
+    uint32_t seq;
+
+    do {
+        seq = SeqLockReadBegin(&latest->lock);
+        memcpy(data, &latest->buf[seq & 1], sizeof(SensorData));
+    } while (!SeqLockReadValid(&latest->lock, seq));
+
+    return seq;
+}
+
+// 虚拟传感器的版本号, 输入尚无数据时返回0
+static uint32_t GetVirtualStamp(SensorType type, SensorData latest[SENSOR_TYPE_MAX])
+{
+    uint32_t inputs = VirtualSensorInputMask(type);
+    uint32_t stamp = 0;
+
+    for (SensorType input = SENSOR_TYPE_DHT11; input < SENSOR_TYPE_MAX; input++) {
+        if ((inputs & (1U << input)) == 0) {
+            continue;
+        }
+        uint32_t seq = latest != NULL ? ReadLatest(input, &latest[input]) : SeqLockReadBegin(&g_latest[input].lock);
+        if (seq == 0) {
+            return 0;
+        }
+        stamp += seq;
+    }
+
+    return stamp;
+}
+
+// 读取虚拟传感器, 输入更新后的第一次读取才重新计算
+static uint32_t ReadVirtual(SensorType type, SensorData* data)
+{
+    SensorData latest[SENSOR_TYPE_MAX];
+    uint32_t stamp = GetVirtualStamp(type, latest);
+
+    if (stamp == 0 || g_virtual_mutex == NULL || osMutexAcquire(g_virtual_mutex, osWaitForever) != osOK) {
+        return 0;
+    }
+    VirtualSlot* slot = &g_virtual[type - SENSOR_TYPE_MAX - 1];
+    if (slot->stamp != stamp) {
+        VirtualSensorCompute(type, latest, &slot->data);
+        slot->stamp = stamp;
+    }
+    memcpy(data, &slot->data, sizeof(SensorData));
+    osMutexRelease(g_virtual_mutex);
+
+    return stamp;
+}
+
+// 更新状态
+static void UpdateState(CollectorState state, CollectorError error)
+{
+    g_state = state;
+    g_error = error;
+}
+
+// 按通道校准系数换算原始读数, 只有最后一步转换为浮点
+static float Calibrate(SensorChannel channel, int32_t raw)
+{
+    ChannelCalibration calibration;
+    uint32_t seq;
+
+    do {
+        seq = SeqLockReadBegin(&g_calibration.lock);
+        memcpy(&calibration, &g_calibration.buf[seq & 1][channel], sizeof(ChannelCalibration));
+    } while (!SeqLockReadValid(&g_calibration.lock, seq));
+
+    return CalibrationApply(&calibration, channel, raw);
+}
+
+// 毫秒转换为tick, 至少为1个tick
+static uint32_t MsToTicks(uint32_t ms)
+{
+    uint64_t ticks = ((uint64_t)ms * osKernelGetTickFreq() + 999) / 1000;
+    return ticks == 0 ? 1 : (uint32_t)ticks;
+}
+
+// tick转换为毫秒
+static uint32_t TicksToMs(uint32_t ticks)
+{
+    return (uint32_t)((uint64_t)ticks * 1000 / osKernelGetTickFreq());
+}
+
+// 计算两个时间戳(us)之间的毫秒数, 超出32位时饱和
+static uint32_t ElapsedMs(uint64_t since, uint64_t until)
+{
+    uint64_t ms = until > since ? (until - since) / CLOCK_US_PER_MS : 0;
+    return ms > UINT32_MAX ? UINT32_MAX : (uint32_t)ms;
+}
+
+// 传感器驱动要求的最小读取间隔(ms), 真实传感器类型与驱动类型一一对应
+static uint32_t GetMinInterval(SensorType type)
+{
+    const sensor_ops_t* ops = SensorGetOps((sensor_type_t)type);
+    return ops != NULL ? ops->caps.min_interval_ms : 0;
+}
+
+// 按驱动的最小读取间隔限制周期或延迟(ms)
+static uint32_t LimitInterval(SensorType type, uint32_t ms)
+{
+    uint32_t min_interval = GetMinInterval(type);
+    return ms < min_interval ? min_interval : ms;
+}
+
+// 异步传感器需要在采样时刻之前触发转换的提前量(tick), 同步传感器为0
+static uint32_t GetConversionLead(SensorType type)
+{
+    const sensor_ops_t* ops = SensorGetOps((sensor_type_t)type);
+    return (ops != NULL && (ops->caps.flags & SENSOR_CAP_ASYNC)) ? MsToTicks(ops->caps.conversion_ms) : 0;
+}
+
+// 计算传感器的实际采样周期(ms)
+static uint32_t GetSchedulePeriod(SensorType type)
+{
+    // 其他任务查询采样周期时也会调用, 周期字段由采集任务原子更新
+    uint32_t period = __atomic_load_n(&g_config.schedule[type].period_ms, __ATOMIC_RELAXED);
+    if (period == 0) {
+        period = g_config.collect_interval;
+    }
+
+    // 不低于驱动的最小读取间隔, 如DHT11不能高于1Hz读取
+    return LimitInterval(type, period);
+}
+
+// 计算传感器下一次采样的周期(ms), 启用自适应采样时使用调整后的周期
+static uint32_t GetSamplePeriod(SensorType type)
+{
+    uint32_t period = GetSchedulePeriod(type);
+    if (g_config.adaptive.enabled) {
+        period = __atomic_load_n(&g_adaptive[type].period_ms, __ATOMIC_RELAXED);
+    }
+
+    // 触发捕获的触发后窗口内按突发周期采样
+    if (g_capture.state == CAPTURE_STATE_TRIGGERED && g_capture_burst_ms < period) {
+        period = g_capture_burst_ms;
+    }
+
+    return LimitInterval(type, period);
+}
+
+// 正常调度可能使用的最短采样周期(ms): 调度周期与自适应最短周期中的较小值
+static uint32_t GetFastestSchedulePeriod(SensorType type)
+{
+    uint32_t period = GetSchedulePeriod(type);
+    if (g_config.adaptive.enabled) {
+        uint32_t min_period = g_config.adaptive.min_period_ms != 0 ? g_config.adaptive.min_period_ms : period / 4;
+        period = min_period < period ? min_period : period;
+    }
+
+    period = LimitInterval(type, period);
+    return period != 0 ? period : 1;
+}
+
+// 调度器可能使用的最短采样周期(ms): 正常调度的最短周期与突发周期中的较小值
+static uint32_t GetFastestPeriod(SensorType type)
+{
+    uint32_t period = GetFastestSchedulePeriod(type);
+    if (g_config.capture.pre_ms != 0) {
+        uint32_t burst = g_config.capture.burst_period_ms != 0 ? g_config.capture.burst_period_ms :
+            COLLECTOR_BURST_PERIOD_MS;
+        period = burst < period ? burst : period;
+    }
+
+    period = LimitInterval(type, period);
+    return period != 0 ? period : 1;
+}
+
+// 计算通道滑动窗口的队列容量, 按窗口内以最短周期采样的样本数估算
+static uint32_t GetWindowCapacity(SensorChannel channel, uint32_t window_ms)
+{
+    if (g_config.window_capacity != 0) {
+        return g_config.window_capacity;
+    }
+
+    uint32_t capacity = window_ms / GetFastestPeriod(CollectorGetChannelSensor(channel)) + 2;
+    return capacity < COLLECTOR_WINDOW_MAX_CAPACITY ? capacity : COLLECTOR_WINDOW_MAX_CAPACITY;
+}
+
+// 根据样本的变化率及与报警阈值的距离调整采样周期
+static void UpdateAdaptive(const SensorData* data)
+{
+    if (!g_config.adaptive.enabled) {
+        return;
+    }
+
+    uint32_t dt_ms = ElapsedMs(g_adaptive_ts[data->type], data->timestamp);
+    g_adaptive_ts[data->type] = data->timestamp;
+    AdaptiveRateUpdate(&g_adaptive[data->type], &g_config.adaptive, data, dt_ms,
+        GetSchedulePeriod(data->type));
+}
+
+// 更新通道在线统计并发布快照
+static void UpdateStats(SensorChannel channel, uint64_t timestamp, float value)
+{
+    StatsSlot* slot = &g_stats[channel];
+    uint32_t mask = 1U << channel;
+    const ChannelStats* prev = &slot->buf[slot->lock.seq & 1];
+    uint32_t dt_ms = slot->state.count > 0 ? ElapsedMs(prev->last_ts, timestamp) : 0;
+
+    // 重置请求由其他任务发出, 在这里统一生效
+    if (__atomic_fetch_and(&g_stats_reset, ~mask, __ATOMIC_ACQ_REL) & mask) {
+        ChannelStatsReset(&slot->state);
+    }
+    ChannelStatsUpdate(&slot->state, value, dt_ms);
+
+    uint32_t index = SeqLockWriteBegin(&slot->lock);
+    ChannelStatsGet(&slot->state, &slot->buf[index]);
+    slot->buf[index].last_ts = timestamp;
+    SeqLockWriteEnd(&slot->lock);
+}
+
+// 更新通道滑动窗口并发布极值
+static void UpdateWindow(SensorChannel channel, uint64_t timestamp, float value)
+{
+    WindowSlot* slot = &g_window[channel];
+    uint32_t mask = 1U << channel;
+
+    // 窗口长度由其他任务修改, 在这里统一生效; 扩容失败时保留原容量, 溢出期间极值标记为无效
+    if (__atomic_fetch_and(&g_window_dirty, ~mask, __ATOMIC_ACQ_REL) & mask) {
+        slot->window_ms = __atomic_load_n(&g_window_pending[channel], __ATOMIC_RELAXED);
+        WindowMinMaxSetWindow(&slot->win, slot->window_ms * CLOCK_US_PER_MS);
+        WindowMinMaxResize(&slot->win, GetWindowCapacity(channel, slot->window_ms));
+    }
+    WindowMinMaxPush(&slot->win, timestamp, value);
+
+    uint32_t index = SeqLockWriteBegin(&slot->lock);
+    ChannelMinMax* minmax = &slot->buf[index];
+    minmax->window_ms = slot->window_ms;
+    minmax->valid = WindowMinMaxGet(&slot->win, &minmax->min, &minmax->max);
+    SeqLockWriteEnd(&slot->lock);
+}
+
+// 按订阅条件通知订阅者, 回调中可以取消订阅(互斥锁可重入)
+static void DispatchData(const SensorData* data)
+{
+    if (osMutexAcquire(g_subscription_mutex, osWaitForever) == osOK) {
+        SubscriptionDispatch(&g_subscriptions, data);
+        osMutexRelease(g_subscription_mutex);
+    }
+}
+
+// 缓存数据
+static int CacheData(const SensorData* data)
+{
+    if (data == NULL || data->type >= SENSOR_TYPE_MAX) {
+        return -1;
+    }
+    
+    SampleRing* cache = &g_cache[data->type];
+    if (cache->slots == NULL || cache->size == 0) {
+        return -1;
+    }
+    
+    // 写入数据, 只有采集任务写缓存, 读者无需加锁
+    SampleRingPush(cache, data);
+    
+    // 写入定点压缩历史
+    if (osMutexAcquire(g_store_mutex, osWaitForever) == osOK) {
+        SampleStoreAppend(&g_store[data->type], data);
+        for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+            float value = 0.0f;
+            if (CollectorGetChannelValue(data, channel, &value) == 0) {
+                TsArchiveAppend(&g_archive[channel], data->timestamp, value);
+            }
+        }
+        osMutexRelease(g_store_mutex);
+    }
+    
+    // 写入持久化日志, 闪存擦写由低优先级的写入任务完成, 采集任务只入队
+    if (g_config.flash_log != NULL) {
+        LogWriterPost(data);
+    }
+    
+    // 更新多分辨率汇总、在线统计及滑动窗口
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        float value = 0.0f;
+        if (CollectorGetChannelValue(data, channel, &value) == 0) {
+            MonitorFeed(channel, data->timestamp, value);
+            UpdateStats(channel, data->timestamp, value);
+            UpdateWindow(channel, data->timestamp, value);
+        }
+    }
+    
+    // 调整下一次采样周期
+    UpdateAdaptive(data);
+    
+    // 更新最新数据
+    LatestSlot* latest = &g_latest[data->type];
+    uint32_t index = SeqLockWriteBegin(&latest->lock);
+    memcpy(&latest->buf[index], data, sizeof(SensorData));
+    SeqLockWriteEnd(&latest->lock);
+    
+    // 通知订阅者, 异步模式下只入队
+    if (g_subscriptions.count > 0) {
+        DeliveryPost(data);
+    }
+    
+    return 0;
+}
+
+// 将数值写回传感器数据的指定通道
+static void SetChannelValue(SensorData* data, SensorChannel channel, float value)
+{
+    switch (channel) {
+        case SENSOR_CHANNEL_TEMPERATURE:
+            data->data.dht11.temperature = value;
+            break;
+        case SENSOR_CHANNEL_HUMIDITY:
+            data->data.dht11.humidity = value;
+            break;
+        case SENSOR_CHANNEL_SMOKE:
+            data->data.mq2.smoke = value;
+            break;
+        default:
+            data->data.bh1750.light = value;
+            break;
+    }
+}
+
+// 对采集到的数据逐通道执行滤波链
+static void FilterData(SensorData* data)
+{
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        float value = 0.0f;
+        if (CollectorGetChannelValue(data, channel, &value) != 0) {
+            continue;
+        }
+        
+        // 滤波配置由其他任务修改, 在这里统一生效; 配置锁只在修改后获取一次, 不与历史读者竞争
+        uint32_t mask = 1U << channel;
+        if ((__atomic_load_n(&g_filter_dirty, __ATOMIC_ACQUIRE) & mask) &&
+            osMutexAcquire(g_config_mutex, osWaitForever) == osOK) {
+            SampleFilterInit(&g_filter[channel], channel, &g_filter_pending[channel]);
+            __atomic_fetch_and(&g_filter_dirty, ~mask, __ATOMIC_RELEASE);
+            osMutexRelease(g_config_mutex);
+        }
+        
+        uint32_t dt_ms = ElapsedMs(g_filter_ts[channel], data->timestamp);
+        g_filter_ts[channel] = data->timestamp;
+        SetChannelValue(data, channel, SampleFilterApply(&g_filter[channel], value, dt_ms));
+    }
+}
+
+// 通过注册的驱动读取传感器, 原始读数逐通道按校准系数换算
+// 异步驱动已由采集任务提前触发转换时直接读取结果, 否则触发转换并返回SENSOR_READ_BUSY,
+// 由采集任务在转换完成后再次读取, 采集任务不在转换期间等待
+static int ReadSensor(SensorType type, SensorData* data)
+{
+    const sensor_ops_t* ops = SensorGetOps((sensor_type_t)type);
+    sensor_raw_t raw = {0};
+
+    if (ops == NULL) {
+        return -1;
+    }
+
+    sensor_status_t status;
+    if (ops->caps.flags & SENSOR_CAP_ASYNC) {
+        status = ops->start();
+        if (status == SENSOR_OK) {
+            status = ops->read_raw(&raw);
+        }
+        if (status == SENSOR_ERROR_BUSY) {
+            return SENSOR_READ_BUSY;
+        }
+    } else {
+        status = ops->read_raw(&raw);
+    }
+    if (status != SENSOR_OK) {
+        return -1;
+    }
+
+    data->type = type;
+    data->timestamp = ClockNowUs();
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        if (raw.mask & (1U << channel)) {
+            SetChannelValue(data, channel, Calibrate(channel, raw.value[channel]));
+        }
+    }
+
+    return 0;
+}
+
+// 获取按需读取结果的新鲜度有效期(ms)
+static uint32_t GetFreshTtl(SensorType type)
+{
+    uint32_t ttl = g_config.fresh_ttl_ms[type];
+    if (ttl == 0) {
+        ttl = LimitInterval(type, COLLECTOR_FRESH_TTL_MS);
+    }
+    return ttl;
+}
+
+// 采集数据并写入缓存
+// 周期采集只复用半个周期内其他任务读到的结果, 避免复用自己上一次的样本;
+// 手动触发按新鲜度有效期复用. 复用的结果若已写入过缓存则不再重复写入
+static int CollectData(SensorType type, bool periodic)
+{
+    SensorData data = {0};
+    SensorData latest;
+    
+    uint32_t max_age = GetFreshTtl(type);
+    if (periodic && max_age > GetSamplePeriod(type) / 2) {
+        max_age = GetSamplePeriod(type) / 2;
+    }
+    
+    int ret = SensorReadShared(type, max_age, &data);
+    ReadLatest(type, &latest);
+    if (ret == 0 && data.timestamp != latest.timestamp) {
+        // 只有写入新样本时才需要重新组装数据帧
+        g_frame_pending |= 1U << type;
+        // 触发捕获保存滤波前的原始样本
+        g_capture_done |= TriggerCapturePush(&g_capture, &data);
+        FilterData(&data);
+        CacheData(&data);
+    }
+    
+    return ret;
+}
+
+// 获取传感器的调度优先级
+static uint8_t GetSchedulePriority(SensorType type)
+{
+    uint8_t priority = g_config.schedule[type].priority;
+    return priority != 0 ? priority : g_default_priority[type];
+}
+
+// 按配置将传感器加入调度器
+static void ScheduleSensor(SensorType type, uint32_t now)
+{
+    const SensorSchedule* schedule = &g_config.schedule[type];
+    uint8_t priority = GetSchedulePriority(type);
+    uint32_t phase = schedule->phase_ms;
+
+    // 未单独配置的传感器在默认周期内错开相位, 避免总线访问集中在同一时刻
+    if (schedule->period_ms == 0 && phase == 0) {
+        phase = g_config.collect_interval * type / SENSOR_TYPE_MAX;
+    }
+
+    // 异步传感器提前一个转换时间触发, 使读取落在相位对应的截止时间
+    g_async_started[type] = false;
+    SchedulerAdd(&g_scheduler, (uint8_t)type, MsToTicks(GetSchedulePeriod(type)),
+        now + MsToTicks(phase) - GetConversionLead(type), priority);
+}
+
+// 记录一个采集周期的时序并发布统计快照
+static void RecordCycle(const CollectorCycleRecord* record, uint32_t skipped)
+{
+    CollectorTimingStats* stats = &g_timing.state;
+    uint32_t jitter = TicksToMs(record->start - record->due);
+    uint32_t busy = TicksToMs(record->finish - record->start);
+    uint32_t bucket = 0;
+
+    // 清除请求由其他任务发出, 在这里统一生效
+    if (__atomic_exchange_n(&g_timing_reset, 0, __ATOMIC_ACQ_REL) != 0) {
+        memset(stats, 0, sizeof(CollectorTimingStats));
+        __atomic_store_n(&g_timing.log_base, g_timing.log_head, __ATOMIC_RELEASE);
+    }
+
+    while (bucket < COLLECTOR_JITTER_BUCKETS - 1 && jitter >= g_jitter_bounds_ms[bucket]) {
+        bucket++;
+    }
+
+    stats->cycles++;
+    stats->skipped += skipped;
+    stats->jitter_histogram[bucket]++;
+    if (jitter > stats->max_jitter_ms) {
+        stats->max_jitter_ms = jitter;
+    }
+    if (busy > stats->max_busy_ms) {
+        stats->max_busy_ms = busy;
+    }
+
+    uint32_t index = SeqLockWriteBegin(&g_timing.lock);
+    memcpy(&g_timing.buf[index], stats, sizeof(CollectorTimingStats));
+    SeqLockWriteEnd(&g_timing.lock);
+
+    // 先公布正在写入的序号, 写完后发布
+    uint32_t head = g_timing.log_head;
+    __atomic_store_n(&g_timing.log_writing, head + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&g_timing.log[head % COLLECTOR_CYCLE_LOG_SIZE], record, sizeof(CollectorCycleRecord));
+    __atomic_store_n(&g_timing.log_head, head + 1, __ATOMIC_RELEASE);
+}
+
+// 报告传感器读取结果并发布健康快照, 返回下一次读取前的延迟(ms), 0表示按周期调度
+static uint32_t ReportHealth(SensorType type, bool success)
+{
+    HealthSlot* slot = &g_health[type];
+    bool degraded = slot->state.state == SENSOR_HEALTH_DEGRADED;
+    uint32_t delay = SensorHealthReport(&slot->state, &g_health_policy, success,
+        GetSchedulePeriod(type), ClockNowUs());
+
+    // 降级状态变化影响数据帧的有效通道, 需要重新组装
+    if (degraded != (slot->state.state == SENSOR_HEALTH_DEGRADED)) {
+        g_frame_pending |= 1U << type;
+    }
+
+    uint32_t index = SeqLockWriteBegin(&slot->lock);
+    memcpy(&slot->buf[index], &slot->state, sizeof(SensorHealth));
+    SeqLockWriteEnd(&slot->lock);
+    return delay;
+}
+
+// 采集所有已到期的传感器, 一次唤醒处理的所有到期项记为一个采集周期
+static void RunDueSensors(void)
+{
+    SchedulerEntry entry;
+    CollectorCycleRecord record = {0};
+    uint32_t now = osKernelGetTickCount();
+    uint32_t skipped = 0;
+
+    if (SchedulerPeek(&g_scheduler, &entry) != 0 || (int32_t)(entry.due - now) > 0) {
+        return;
+    }
+
+    while (g_state == COLLECTOR_STATE_RUNNING && SchedulerPopDue(&g_scheduler, now, &entry) == 0) {
+        // 单个传感器失败只影响自身的调度, 其他传感器照常采样
+        SensorType type = (SensorType)entry.id;
+        int ret = -1;
+        uint32_t lead = GetConversionLead(type);
+        uint32_t deadline = entry.due;
+        if (g_async_started[type]) {
+            // 转换完成, 在截止时间读取结果; 转换完成时刻与tick边界有偏差时下一个tick再读
+            ret = CollectData(type, true);
+            if (ret == SENSOR_READ_BUSY) {
+                SchedulerAdd(&g_scheduler, entry.id, entry.period, now + 1, entry.priority);
+                continue;
+            }
+            g_async_started[type] = false;
+            deadline = g_async_due[type];
+            entry.due = deadline - lead;  // 按触发转换时刻的相位重新入堆
+        } else if (lead != 0) {
+            // 异步传感器的调度项提前一个转换时间到期, 先触发转换, 截止时间再次到期时读取, 采集任务不等待
+            const sensor_ops_t* ops = SensorGetOps((sensor_type_t)type);
+            if (ops != NULL && ops->start() == SENSOR_OK) {
+                uint32_t ready = now + lead;
+                g_async_started[type] = true;
+                g_async_due[type] = entry.due + lead;
+                SchedulerAdd(&g_scheduler, entry.id, entry.period,
+                    (int32_t)(g_async_due[type] - ready) > 0 ? g_async_due[type] : ready, entry.priority);
+                continue;
+            }
+        } else {
+            ret = CollectData(type, true);
+        }
+
+        // 唤醒延迟按本周期第一次读取相对其截止时间计算, 不计提前触发转换的调度项
+        if (record.sensors == 0) {
+            record.due = deadline;
+            record.start = now;
+        }
+        record.sensors |= (uint8_t)(1U << entry.id);
+
+        // 读取耗时可能跨越其他传感器的到期时间, 使用采集后的时间重新入堆
+        now = osKernelGetTickCount();
+        uint32_t delay = ReportHealth(type, ret == 0);
+        if (delay != 0) {
+            delay = LimitInterval(type, delay);
+            SchedulerAdd(&g_scheduler, entry.id, entry.period, now + MsToTicks(delay), entry.priority);
+        } else {
+            // 自适应采样时按本次样本调整后的周期重新入堆
+            if (g_config.adaptive.enabled) {
+                entry.period = MsToTicks(GetSamplePeriod(type));
+            }
+            uint32_t missed = 0;
+            SchedulerReschedule(&g_scheduler, &entry, now, &missed);
+            skipped += missed;
+        }
+    }
+
+    record.finish = now;
+    if (record.sensors != 0) {
+        RecordCycle(&record, skipped);
+    }
+}
+
+// 取出需要执行的请求: 新请求及转换已完成的延后请求, 转换尚未完成的传感器的新请求继续等待
+static uint32_t TakeRequests(uint32_t* requests, DeferredRequests* deferred)
+{
+    uint32_t mask = __atomic_exchange_n(requests, 0, __ATOMIC_ACQ_REL) | deferred->mask;
+    uint32_t now = osKernelGetTickCount();
+
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if ((deferred->mask & (1U << type)) && (int32_t)(deferred->ready[type] - now) <= 0) {
+            deferred->mask &= ~(1U << type);
+        }
+    }
+
+    return mask & ~deferred->mask;
+}
+
+// 异步转换已触发, 请求延后到转换完成时再执行
+static void DeferRequest(DeferredRequests* deferred, SensorType type)
+{
+    deferred->mask |= 1U << type;
+    deferred->ready[type] = osKernelGetTickCount() + GetConversionLead(type);
+}
+
+// 执行其他任务请求的手动采集, 并通知等待者
+// 异步传感器与周期采集一样先触发转换, 转换完成后再次执行, 采集任务不等待
+static void RunTriggers(void)
+{
+    uint32_t mask = TakeRequests(&g_trigger_mask, &g_trigger_deferred);
+    uint32_t done = 0;
+
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if (mask & (1U << type)) {
+            int ret = CollectData(type, false);
+            if (ret == SENSOR_READ_BUSY) {
+                DeferRequest(&g_trigger_deferred, type);
+                continue;
+            }
+            g_trigger_result[type] = ret;
+            ReportHealth(type, ret == 0);
+            done |= 1U << type;
+        }
+    }
+
+    if (done != 0) {
+        osEventFlagsSet(g_trigger_done, done);
+    }
+}
+
+// 执行其他任务请求的按需读取, 发布结果后通知等待者
+static void RunReads(void)
+{
+    uint32_t mask = TakeRequests(&g_read_mask, &g_read_deferred);
+    uint32_t done = 0;
+
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if (mask & (1U << type)) {
+            SensorData data = {0};
+            int ret = SensorReadShared(type, GetFreshTtl(type), &data);
+            if (ret == SENSOR_READ_BUSY) {
+                DeferRequest(&g_read_deferred, type);
+                continue;
+            }
+            g_read_result[type] = ret;
+            if (ret == 0) {
+                uint32_t index = SeqLockWriteBegin(&g_read_data[type].lock);
+                memcpy(&g_read_data[type].buf[index], &data, sizeof(SensorData));
+                SeqLockWriteEnd(&g_read_data[type].lock);
+            }
+            done |= 1U << type;
+        }
+    }
+
+    if (done != 0) {
+        osEventFlagsSet(g_trigger_done, done << COLLECTOR_READ_DONE_SHIFT);
+    }
+}
+
+// 获取手动采集结果, 任一传感器失败时返回-1
+static int GetTriggerResult(uint32_t mask)
+{
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if ((mask & (1U << type)) && g_trigger_result[type] != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// 由各传感器的最新数据组装数据帧并发布, 本周期写入过新样本时调用一次
+static void PublishFrame(void)
+{
+    if (g_frame_pending == 0) {
+        return;
+    }
+    g_frame_pending = 0;
+
+    // 采集任务是最新数据和数据帧的唯一写者, 可以直接读取已发布的缓冲区
+    const SensorFrame* prev = &g_frame.buf[g_frame.lock.seq & 1];
+    uint32_t index = SeqLockWriteBegin(&g_frame.lock);
+    SensorFrame* frame = &g_frame.buf[index];
+    memset(frame, 0, sizeof(SensorFrame));
+    frame->seq = g_frame.lock.writing;
+
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        SensorType type = CollectorGetChannelSensor(channel);
+        const LatestSlot* latest = &g_latest[type];
+        const SensorData* data = &latest->buf[latest->lock.seq & 1];
+        if (latest->lock.seq == 0 || CollectorGetChannelValue(data, channel, &frame->value[channel]) != 0) {
+            continue;
+        }
+
+        uint32_t mask = 1U << channel;
+        frame->timestamp[channel] = data->timestamp;
+        if (g_health[type].state.state != SENSOR_HEALTH_DEGRADED) {
+            frame->valid_mask |= mask;
+        }
+        if (data->timestamp != prev->timestamp[channel]) {
+            frame->updated_mask |= mask;
+        }
+    }
+    SeqLockWriteEnd(&g_frame.lock);
+
+    FrameCallback callback = __atomic_load_n(&g_frame_callback, __ATOMIC_ACQUIRE);
+    if (callback != NULL) {
+        callback(frame);
+    }
+}
+
+// 计算距离下一个到期调度项的等待时间
+static uint32_t GetWaitTicks(void)
+{
+    SchedulerEntry next;
+
+    if (g_state != COLLECTOR_STATE_RUNNING || SchedulerPeek(&g_scheduler, &next) != 0) {
+        return osWaitForever;
+    }
+
+    int32_t wait = (int32_t)(next.due - osKernelGetTickCount());
+    return wait > 0 ? (uint32_t)wait : 0;
+}
+
+// 有等待异步转换的请求时不超过最早的转换完成时刻等待
+static uint32_t LimitDeferredWait(uint32_t wait)
+{
+    const DeferredRequests* lists[] = {&g_trigger_deferred, &g_read_deferred};
+    uint32_t now = osKernelGetTickCount();
+
+    for (uint32_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+            if (!(lists[i]->mask & (1U << type))) {
+                continue;
+            }
+            int32_t remain = (int32_t)(lists[i]->ready[type] - now);
+            uint32_t ticks = remain > 0 ? (uint32_t)remain : 0;
+            if (wait == osWaitForever || ticks < wait) {
+                wait = ticks;
+            }
+        }
+    }
+
+    return wait;
+}
+
+// 触发捕获的触发后窗口内不超过窗口结束时刻等待, 传感器全部故障时也能按时完成
+static uint32_t LimitCaptureWait(uint32_t wait)
+{
+    if (g_capture.state != CAPTURE_STATE_TRIGGERED) {
+        return wait;
+    }
+
+    uint32_t remain = MsToTicks(ElapsedMs(ClockNowUs(), g_capture.trigger_ts + g_capture.post_us)) + 1;
+    return (wait == osWaitForever || remain < wait) ? remain : wait;
+}
+
+// 应用其他任务修改的调度参数, 只由采集任务写入g_config.schedule
+static void ApplySchedules(uint32_t dirty)
+{
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if (!(dirty & (1U << type))) {
+            continue;
+        }
+
+        const ScheduleSlot* slot = &g_schedule_pending[type];
+        SensorSchedule schedule;
+        uint32_t seq;
+        do {
+            seq = SeqLockReadBegin(&slot->lock);
+            memcpy(&schedule, &slot->buf[seq & 1], sizeof(SensorSchedule));
+        } while (!SeqLockReadValid(&slot->lock, seq));
+
+        g_config.schedule[type].phase_ms = schedule.phase_ms;
+        g_config.schedule[type].priority = schedule.priority;
+        __atomic_store_n(&g_config.schedule[type].period_ms, schedule.period_ms, __ATOMIC_RELAXED);
+    }
+}
+
+// 初始化调度器中的所有传感器
+static void ResetSchedule(void)
+{
+    uint32_t now = osKernelGetTickCount();
+
+    SchedulerInit(&g_scheduler);
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        ScheduleSensor(type, now);
+    }
+}
+
+// 所有传感器立即开始按突发周期采样
+static void ScheduleBurst(void)
+{
+    uint32_t now = osKernelGetTickCount();
+
+    SchedulerInit(&g_scheduler);
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        g_async_started[type] = false;
+        SchedulerAdd(&g_scheduler, (uint8_t)type, MsToTicks(GetSamplePeriod(type)), now,
+            GetSchedulePriority(type));
+    }
+}
+
+// 处理触发捕获的释放、触发及完成
+static void UpdateCapture(void)
+{
+    if (g_capture.slots == NULL) {
+        return;
+    }
+
+    // 释放后重新等待触发, 之前的样本继续作为触发前样本
+    if (__atomic_exchange_n(&g_capture_release, false, __ATOMIC_ACQ_REL)) {
+        __atomic_store_n(&g_capture_ready, false, __ATOMIC_RELEASE);
+        TriggerCaptureRearm(&g_capture);
+    }
+
+    if (__atomic_exchange_n(&g_capture_request, false, __ATOMIC_ACQ_REL) &&
+        TriggerCaptureFire(&g_capture, ClockNowUs()) == 0 && g_state == COLLECTOR_STATE_RUNNING) {
+        ScheduleBurst();
+    }
+
+    g_capture_done |= TriggerCaptureUpdate(&g_capture, ClockNowUs());
+    if (!g_capture_done) {
+        return;
+    }
+    g_capture_done = false;
+
+    // 恢复正常调度, 冻结的捕获直接交给回调
+    if (g_state == COLLECTOR_STATE_RUNNING) {
+        ResetSchedule();
+    }
+    __atomic_store_n(&g_capture_ready, true, __ATOMIC_RELEASE);
+
+    CaptureCallback callback = __atomic_load_n(&g_capture_callback, __ATOMIC_ACQUIRE);
+    CaptureView view;
+    if (callback != NULL && TriggerCaptureGet(&g_capture, &view) == 0) {
+        callback(&view);
+    }
+}
+
+// 数据采集任务
+static void CollectorTask(void* arg)
+{
+    (void)arg;
+
+    while (g_task_running) {
+        uint32_t wait = LimitCaptureWait(LimitDeferredWait(GetWaitTicks()));
+        uint32_t flags = 0;
+
+        if (wait != 0) {
+            flags = osThreadFlagsWait(COLLECTOR_FLAG_ALL, osFlagsWaitAny, wait);
+            if (flags & osFlagsError) {
+                flags = 0;  // 超时, 有调度项到期
+            }
+        }
+
+        if (flags & COLLECTOR_FLAG_EXIT) {
+            break;
+        }
+
+        // 应用其他任务修改的调度参数
+        uint32_t dirty = __atomic_exchange_n(&g_schedule_dirty, 0, __ATOMIC_ACQ_REL);
+        ApplySchedules(dirty);
+
+        // 启动时按相位重新排布所有传感器, 运行中只重建修改过的传感器
+        if (flags & COLLECTOR_FLAG_START) {
+            ResetSchedule();
+        } else if (dirty != 0 && g_state == COLLECTOR_STATE_RUNNING) {
+            uint32_t now = osKernelGetTickCount();
+            for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+                if (dirty & (1U << type)) {
+                    ScheduleSensor(type, now);
+                }
+            }
+        }
+
+        RunTriggers();
+        RunReads();
+        RunDueSensors();
+        PublishFrame();
+        UpdateCapture();
+    }
+
+    g_task = NULL;
+    osThreadExit();
+}
+
+// 释放初始化时分配的资源, 各步骤对未分配的资源无影响
+static void ReleaseResources(void)
+{
+    // 释放定点压缩历史、长期归档及滑动窗口
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        SampleStoreDeinit(&g_store[type]);
+    }
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        TsArchiveDeinit(&g_archive[channel]);
+        WindowMinMaxDeinit(&g_window[channel].win);
+    }
+    if (g_store_mutex != NULL) {
+        osMutexDelete(g_store_mutex);
+        g_store_mutex = NULL;
+    }
+    if (g_config_mutex != NULL) {
+        osMutexDelete(g_config_mutex);
+        g_config_mutex = NULL;
+    }
+    if (g_virtual_mutex != NULL) {
+        osMutexDelete(g_virtual_mutex);
+        g_virtual_mutex = NULL;
+    }
+    SensorReadDeinit();
+    TriggerCaptureDeinit(&g_capture);
+    CollectorRegisterCaptureCallback(NULL);
+    
+    // 写入持久化日志中尚未写入闪存的记录, 日志由调用者关闭
+    LogWriterDeinit();
+    
+    // 退出投递任务, 清空订阅表
+    DeliveryDeinit();
+    if (g_subscription_mutex != NULL) {
+        osMutexDelete(g_subscription_mutex);
+        g_subscription_mutex = NULL;
+    }
+    SubscriptionInit(&g_subscriptions);
+    g_legacy_subscriber = -1;
+    CollectorRegisterFrameCallback(NULL);
+    
+    // 删除手动触发完成事件
+    if (g_trigger_done != NULL) {
+        osEventFlagsDelete(g_trigger_done);
+        g_trigger_done = NULL;
+    }
+    
+    // 释放缓存
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        if (g_cache[type].slots != NULL) {
+            free(g_cache[type].slots);
+            memset(&g_cache[type], 0, sizeof(SampleRing));
+        }
+    }
+}
+
+// 初始化失败时释放已分配的资源
+static int InitFail(CollectorError error)
+{
+    ReleaseResources();
+    UpdateState(COLLECTOR_STATE_ERROR, error);
+    return -1;
+}
+
+// 初始化数据采集模块
+int CollectorInit(const CollectorConfig* config)
+{
+    if (config == NULL || config->collect_interval == 0 || config->cache_size == 0) {
+        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+        return -1;
+    }
+    
+    // 保存配置
+    memcpy(&g_config, config, sizeof(CollectorConfig));
+    
+    // 初始化传感器健康信息, 未配置故障处理策略时使用默认值
+    if (config->health.max_retries == 0 && config->health.retry_delay_ms == 0 &&
+        config->health.degrade_threshold == 0 && config->health.max_backoff_ms == 0) {
+        g_health_policy.max_retries = COLLECTOR_MAX_RETRIES;
+        g_health_policy.retry_delay_ms = COLLECTOR_RETRY_DELAY_MS;
+        g_health_policy.degrade_threshold = COLLECTOR_DEGRADE_THRESHOLD;
+        g_health_policy.max_backoff_ms = COLLECTOR_MAX_BACKOFF_MS;
+    } else {
+        memcpy(&g_health_policy, &config->health, sizeof(HealthPolicy));
+    }
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        memset(&g_health[type], 0, sizeof(HealthSlot));
+        SensorHealthInit(&g_health[type].state);
+        memcpy(&g_health[type].buf[0], &g_health[type].state, sizeof(SensorHealth));
+        AdaptiveRateInit(&g_adaptive[type], GetSchedulePeriod(type));
+    }
+    
+    // 初始化最近样本缓存, cache_size是每个传感器的缓存内存预算(按完整样本计)
+    uint32_t recent_size = config->cache_size < COLLECTOR_RECENT_SIZE ? config->cache_size : COLLECTOR_RECENT_SIZE;
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        SensorData* storage = malloc(sizeof(SensorData) * recent_size);
+        if (storage == NULL) {
+            return InitFail(COLLECTOR_ERROR_MEMORY);
+        }
+        SampleRingInit(&g_cache[type], storage, recent_size);
+    }
+    
+    // 初始化定点压缩历史, 默认容量由预算中剩余的内存换算, 不少于cache_size
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        uint32_t history_size = config->history_size;
+        if (history_size == 0) {
+            history_size = (config->cache_size - recent_size) * sizeof(SensorData) / SampleStoreSampleBytes(type);
+            if (history_size < config->cache_size) {
+                history_size = config->cache_size;
+            }
+        }
+        if (SampleStoreInit(&g_store[type], type, history_size) != 0) {
+            return InitFail(COLLECTOR_ERROR_MEMORY);
+        }
+    }
+    
+    // 初始化长期压缩归档
+    uint32_t archive_blocks = config->archive_blocks != 0 ? config->archive_blocks : COLLECTOR_ARCHIVE_BLOCKS;
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        if (TsArchiveInit(&g_archive[channel], channel, archive_blocks) != 0) {
+            return InitFail(COLLECTOR_ERROR_MEMORY);
+        }
+    }
+    
+    // 初始化通道在线统计
+    uint32_t tau_ms[COLLECTOR_EWMA_COUNT] = {COLLECTOR_EWMA_FAST_TAU, COLLECTOR_EWMA_SLOW_TAU};
+    for (int i = 0; i < COLLECTOR_EWMA_COUNT; i++) {
+        if (config->ewma_tau_ms[i] != 0) {
+            tau_ms[i] = config->ewma_tau_ms[i];
+        }
+    }
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        memset(&g_stats[channel], 0, sizeof(StatsSlot));
+        ChannelStatsInit(&g_stats[channel].state, tau_ms);
+    }
+    g_stats_reset = 0;
+    
+    // 初始化通道滑动窗口
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        WindowSlot* slot = &g_window[channel];
+        memset(slot, 0, sizeof(WindowSlot));
+        slot->window_ms = config->window_ms[channel] != 0 ? config->window_ms[channel] : COLLECTOR_WINDOW_MS;
+        slot->buf[0].window_ms = slot->window_ms;
+        uint32_t capacity = GetWindowCapacity(channel, slot->window_ms);
+        if (WindowMinMaxInit(&slot->win, slot->window_ms * CLOCK_US_PER_MS, capacity) != 0) {
+            return InitFail(COLLECTOR_ERROR_MEMORY);
+        }
+    }
+    g_window_dirty = 0;
+    
+    // 通道校准系数先使用默认值, 由配置管理模块通过CollectorSetCalibration下发
+    memset(&g_calibration, 0, sizeof(CalibrationTable));
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        CalibrationDefault(channel, &g_calibration.buf[0][channel]);
+    }
+    
+    // 初始化通道滤波链
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        if (SampleFilterInit(&g_filter[channel], channel, &config->filter[channel]) != 0) {
+            return InitFail(COLLECTOR_ERROR_PARAM);
+        }
+        g_filter_ts[channel] = 0;
+    }
+    g_filter_dirty = 0;
+    
+    // 历史数据锁: 采集任务每个样本获取一次, 读者只在复制一块样本或一个压缩块时持有;
+    // 配置锁: 调度、滤波及校准的设置者之间串行, 与历史数据锁分开
+    // 两者都开启优先级继承, 低优先级任务持锁时不会长时间阻塞采集任务
+    osMutexAttr_t inherit_attr = {0};
+    inherit_attr.attr_bits = osMutexPrioInherit;
+    g_store_mutex = osMutexNew(&inherit_attr);
+    if (g_store_mutex == NULL) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    g_schedule_dirty = 0;
+    g_config_mutex = osMutexNew(&inherit_attr);
+    if (g_config_mutex == NULL) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 周期采集、手动触发及其他模块的按需读取共用一次总线读取
+    if (SensorReadInit(ReadSensor) != 0) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    g_virtual_mutex = osMutexNew(NULL);
+    if (g_virtual_mutex == NULL) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 初始化触发捕获缓冲区, 未指定容量时按触发前后窗口内以最短周期采样的次数估算,
+    // 触发前窗口可能按自适应最短周期采样, 触发后窗口按突发周期采样
+    if (config->capture.pre_ms != 0) {
+        const CaptureConfig* capture = &config->capture;
+        g_capture_burst_ms = capture->burst_period_ms != 0 ? capture->burst_period_ms : COLLECTOR_BURST_PERIOD_MS;
+        uint32_t capacity = capture->capacity;
+        for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX && capture->capacity == 0; type++) {
+            capacity += capture->pre_ms / GetFastestSchedulePeriod(type) + capture->post_ms / GetFastestPeriod(type) + 2;
+        }
+        if (TriggerCaptureInit(&g_capture, capacity, capture->pre_ms, capture->post_ms) != 0) {
+            return InitFail(COLLECTOR_ERROR_MEMORY);
+        }
+    }
+    g_capture_request = false;
+    g_capture_release = false;
+    g_capture_ready = false;
+    g_capture_done = false;
+    
+    // 配置了持久化日志时创建日志写入任务
+    if (config->flash_log != NULL && LogWriterInit(config->flash_log, 0) != 0) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 创建订阅表互斥锁, 允许在回调中增删订阅
+    osMutexAttr_t mutex_attr = {0};
+    mutex_attr.attr_bits = osMutexRecursive;
+    SubscriptionInit(&g_subscriptions);
+    g_legacy_subscriber = -1;
+    g_subscription_mutex = osMutexNew(&mutex_attr);
+    if (g_subscription_mutex == NULL) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 创建回调投递队列及投递任务
+    if (DeliveryInit(&config->delivery, DispatchData) != 0) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 创建手动触发完成事件
+    memset(&g_trigger_deferred, 0, sizeof(DeferredRequests));
+    memset(&g_read_deferred, 0, sizeof(DeferredRequests));
+    g_trigger_done = osEventFlagsNew(NULL);
+    if (g_trigger_done == NULL) {
+        return InitFail(COLLECTOR_ERROR_MEMORY);
+    }
+    
+    // 创建采集任务, 传感器读取不再占用定时器任务
+    osThreadAttr_t attr = {0};
+    attr.name = "CollectorTask";
+    attr.stack_size = COLLECTOR_TASK_STACK_SIZE;
+    attr.priority = COLLECTOR_TASK_PRIORITY;
+    g_task_running = true;
+    g_task = osThreadNew(CollectorTask, NULL, &attr);
+    if (g_task == NULL) {
+        g_task_running = false;
+        return InitFail(COLLECTOR_ERROR_PARAM);
+    }
+    
+    UpdateState(COLLECTOR_STATE_IDLE, COLLECTOR_ERROR_NONE);
+    return 0;
+}
+
+// 启动数据采集
+int CollectorStart(void)
+{
+    if (g_state == COLLECTOR_STATE_RUNNING) {
+        return 0;
+    }
+    
+    if (g_task == NULL) {
+        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+        return -1;
+    }
+    
+    // 通知采集任务按各传感器的相位开始调度
+    UpdateState(COLLECTOR_STATE_RUNNING, COLLECTOR_ERROR_NONE);
+    if (osThreadFlagsSet(g_task, COLLECTOR_FLAG_START) & osFlagsError) {
+        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+        return -1;
+    }
+    
+    return 0;
+}
+
+// 停止数据采集
+int CollectorStop(void)
+{
+    if (g_task == NULL) {
+        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+        return -1;
+    }
+    
+    // 采集任务在状态离开RUNNING后不再调度, 正在进行的读取会完成
+    UpdateState(COLLECTOR_STATE_IDLE, COLLECTOR_ERROR_NONE);
+    return 0;
+}
+
+// 获取采集器状态
+CollectorState CollectorGetState(void)
+{
+    return g_state;
+}
+
+// 获取采集器错误码
+CollectorError CollectorGetError(void)
+{
+    return g_error;
+}
+
+// 手动触发数据采集
+// 采集由采集任务代为执行, 保证缓存只有一个写入者
+int CollectorTrigger(SensorType type)
+{
+    if (type >= SENSOR_TYPE_MAX && type != SENSOR_TYPE_ALL) {
+        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+        return -1;
+    }
+    
+    if (g_task == NULL || g_trigger_done == NULL) {
+        return -1;
+    }
+    
+    uint32_t mask = (type == SENSOR_TYPE_ALL) ? ((1U << SENSOR_TYPE_MAX) - 1) : (1U << type);
+    
+    // 在采集任务内部(如数据回调中)调用时直接执行, 避免等待自身;
+    // 异步转换尚未完成的传感器在转换完成后采集, 不计入返回结果
+    if (osThreadGetId() == g_task) {
+        __atomic_fetch_or(&g_trigger_mask, mask, __ATOMIC_ACQ_REL);
+        RunTriggers();
+        return GetTriggerResult(mask & ~g_trigger_deferred.mask);
+    }
+    
+    // 发起请求并等待采集任务完成所有请求的传感器
+    osEventFlagsClear(g_trigger_done, mask);
+    __atomic_fetch_or(&g_trigger_mask, mask, __ATOMIC_ACQ_REL);
+    osThreadFlagsSet(g_task, COLLECTOR_FLAG_TRIGGER);
+    
+    uint32_t timeout = MsToTicks(COLLECTOR_TRIGGER_TIMEOUT);
+    uint32_t flags = osEventFlagsWait(g_trigger_done, mask, osFlagsWaitAll | osFlagsNoClear, timeout);
+    if (flags & osFlagsError) {
+        return -1;
+    }
+    
+    return GetTriggerResult(mask);
+}
+
+// 无锁读取缓存数据
+int CollectorReadCache(SensorType type, uint32_t* cursor, SensorData* data, uint32_t max_count,
+    uint32_t* actual_count)
+{
+    if (type >= SENSOR_TYPE_MAX || cursor == NULL || data == NULL || actual_count == NULL) {
+        return -1;
+    }
+    
+    uint32_t first = 0;
+    if (SampleRingRead(&g_cache[type], *cursor, data, max_count, actual_count, &first) != 0) {
+        return -1;
+    }
+    
+    *cursor = first + *actual_count;
+    return 0;
+}
+
+// 修改单个传感器的采样调度参数
+int CollectorSetSchedule(SensorType type, const SensorSchedule* schedule)
+{
+    if (type >= SENSOR_TYPE_MAX || schedule == NULL) {
+        return -1;
+    }
+    
+    if (g_config_mutex == NULL || osMutexAcquire(g_config_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    ScheduleSlot* slot = &g_schedule_pending[type];
+    uint32_t index = SeqLockWriteBegin(&slot->lock);
+    memcpy(&slot->buf[index], schedule, sizeof(SensorSchedule));
+    SeqLockWriteEnd(&slot->lock);
+    osMutexRelease(g_config_mutex);
+    
+    // 由采集任务应用新参数并重建该传感器的调度项
+    __atomic_fetch_or(&g_schedule_dirty, 1U << type, __ATOMIC_ACQ_REL);
+    if (g_task != NULL) {
+        osThreadFlagsSet(g_task, COLLECTOR_FLAG_RESCHEDULE);
+    }
+    
+    return 0;
+}
+
+// 分块读取定点压缩历史: 锁内只复制一块定点样本, 解码在锁外进行
+// 读取期间被覆盖的样本跳过, 从最旧的样本继续
+static int ReadStore(SensorType type, uint64_t since_ts, uint64_t until_ts, uint32_t latest,
+    SensorData* data, uint32_t max_count, uint32_t* actual_count)
+{
+    const SampleStore* store = &g_store[type];
+    SampleStoreChunk chunk;
+    uint32_t count = 0;
+    
+    *actual_count = 0;
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    uint32_t sequence = SampleStoreSeek(store, since_ts, latest);
+    osMutexRelease(g_store_mutex);
+    
+    while (count < max_count) {
+        if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+            return -1;
+        }
+        SampleStoreCopy(store, sequence, until_ts, &chunk);
+        osMutexRelease(g_store_mutex);
+        
+        for (uint32_t i = 0; i < chunk.count && count < max_count; i++) {
+            SampleStoreDecodeChunk(store, &chunk, i, &data[count++]);
+        }
+        *actual_count = count;
+        if (chunk.count < SAMPLE_STORE_CHUNK_SIZE) {
+            break;
+        }
+        sequence = chunk.next;
+    }
+    
+    return 0;
+}
+
+// 按时间范围查询历史数据
+int CollectorGetHistory(SensorType type, uint64_t since_ts, uint64_t until_ts,
+    SensorData* data, uint32_t max_count, uint32_t* actual_count)
+{
+    if (type >= SENSOR_TYPE_MAX || data == NULL || actual_count == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    return ReadStore(type, since_ts, until_ts, UINT32_MAX, data, max_count, actual_count);
+}
+
+// 获取全部缓存的历史数据
+int CollectorGetHistoryData(SensorType type, SensorData* data, uint32_t* count)
+{
+    if (type >= SENSOR_TYPE_MAX || data == NULL || count == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    return ReadStore(type, 0, UINT64_MAX, *count, data, *count, count);
+}
+
+// 清除历史数据
+int CollectorClearHistory(SensorType type)
+{
+    if (type >= SENSOR_TYPE_MAX || g_cache[type].slots == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    SampleRingClear(&g_cache[type]);
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    SampleStoreClear(&g_store[type]);
+    osMutexRelease(g_store_mutex);
+    return 0;
+}
+
+// 创建历史数据迭代器
+int CollectorHistoryIterInit(SensorType type, uint64_t since_ts, uint64_t until_ts,
+    CollectorHistoryIter* iter)
+{
+    if (type >= SENSOR_TYPE_MAX || iter == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    memset(iter, 0, sizeof(CollectorHistoryIter));
+    iter->type = type;
+    iter->until_ts = until_ts;
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    iter->next_seq = SampleStoreSeek(&g_store[type], since_ts, UINT32_MAX);
+    osMutexRelease(g_store_mutex);
+    iter->first_seq = iter->next_seq;
+    return 0;
+}
+
+// 获取迭代器的下一个样本
+const SensorData* CollectorHistoryIterNext(CollectorHistoryIter* iter)
+{
+    if (iter == NULL || iter->type >= SENSOR_TYPE_MAX || g_store_mutex == NULL) {
+        return NULL;
+    }
+    
+    // 当前批已取完时与分块读取一样在锁内复制下一批, 解码在锁外进行
+    if (iter->index == iter->count) {
+        const SampleStore* store = &g_store[iter->type];
+        SampleStoreChunk chunk;
+        if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+            return NULL;
+        }
+        SampleStoreCopy(store, iter->next_seq, iter->until_ts, &chunk);
+        osMutexRelease(g_store_mutex);
+        
+        uint32_t count = chunk.count < COLLECTOR_HISTORY_ITER_BATCH ? chunk.count : COLLECTOR_HISTORY_ITER_BATCH;
+        for (uint32_t i = 0; i < count; i++) {
+            SampleStoreDecodeChunk(store, &chunk, i, &iter->batch[i]);
+        }
+        iter->first_seq = chunk.next - chunk.count;
+        iter->next_seq = iter->first_seq + count;
+        iter->index = 0;
+        iter->count = count;
+        if (count == 0) {
+            return NULL;
+        }
+    }
+    
+    return &iter->batch[iter->index++];
+}
+
+// 检查最近一次返回的样本是否仍在历史中
+bool CollectorHistoryIterValid(const CollectorHistoryIter* iter)
+{
+    if (iter == NULL || iter->type >= SENSOR_TYPE_MAX || iter->index == 0 || g_store_mutex == NULL) {
+        return false;
+    }
+    
+    const SampleStore* store = &g_store[iter->type];
+    uint32_t seq = iter->first_seq + iter->index - 1;
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+        return false;
+    }
+    bool valid = (int32_t)(seq - (store->total - store->count)) >= 0 && (int32_t)(store->total - seq) > 0;
+    osMutexRelease(g_store_mutex);
+    
+    return valid;
+}
 
-// 更新状态
-static void UpdateState(CollectorState state, CollectorError error)
+// 从定点压缩历史中查询样本
+int CollectorGetCompactHistory(SensorType type, uint64_t since_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count)
 {
-    g_state = state;
-    g_error = error;
+    if (type >= SENSOR_TYPE_MAX || data == NULL || actual_count == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    return ReadStore(type, since_ts, UINT64_MAX, max_count, data, max_count, actual_count);
 }
 
-// 采集DHT11数据
-static int CollectDHT11Data(SensorData* data)
+// 扫描定点压缩历史统计通道数值
+int CollectorScanChannel(SensorChannel channel, uint64_t since_ts, ChannelSummary* summary)
 {
-    float temperature = 0.0f;
-    float humidity = 0.0f;
+    SensorType type = CollectorGetChannelSensor(channel);
+    if (type >= SENSOR_TYPE_MAX || summary == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    // 通道列表在初始化后不再变化, 无需加锁
+    const SampleStore* store = &g_store[type];
+    uint8_t column = 0;
+    while (column < store->channel_count && store->channels[column] != channel) {
+        column++;
+    }
+    if (column == store->channel_count) {
+        return -1;
+    }
     
-    if (DHT11GetData(&temperature, &humidity) != 0) {
+    // 与历史查询一样分块复制定点值, 统计在锁外进行
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+    int32_t sum = 0;
+    uint32_t count = 0;
+    SampleStoreChunk chunk;
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
         return -1;
     }
+    uint32_t sequence = SampleStoreSeek(store, since_ts, UINT32_MAX);
+    osMutexRelease(g_store_mutex);
+    do {
+        if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+            return -1;
+        }
+        SampleStoreCopy(store, sequence, UINT64_MAX, &chunk);
+        osMutexRelease(g_store_mutex);
+        
+        for (uint32_t i = 0; i < chunk.count; i++) {
+            int16_t value = chunk.values[column][i];
+            min = value < min ? value : min;
+            max = value > max ? value : max;
+            sum += value;
+        }
+        count += chunk.count;
+        sequence = chunk.next;
+    } while (chunk.count == SAMPLE_STORE_CHUNK_SIZE);
     
-    data->type = SENSOR_TYPE_DHT11;
-    data->timestamp = osKernelGetTickCount();
-    data->data.dht11.temperature = temperature;
-    data->data.dht11.humidity = humidity;
+    memset(summary, 0, sizeof(ChannelSummary));
+    summary->count = count;
+    if (count > 0) {
+        summary->min = SampleStoreDecode(channel, min);
+        summary->max = SampleStoreDecode(channel, max);
+        summary->mean = SampleStoreDecode(channel, (int16_t)(sum / (int32_t)count));
+    }
     
     return 0;
 }
 
-// 采集MQ2数据
-static int CollectMQ2Data(SensorData* data)
+// 从长期压缩归档中查询通道样本
+int CollectorGetArchive(SensorChannel channel, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count, uint32_t* actual_count)
 {
-    float smoke = 0.0f;
+    if (channel >= SENSOR_CHANNEL_MAX || samples == NULL || actual_count == NULL || g_store_mutex == NULL) {
+        return -1;
+    }
+    
+    // 锁内只复制一个压缩块, 解码在锁外进行; 复制期间被覆盖的块从最旧的块继续
+    const TsArchive* archive = &g_archive[channel];
+    TsBlock block;
+    uint32_t found = 0;
+    if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    uint32_t sequence = TsArchiveSeek(archive, since_ts);
+    osMutexRelease(g_store_mutex);
+    while (found < max_count) {
+        if (osMutexAcquire(g_store_mutex, osWaitForever) != osOK) {
+            return -1;
+        }
+        int ret = TsArchiveCopyBlock(archive, &sequence, &block);
+        osMutexRelease(g_store_mutex);
+        if (ret != 0 || (block.count > 0 && block.start_ts * CLOCK_US_PER_MS > until_ts)) {
+            break;
+        }
+        
+        found += TsBlockQuery(&block, channel, since_ts, until_ts, &samples[found], max_count - found);
+        sequence++;
+    }
     
-    if (MQ2GetData(&smoke) != 0) {
+    *actual_count = found;
+    return 0;
+}
+
+// 获取通道在线统计
+int CollectorGetStats(SensorChannel channel, ChannelStats* stats)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || stats == NULL) {
         return -1;
     }
     
-    data->type = SENSOR_TYPE_MQ2;
-    data->timestamp = osKernelGetTickCount();
-    data->data.mq2.smoke = smoke;
+    const StatsSlot* slot = &g_stats[channel];
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&slot->lock);
+        memcpy(stats, &slot->buf[seq & 1], sizeof(ChannelStats));
+    } while (!SeqLockReadValid(&slot->lock, seq));
+    
+    return 0;
+}
+
+// 重置通道在线统计
+int CollectorResetStats(SensorChannel channel)
+{
+    if (channel >= SENSOR_CHANNEL_MAX) {
+        return -1;
+    }
     
+    __atomic_fetch_or(&g_stats_reset, 1U << channel, __ATOMIC_RELEASE);
     return 0;
 }
 
-// 采集BH1750数据
-static int CollectBH1750Data(SensorData* data)
+// 设置通道滑动窗口长度
+int CollectorSetWindow(SensorChannel channel, uint32_t window_ms)
 {
-    float light = 0.0f;
+    if (channel >= SENSOR_CHANNEL_MAX || window_ms == 0) {
+        return -1;
+    }
     
-    if (BH1750GetData(&light) != 0) {
+    __atomic_store_n(&g_window_pending[channel], window_ms, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&g_window_dirty, 1U << channel, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 获取通道滑动窗口最小/最大值
+int CollectorGetWindowMinMax(SensorChannel channel, ChannelMinMax* minmax)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || minmax == NULL) {
         return -1;
     }
     
-    data->type = SENSOR_TYPE_BH1750;
-    data->timestamp = osKernelGetTickCount();
-    data->data.bh1750.light = light;
+    const WindowSlot* slot = &g_window[channel];
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&slot->lock);
+        memcpy(minmax, &slot->buf[seq & 1], sizeof(ChannelMinMax));
+    } while (!SeqLockReadValid(&slot->lock, seq));
     
     return 0;
 }
 
-// 缓存数据
-static int CacheData(const SensorData* data)
+// 设置通道滤波链
+int CollectorSetFilter(SensorChannel channel, const ChannelFilterConfig* config)
 {
-    if (data == NULL || data->type >= SENSOR_TYPE_MAX) {
+    SampleFilter check;
+    
+    if (channel >= SENSOR_CHANNEL_MAX || config == NULL || g_config_mutex == NULL) {
+        return -1;
+    }
+    if (SampleFilterInit(&check, channel, config) != 0) {
         return -1;
     }
     
-    DataCache* cache = &g_cache[data->type];
-    if (cache->data == NULL || cache->size == 0) {
+    if (osMutexAcquire(g_config_mutex, osWaitForever) != osOK) {
         return -1;
     }
+    memcpy(&g_filter_pending[channel], config, sizeof(ChannelFilterConfig));
+    __atomic_fetch_or(&g_filter_dirty, 1U << channel, __ATOMIC_RELEASE);
+    osMutexRelease(g_config_mutex);
     
-    // 写入数据
-    memcpy(&cache->data[cache->index], data, sizeof(SensorData));
+    return 0;
+}
+
+// 获取通道滤波链配置
+int CollectorGetFilter(SensorChannel channel, ChannelFilterConfig* config)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || config == NULL || g_config_mutex == NULL) {
+        return -1;
+    }
     
-    // 更新索引
-    cache->index = (cache->index + 1) % cache->size;
-    if (cache->count < cache->size) {
-        cache->count++;
+    if (osMutexAcquire(g_config_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    if (__atomic_load_n(&g_filter_dirty, __ATOMIC_ACQUIRE) & (1U << channel)) {
+        memcpy(config, &g_filter_pending[channel], sizeof(ChannelFilterConfig));
+    } else {
+        memcpy(config, &g_filter[channel].config, sizeof(ChannelFilterConfig));
     }
+    osMutexRelease(g_config_mutex);
     
-    // 更新最新数据
-    memcpy(&g_latest[data->type], data, sizeof(SensorData));
+    return 0;
+}
+
+// 设置通道校准系数
+int CollectorSetCalibration(SensorChannel channel, const ChannelCalibration* calibration)
+{
+    if (channel >= SENSOR_CHANNEL_MAX || !CalibrationIsValid(calibration) || g_config_mutex == NULL) {
+        return -1;
+    }
     
-    // 调用回调函数
-    if (g_callback != NULL) {
-        g_callback(data);
+    // 多个设置者由配置锁串行, 读取者通过版本锁获取
+    if (osMutexAcquire(g_config_mutex, osWaitForever) != osOK) {
+        return -1;
     }
+    const ChannelCalibration* current = g_calibration.buf[g_calibration.lock.seq & 1];
+    uint32_t index = SeqLockWriteBegin(&g_calibration.lock);
+    memcpy(g_calibration.buf[index], current, sizeof(g_calibration.buf[index]));
+    if (calibration->order == 0) {
+        CalibrationDefault(channel, &g_calibration.buf[index][channel]);
+    } else {
+        memcpy(&g_calibration.buf[index][channel], calibration, sizeof(ChannelCalibration));
+    }
+    SeqLockWriteEnd(&g_calibration.lock);
+    osMutexRelease(g_config_mutex);
     
     return 0;
 }
 
-// 采集数据
-static int CollectData(SensorType type)
+// 获取通道当前的校准系数
+int CollectorGetCalibration(SensorChannel channel, ChannelCalibration* calibration)
 {
-    SensorData data = {0};
-    int ret = 0;
-    
-    switch (type) {
-        case SENSOR_TYPE_DHT11:
-            ret = CollectDHT11Data(&data);
-            break;
-            
-        case SENSOR_TYPE_MQ2:
-            ret = CollectMQ2Data(&data);
-            break;
-            
-        case SENSOR_TYPE_BH1750:
-            ret = CollectBH1750Data(&data);
-            break;
-            
-        default:
-            return -1;
+    uint32_t seq;
+
+    if (channel >= SENSOR_CHANNEL_MAX || calibration == NULL) {
+        return -1;
     }
     
-    if (ret == 0) {
-        CacheData(&data);
+    do {
+        seq = SeqLockReadBegin(&g_calibration.lock);
+        memcpy(calibration, &g_calibration.buf[seq & 1][channel], sizeof(ChannelCalibration));
+    } while (!SeqLockReadValid(&g_calibration.lock, seq));
+    
+    return 0;
+}
+
+// 获取采集任务时序统计
+int CollectorGetTimingStats(CollectorTimingStats* stats)
+{
+    if (stats == NULL) {
+        return -1;
     }
     
-    return ret;
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&g_timing.lock);
+        memcpy(stats, &g_timing.buf[seq & 1], sizeof(CollectorTimingStats));
+    } while (!SeqLockReadValid(&g_timing.lock, seq));
+    
+    return 0;
 }
 
-// 定时器回调函数
-static void TimerCallback(void* arg)
+// 获取最近的采集周期记录
+int CollectorGetCycleLog(CollectorCycleRecord* records, uint32_t max_count, uint32_t* actual_count)
 {
-    (void)arg;
+    if (records == NULL || actual_count == NULL) {
+        return -1;
+    }
     
-    if (g_state != COLLECTOR_STATE_RUNNING) {
-        return;
+    uint32_t head = __atomic_load_n(&g_timing.log_head, __ATOMIC_ACQUIRE);
+    uint32_t available = head - __atomic_load_n(&g_timing.log_base, __ATOMIC_ACQUIRE);
+    if (available > COLLECTOR_CYCLE_LOG_SIZE) {
+        available = COLLECTOR_CYCLE_LOG_SIZE;
+    }
+    uint32_t count = max_count > available ? available : max_count;
+    uint32_t first = head - count;
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(&records[i], &g_timing.log[(first + i) % COLLECTOR_CYCLE_LOG_SIZE], sizeof(CollectorCycleRecord));
     }
     
-    // 采集所有传感器数据
-    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
-        if (CollectData(type) != 0) {
-            UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_SENSOR);
-            return;
-        }
+    // 丢弃复制期间可能被采集任务覆盖的最旧记录
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint32_t writing = __atomic_load_n(&g_timing.log_writing, __ATOMIC_RELAXED);
+    uint32_t stale = 0;
+    while (stale < count && writing - (first + stale) > COLLECTOR_CYCLE_LOG_SIZE) {
+        stale++;
     }
+    if (stale > 0) {
+        memmove(records, &records[stale], (count - stale) * sizeof(CollectorCycleRecord));
+    }
+    
+    *actual_count = count - stale;
+    return 0;
 }
 
-// 初始化数据采集模块
-int CollectorInit(const CollectorConfig* config)
+// 清除采集任务时序统计
+int CollectorResetTimingStats(void)
 {
-    if (config == NULL || config->collect_interval == 0 || config->cache_size == 0) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    __atomic_store_n(&g_timing_reset, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 获取最新的传感器数据
+int CollectorGetLatestData(SensorType type, SensorData* data)
+{
+    return CollectorGetLatestSnapshot(type, data, NULL);
+}
+
+// 获取最新传感器数据的一致快照及其序号
+int CollectorGetLatestSnapshot(SensorType type, SensorData* data, uint32_t* seq)
+{
+    if (data == NULL) {
         return -1;
     }
     
-    // 保存配置
-    memcpy(&g_config, config, sizeof(CollectorConfig));
-    
-    // 初始化缓存
-    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
-        g_cache[type].data = malloc(sizeof(SensorData) * config->cache_size);
-        if (g_cache[type].data == NULL) {
-            UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_MEMORY);
+    uint32_t version = 0;
+    if (type < SENSOR_TYPE_MAX) {
+        version = ReadLatest(type, data);
+    } else if (VirtualSensorIsVirtual(type)) {
+        version = ReadVirtual(type, data);
+        if (version == 0) {
             return -1;
         }
-        g_cache[type].size = config->cache_size;
-        g_cache[type].count = 0;
-        g_cache[type].index = 0;
+    } else {
+        return -1;
     }
     
-    // 创建定时器
-    osTimerAttr_t attr = {0};
-    attr.name = "CollectorTimer";
-    g_timer = osTimerNew(TimerCallback, osTimerPeriodic, NULL, &attr);
-    if (g_timer == NULL) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    if (seq != NULL) {
+        *seq = version;
+    }
+    return 0;
+}
+
+// 获取最新传感器数据的序号
+uint32_t CollectorGetLatestSeq(SensorType type)
+{
+    if (VirtualSensorIsVirtual(type)) {
+        return GetVirtualStamp(type, NULL);
+    }
+    if (type >= SENSOR_TYPE_MAX) {
+        return 0;
+    }
+    
+    return SeqLockReadBegin(&g_latest[type].lock);
+}
+
+// 获取最新的多传感器数据帧
+int CollectorGetLatestFrame(SensorFrame* frame)
+{
+    uint32_t seq;
+
+    if (frame == NULL) {
         return -1;
     }
     
-    UpdateState(COLLECTOR_STATE_IDLE, COLLECTOR_ERROR_NONE);
+    do {
+        seq = SeqLockReadBegin(&g_frame.lock);
+        memcpy(frame, &g_frame.buf[seq & 1], sizeof(SensorFrame));
+    } while (!SeqLockReadValid(&g_frame.lock, seq));
+    
+    return seq != 0 ? 0 : -1;
+}
+
+// 注册数据帧回调函数
+int CollectorRegisterFrameCallback(FrameCallback callback)
+{
+    __atomic_store_n(&g_frame_callback, callback, __ATOMIC_RELEASE);
     return 0;
 }
 
-// 启动数据采集
-int CollectorStart(void)
+// 注册数据回调函数
+int CollectorRegisterCallback(DataCallback callback)
 {
-    if (g_state == COLLECTOR_STATE_RUNNING) {
+    SubscriptionFilter filter = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK_ALL
+    };
+    
+    if (g_legacy_subscriber >= 0) {
+        CollectorUnsubscribe(g_legacy_subscriber);
+        g_legacy_subscriber = -1;
+    }
+    if (callback == NULL) {
         return 0;
     }
     
-    if (g_timer == NULL) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    g_legacy_subscriber = CollectorSubscribe(callback, &filter);
+    return g_legacy_subscriber >= 0 ? 0 : -1;
+}
+
+// 添加数据订阅
+int CollectorSubscribe(DataCallback callback, const SubscriptionFilter* filter)
+{
+    if (callback == NULL || filter == NULL || g_subscription_mutex == NULL) {
         return -1;
     }
     
-    // 启动定时器
-    if (osTimerStart(g_timer, g_config.collect_interval) != osOK) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    if (osMutexAcquire(g_subscription_mutex, osWaitForever) != osOK) {
         return -1;
     }
+    int id = SubscriptionAdd(&g_subscriptions, callback, filter,
+        filter->min_interval_ms * CLOCK_US_PER_MS);
+    osMutexRelease(g_subscription_mutex);
     
-    UpdateState(COLLECTOR_STATE_RUNNING, COLLECTOR_ERROR_NONE);
+    return id;
+}
+
+// 取消数据订阅
+int CollectorUnsubscribe(int id)
+{
+    if (g_subscription_mutex == NULL) {
+        return -1;
+    }
+    
+    if (osMutexAcquire(g_subscription_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    int ret = SubscriptionRemove(&g_subscriptions, id);
+    osMutexRelease(g_subscription_mutex);
+    
+    return ret;
+}
+
+// 获取传感器当前的采样周期
+int CollectorGetSamplePeriod(SensorType type, uint32_t* period_ms)
+{
+    if (type >= SENSOR_TYPE_MAX || period_ms == NULL) {
+        return -1;
+    }
+    
+    *period_ms = GetSamplePeriod(type);
     return 0;
 }
 
-// 停止数据采集
-int CollectorStop(void)
+// 获取传感器健康信息
+int CollectorGetSensorHealth(SensorType type, SensorHealth* health)
 {
-    if (g_timer == NULL) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    if (type >= SENSOR_TYPE_MAX || health == NULL) {
         return -1;
     }
     
-    // 停止定时器
-    if (osTimerStop(g_timer) != osOK) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    const HealthSlot* slot = &g_health[type];
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&slot->lock);
+        memcpy(health, &slot->buf[seq & 1], sizeof(SensorHealth));
+    } while (!SeqLockReadValid(&slot->lock, seq));
+    
+    return 0;
+}
+
+// 获取异步投递统计
+int CollectorGetDeliveryStats(DeliveryStats* stats)
+{
+    if (stats == NULL) {
         return -1;
     }
     
-    UpdateState(COLLECTOR_STATE_IDLE, COLLECTOR_ERROR_NONE);
+    DeliveryGetStats(stats);
     return 0;
 }
 
-// 获取采集器状态
-CollectorState CollectorGetState(void)
+// 清零异步投递统计
+int CollectorResetDeliveryStats(void)
 {
-    return g_state;
+    DeliveryResetStats();
+    return 0;
 }
 
-// 获取采集器错误码
-CollectorError CollectorGetError(void)
+// 按需读取传感器
+// 读取由采集任务代为执行, 采集任务不会等待低优先级任务持有的总线读取
+int CollectorReadSensor(SensorType type, SensorData* data)
 {
-    return g_error;
+    if (type >= SENSOR_TYPE_MAX || data == NULL) {
+        return -1;
+    }
+    
+    if (g_task == NULL || g_trigger_done == NULL) {
+        return -1;
+    }
+    
+    // 在采集任务内部(如数据回调中)调用时直接读取, 不等待异步转换
+    if (osThreadGetId() == g_task) {
+        return SensorReadShared(type, GetFreshTtl(type), data) == 0 ? 0 : -1;
+    }
+    
+    // 发起请求并等待采集任务完成, 同一传感器尚未执行的请求合并为一次读取
+    uint32_t mask = 1U << type;
+    uint32_t done = mask << COLLECTOR_READ_DONE_SHIFT;
+    osEventFlagsClear(g_trigger_done, done);
+    if (__atomic_fetch_or(&g_read_mask, mask, __ATOMIC_ACQ_REL) & mask) {
+        SensorReadCountJoined(type);
+    }
+    osThreadFlagsSet(g_task, COLLECTOR_FLAG_TRIGGER);
+    
+    uint32_t timeout = MsToTicks(COLLECTOR_TRIGGER_TIMEOUT);
+    uint32_t flags = osEventFlagsWait(g_trigger_done, done, osFlagsWaitAll | osFlagsNoClear, timeout);
+    if ((flags & osFlagsError) || g_read_result[type] != 0) {
+        return -1;
+    }
+    
+    const LatestSlot* slot = &g_read_data[type];
+    uint32_t seq;
+    do {
+        seq = SeqLockReadBegin(&slot->lock);
+        memcpy(data, &slot->buf[seq & 1], sizeof(SensorData));
+    } while (!SeqLockReadValid(&slot->lock, seq));
+    
+    return 0;
 }
 
-// 手动触发数据采集
-int CollectorTrigger(SensorType type)
+// 获取传感器读取统计
+int CollectorGetReadStats(SensorType type, SensorReadStats* stats)
 {
-    if (type >= SENSOR_TYPE_MAX) {
-        UpdateState(COLLECTOR_STATE_ERROR, COLLECTOR_ERROR_PARAM);
+    if (type >= SENSOR_TYPE_MAX || stats == NULL) {
         return -1;
     }
     
-    if (type == SENSOR_TYPE_ALL) {
-        // 采集所有传感器数据
-        for (SensorType t = SENSOR_TYPE_DHT11; t < SENSOR_TYPE_MAX; t++) {
-            if (CollectData(t) != 0) {
-                return -1;
-            }
-        }
-    } else {
-        // 采集指定传感器数据
-        if (CollectData(type) != 0) {
-            return -1;
-        }
+    SensorReadGetStats(type, stats);
+    return 0;
+}
+
+// 触发捕获
+int CollectorTriggerCapture(void)
+{
+    if (g_capture.slots == NULL || g_task == NULL || __atomic_load_n(&g_capture_ready, __ATOMIC_ACQUIRE)) {
+        return -1;
     }
     
+    // 由采集任务冻结触发前样本并切换到突发采样
+    __atomic_store_n(&g_capture_request, true, __ATOMIC_RELEASE);
+    osThreadFlagsSet(g_task, COLLECTOR_FLAG_CAPTURE);
     return 0;
 }
 
-// 获取最新的传感器数据
-int CollectorGetLatestData(SensorType type, SensorData* data)
+// 获取已完成的触发捕获
+int CollectorGetCapture(CaptureView* view)
 {
-    if (type >= SENSOR_TYPE_MAX || data == NULL) {
+    if (view == NULL || !__atomic_load_n(&g_capture_ready, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+    
+    return TriggerCaptureGet(&g_capture, view);
+}
+
+// 释放已完成的触发捕获
+int CollectorReleaseCapture(void)
+{
+    if (g_task == NULL || !__atomic_load_n(&g_capture_ready, __ATOMIC_ACQUIRE)) {
         return -1;
     }
     
-    memcpy(data, &g_latest[type], sizeof(SensorData));
+    __atomic_store_n(&g_capture_release, true, __ATOMIC_RELEASE);
+    osThreadFlagsSet(g_task, COLLECTOR_FLAG_CAPTURE);
     return 0;
 }
 
-// 注册数据回调函数
-int CollectorRegisterCallback(DataCallback callback)
+// 注册触发捕获完成回调函数
+int CollectorRegisterCaptureCallback(CaptureCallback callback)
 {
-    g_callback = callback;
+    __atomic_store_n(&g_capture_callback, callback, __ATOMIC_RELEASE);
     return 0;
 }
 
+// 捕获写入持久化日志后释放, 在日志写入任务中调用
+static void ReleaseLoggedCapture(void)
+{
+    CollectorReleaseCapture();
+}
+
+// 把已完成的触发捕获写入持久化日志
+int CollectorLogCapture(void)
+{
+    CaptureView view;
+    if (g_config.flash_log == NULL || CollectorGetCapture(&view) != 0) {
+        return -1;
+    }
+    
+    return LogWriterPostCapture(&view, ReleaseLoggedCapture);
+}
+
+// 从持久化日志读取记录
+int CollectorReadLog(FlashLogCursor* cursor, FlashLogEntry* entries, uint32_t max_count,
+    uint32_t* actual_count)
+{
+    if (cursor == NULL || entries == NULL || actual_count == NULL || g_config.flash_log == NULL) {
+        return -1;
+    }
+    
+    return LogWriterRead(cursor, entries, max_count, actual_count);
+}
+
+// 把持久化日志页缓冲写入闪存
+int CollectorFlushLog(void)
+{
+    if (g_config.flash_log == NULL) {
+        return -1;
+    }
+    
+    return LogWriterFlush();
+}
+
 // 反初始化数据采集模块
 int CollectorDeinit(void)
 {
     // 停止采集
     CollectorStop();
     
-    // 删除定时器
-    if (g_timer != NULL) {
-        osTimerDelete(g_timer);
-        g_timer = NULL;
-    }
-    
-    // 释放缓存
-    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
-        if (g_cache[type].data != NULL) {
-            free(g_cache[type].data);
-            g_cache[type].data = NULL;
+    // 退出采集任务, 等待正在进行的读取完成
+    if (g_task != NULL) {
+        g_task_running = false;
+        osThreadFlagsSet(g_task, COLLECTOR_FLAG_EXIT);
+        for (uint32_t i = 0; i < COLLECTOR_TASK_EXIT_WAIT && g_task != NULL; i++) {
+            osDelay(1);
+        }
+        if (g_task != NULL) {
+            osThreadTerminate(g_task);
+            g_task = NULL;
         }
     }
     
+    // 释放各模块资源, 写入持久化日志中尚未写入闪存的记录
+    ReleaseResources();
+    
     UpdateState(COLLECTOR_STATE_IDLE, COLLECTOR_ERROR_NONE);
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "data/data_delivery.h"
+#include <string.h>
+#include "cmsis_os2.h"
+#include "common/seqlock.h"
+
+// 投递任务参数
+#define DELIVERY_TASK_STACK_SIZE    4096
+#define DELIVERY_TASK_PRIORITY      osPriorityNormal
+#define DELIVERY_TASK_EXIT_WAIT     100     // 等待投递任务退出的最长时间(tick)
+#define DELIVERY_QUEUE_SIZE         16      // 默认队列长度
+
+// 合并模式下每种传感器的待投递样本, 双缓冲版本锁保护
+typedef struct {
+    SeqLock lock;        // 版本锁
+    SensorData buf[2];   // 双缓冲
+} CoalesceSlot;
+
+// 全局变量
+static DeliveryConfig g_delivery_config = {0};
+static DataCallback g_deliver = NULL;
+static osMessageQueueId_t g_queue = NULL;
+static osThreadId_t g_delivery_task = NULL;
+static volatile bool g_delivery_running = false;
+static DeliveryStats g_delivery_stats = {0};
+static CoalesceSlot g_coalesce[SENSOR_TYPE_MAX] = {0};
+static uint32_t g_coalesce_pending = 0;
+static uint32_t g_coalesce_seq[SENSOR_TYPE_MAX] = {0};
+
+// 记录入队后的队列深度
+static void RecordEnqueue(void)
+{
+    uint32_t depth = osMessageQueueGetCount(g_queue);
+
+    g_delivery_stats.enqueued++;
+    if (depth > g_delivery_stats.max_depth) {
+        g_delivery_stats.max_depth = depth;
+    }
+}
+
+// 合并模式入队: 只有该类型没有待投递样本时才入队, 否则覆盖待投递样本
+static void PostCoalesce(const SensorData* data)
+{
+    CoalesceSlot* slot = &g_coalesce[data->type];
+    uint32_t mask = 1U << data->type;
+
+    uint32_t index = SeqLockWriteBegin(&slot->lock);
+    memcpy(&slot->buf[index], data, sizeof(SensorData));
+    SeqLockWriteEnd(&slot->lock);
+
+    if (__atomic_fetch_or(&g_coalesce_pending, mask, __ATOMIC_ACQ_REL) & mask) {
+        g_delivery_stats.coalesced++;
+        return;
+    }
+
+    // 队列中每种传感器最多一条消息, 正常情况下不会满
+    if (osMessageQueuePut(g_queue, data, 0, 0) != osOK) {
+        __atomic_fetch_and(&g_coalesce_pending, ~mask, __ATOMIC_RELEASE);
+        g_delivery_stats.dropped++;
+        return;
+    }
+    RecordEnqueue();
+}
+
+// 丢弃策略入队
+static void PostDrop(const SensorData* data)
+{
+    if (osMessageQueuePut(g_queue, data, 0, 0) == osOK) {
+        RecordEnqueue();
+        return;
+    }
+
+    g_delivery_stats.dropped++;
+    if (g_delivery_config.policy == DELIVERY_DROP_NEWEST) {
+        return;
+    }
+
+    // 丢弃最旧的样本后重试, 投递任务可能同时取走消息, 取不到也无妨
+    SensorData oldest;
+    osMessageQueueGet(g_queue, &oldest, NULL, 0);
+    if (osMessageQueuePut(g_queue, data, 0, 0) == osOK) {
+        RecordEnqueue();
+    }
+}
+
+// 取出合并模式下的待投递样本, 已投递过的版本返回false
+static bool TakeCoalesced(SensorType type, SensorData* data)
+{
+    const CoalesceSlot* slot = &g_coalesce[type];
+    uint32_t seq;
+
+    // 先清除待投递标志再复制, 复制期间到达的新样本会重新入队, 不会丢失
+    __atomic_fetch_and(&g_coalesce_pending, ~(1U << type), __ATOMIC_ACQ_REL);
+    do {
+        seq = SeqLockReadBegin(&slot->lock);
+        memcpy(data, &slot->buf[seq & 1], sizeof(SensorData));
+    } while (!SeqLockReadValid(&slot->lock, seq));
+
+    if (seq == g_coalesce_seq[type]) {
+        return false;
+    }
+    g_coalesce_seq[type] = seq;
+    return true;
+}
+
+// 投递任务
+static void DeliveryTask(void* arg)
+{
+    SensorData data;
+
+    (void)arg;
+
+    while (g_delivery_running) {
+        if (osMessageQueueGet(g_queue, &data, NULL, osWaitForever) != osOK) {
+            continue;
+        }
+        if (!g_delivery_running || data.type >= SENSOR_TYPE_MAX) {
+            break;
+        }
+
+        if (g_delivery_config.policy == DELIVERY_COALESCE && !TakeCoalesced(data.type, &data)) {
+            continue;
+        }
+
+        g_deliver(&data);
+        g_delivery_stats.delivered++;
+    }
+
+    g_delivery_task = NULL;
+    osThreadExit();
+}
+
+// 初始化回调投递
+int DeliveryInit(const DeliveryConfig* config, DataCallback deliver)
+{
+    if (config == NULL || deliver == NULL) {
+        return -1;
+    }
+
+    memcpy(&g_delivery_config, config, sizeof(DeliveryConfig));
+    memset(&g_delivery_stats, 0, sizeof(DeliveryStats));
+    memset(g_coalesce, 0, sizeof(g_coalesce));
+    memset(g_coalesce_seq, 0, sizeof(g_coalesce_seq));
+    g_coalesce_pending = 0;
+    g_deliver = deliver;
+
+    if (config->mode == DELIVERY_MODE_SYNC) {
+        return 0;
+    }
+
+    // 合并模式下队列中每种传感器最多一条消息, 另留一条给退出消息
+    uint32_t queue_size = config->queue_size != 0 ? config->queue_size : DELIVERY_QUEUE_SIZE;
+    if (config->policy == DELIVERY_COALESCE) {
+        queue_size = SENSOR_TYPE_MAX + 1;
+    }
+    g_queue = osMessageQueueNew(queue_size, sizeof(SensorData), NULL);
+    if (g_queue == NULL) {
+        return -1;
+    }
+
+    osThreadAttr_t attr = {0};
+    attr.name = "DeliveryTask";
+    attr.stack_size = DELIVERY_TASK_STACK_SIZE;
+    attr.priority = DELIVERY_TASK_PRIORITY;
+    g_delivery_running = true;
+    g_delivery_task = osThreadNew(DeliveryTask, NULL, &attr);
+    if (g_delivery_task == NULL) {
+        g_delivery_running = false;
+        osMessageQueueDelete(g_queue);
+        g_queue = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+// 投递一个样本
+void DeliveryPost(const SensorData* data)
+{
+    if (data == NULL || data->type >= SENSOR_TYPE_MAX || g_deliver == NULL) {
+        return;
+    }
+
+    if (g_delivery_config.mode == DELIVERY_MODE_SYNC || g_queue == NULL) {
+        g_deliver(data);
+        g_delivery_stats.delivered++;
+        return;
+    }
+
+    if (g_delivery_config.policy == DELIVERY_COALESCE) {
+        PostCoalesce(data);
+    } else {
+        PostDrop(data);
+    }
+}
+
+// 获取投递统计
+void DeliveryGetStats(DeliveryStats* stats)
+{
+    memcpy(stats, &g_delivery_stats, sizeof(DeliveryStats));
+}
+
+// 清零投递统计
+void DeliveryResetStats(void)
+{
+    memset(&g_delivery_stats, 0, sizeof(DeliveryStats));
+}
+
+// 退出投递任务并释放队列
+void DeliveryDeinit(void)
+{
+    if (g_delivery_task != NULL) {
+        SensorData exit_msg = {0};
+        exit_msg.type = SENSOR_TYPE_MAX;
+
+        // 队列满时腾出一个位置给退出消息
+        g_delivery_running = false;
+        if (osMessageQueuePut(g_queue, &exit_msg, 0, 0) != osOK) {
+            SensorData discard;
+            osMessageQueueGet(g_queue, &discard, NULL, 0);
+            osMessageQueuePut(g_queue, &exit_msg, 0, 0);
+        }
+        for (uint32_t i = 0; i < DELIVERY_TASK_EXIT_WAIT && g_delivery_task != NULL; i++) {
+            osDelay(1);
+        }
+        if (g_delivery_task != NULL) {
+            osThreadTerminate(g_delivery_task);
+            g_delivery_task = NULL;
+        }
+    }
+
+    if (g_queue != NULL) {
+        osMessageQueueDelete(g_queue);
+        g_queue = NULL;
+    }
+    g_deliver = NULL;
+}
@@ -0,0 +1,57 @@
+#include "data/flash_backend.h"
+#include <string.h>
+#include "hi_flash.h"
+#include "hi_partition_table.h"
+
+// 日志分区起始地址
+static uint32_t g_flash_base = 0;
+
+static int HiFlashRead(void* ctx, uint32_t addr, void* buf, uint32_t len)
+{
+    (void)ctx;
+    return hi_flash_read(g_flash_base + addr, len, (hi_u8*)buf) == HI_ERR_SUCCESS ? 0 : -1;
+}
+
+static int HiFlashWrite(void* ctx, uint32_t addr, const void* buf, uint32_t len)
+{
+    (void)ctx;
+    // 目标区域已擦除, 不需要驱动先擦除
+    return hi_flash_write(g_flash_base + addr, len, (const hi_u8*)buf, HI_FALSE) == HI_ERR_SUCCESS ? 0 : -1;
+}
+
+static int HiFlashErase(void* ctx, uint32_t addr)
+{
+    (void)ctx;
+    addr -= addr % FLASH_BACKEND_HI_SECTOR_SIZE;
+    return hi_flash_erase(g_flash_base + addr, FLASH_BACKEND_HI_SECTOR_SIZE) == HI_ERR_SUCCESS ? 0 : -1;
+}
+
+// 初始化片上闪存后端
+int FlashBackendHiInit(FlashBackend* backend)
+{
+    if (backend == NULL) {
+        return -1;
+    }
+
+    // 日志分区取SDK分区表中的用户预留分区, 不与文件系统、HiLink及崩溃信息等分区重叠
+    const hi_flash_partition_table* table = hi_get_partition_table();
+    if (table == NULL) {
+        return -1;
+    }
+    const hi_flash_partition_info* info = &table->table[HI_FLASH_PARTITON_USR_RESERVE];
+    uint32_t base = info->addr;
+    uint32_t sector_count = info->size / FLASH_BACKEND_HI_SECTOR_SIZE;
+    if (base % FLASH_BACKEND_HI_SECTOR_SIZE != 0 || sector_count < 2) {
+        return -1;
+    }
+
+    g_flash_base = base;
+    memset(backend, 0, sizeof(FlashBackend));
+    backend->sector_size = FLASH_BACKEND_HI_SECTOR_SIZE;
+    backend->sector_count = sector_count;
+    backend->page_size = FLASH_BACKEND_HI_PAGE_SIZE;
+    backend->read = HiFlashRead;
+    backend->write = HiFlashWrite;
+    backend->erase = HiFlashErase;
+    return 0;
+}
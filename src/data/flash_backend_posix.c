@@ -0,0 +1,118 @@
+#include "data/flash_backend.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 映射文件
+typedef struct {
+    int fd;
+    uint8_t* map;
+    uint32_t size;
+    uint32_t sector_size;
+} PosixFlash;
+
+static int PosixFlashRead(void* ctx, uint32_t addr, void* buf, uint32_t len)
+{
+    PosixFlash* flash = ctx;
+
+    if (addr > flash->size || len > flash->size - addr) {
+        return -1;
+    }
+    memcpy(buf, flash->map + addr, len);
+    return 0;
+}
+
+// 与NOR闪存一致, 写入只能把1改为0
+static int PosixFlashWrite(void* ctx, uint32_t addr, const void* buf, uint32_t len)
+{
+    PosixFlash* flash = ctx;
+    const uint8_t* src = buf;
+
+    if (addr > flash->size || len > flash->size - addr) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        flash->map[addr + i] &= src[i];
+    }
+    return 0;
+}
+
+static int PosixFlashErase(void* ctx, uint32_t addr)
+{
+    PosixFlash* flash = ctx;
+
+    if (addr >= flash->size) {
+        return -1;
+    }
+    addr -= addr % flash->sector_size;
+    memset(flash->map + addr, 0xFF, flash->sector_size);
+    return 0;
+}
+
+// 打开主机文件后端
+int FlashBackendPosixOpen(FlashBackend* backend, const char* path, uint32_t sector_size,
+    uint32_t sector_count, uint32_t page_size)
+{
+    if (backend == NULL || path == NULL || sector_size == 0 || sector_count == 0) {
+        return -1;
+    }
+
+    PosixFlash* flash = malloc(sizeof(PosixFlash));
+    if (flash == NULL) {
+        return -1;
+    }
+    flash->size = sector_size * sector_count;
+    flash->sector_size = sector_size;
+    flash->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (flash->fd < 0) {
+        free(flash);
+        return -1;
+    }
+
+    // 新建或长度不符的文件按擦除状态初始化
+    struct stat st;
+    bool blank = fstat(flash->fd, &st) != 0 || (uint32_t)st.st_size != flash->size;
+    if (blank && ftruncate(flash->fd, flash->size) != 0) {
+        close(flash->fd);
+        free(flash);
+        return -1;
+    }
+
+    flash->map = mmap(NULL, flash->size, PROT_READ | PROT_WRITE, MAP_SHARED, flash->fd, 0);
+    if (flash->map == MAP_FAILED) {
+        close(flash->fd);
+        free(flash);
+        return -1;
+    }
+    if (blank) {
+        memset(flash->map, 0xFF, flash->size);
+    }
+
+    memset(backend, 0, sizeof(FlashBackend));
+    backend->sector_size = sector_size;
+    backend->sector_count = sector_count;
+    backend->page_size = page_size;
+    backend->read = PosixFlashRead;
+    backend->write = PosixFlashWrite;
+    backend->erase = PosixFlashErase;
+    backend->ctx = flash;
+    return 0;
+}
+
+// 关闭主机文件后端
+void FlashBackendPosixClose(FlashBackend* backend)
+{
+    if (backend == NULL || backend->ctx == NULL) {
+        return;
+    }
+
+    PosixFlash* flash = backend->ctx;
+    msync(flash->map, flash->size, MS_SYNC);
+    munmap(flash->map, flash->size);
+    close(flash->fd);
+    free(flash);
+    backend->ctx = NULL;
+}
@@ -0,0 +1,584 @@
+#include "data/flash_log.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 扇区头魔数("SLOG")及记录魔数
+#define FLASH_LOG_HEADER_MAGIC 0x534C4F47U
+#define FLASH_LOG_RECORD_MAGIC 0xA5
+
+// 擦除后的字节值
+#define FLASH_ERASED_BYTE      0xFF
+
+// 检查扇区是否已擦除时每次读取的字节数
+#define FLASH_CHECK_CHUNK      64
+
+// 扇区头, 与扇区的第一批记录一起写入
+typedef struct {
+    uint32_t magic;        // 扇区头魔数
+    uint32_t seq;          // 扇区启用顺序号
+    uint32_t erase_count;  // 擦除次数
+    uint16_t boot;         // 启动序号
+    uint16_t crc;          // 前面各字段的CRC16
+} LogHeader;
+
+// 记录, 未写入的槽位全为0xFF
+typedef struct {
+    uint8_t magic;          // 记录魔数
+    uint8_t type;           // 传感器类型
+    uint16_t crc;           // type及crc之后各字段的CRC16
+    uint16_t boot;          // 启动序号
+    uint16_t flags;         // 记录标志
+    uint64_t timestamp;     // 时间戳(us)
+    SensorDataUnion data;   // 传感器数据
+} LogRecord;
+
+// CRC16-CCITT
+static uint16_t Crc16(uint16_t crc, const uint8_t* data, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t HeaderCrc(const LogHeader* header)
+{
+    return Crc16(0xFFFF, (const uint8_t*)header, offsetof(LogHeader, crc));
+}
+
+static uint16_t RecordCrc(const LogRecord* record)
+{
+    uint16_t crc = Crc16(0xFFFF, &record->type, 1);
+    return Crc16(crc, (const uint8_t*)&record->boot, sizeof(LogRecord) - offsetof(LogRecord, boot));
+}
+
+// 扇区起始地址
+static uint32_t SectorAddr(const FlashLog* log, uint32_t sector)
+{
+    return sector * log->backend->sector_size;
+}
+
+// 记录槽地址
+static uint32_t SlotAddr(const FlashLog* log, uint32_t sector, uint32_t slot)
+{
+    return SectorAddr(log, sector) + FLASH_LOG_HEADER_SIZE + slot * FLASH_LOG_RECORD_SIZE;
+}
+
+// 读取闪存内容, 页缓冲中尚未写入的部分以缓冲为准
+static int ReadBytes(const FlashLog* log, uint32_t addr, void* buf, uint32_t len)
+{
+    const FlashBackend* backend = log->backend;
+
+    if (backend->read(backend->ctx, addr, buf, len) != 0) {
+        return -1;
+    }
+
+    uint32_t start = log->page_addr + log->page_written;
+    uint32_t end = log->page_addr + log->page_fill;
+    uint32_t lo = addr > start ? addr : start;
+    uint32_t hi = addr + len < end ? addr + len : end;
+    if (lo < hi) {
+        memcpy((uint8_t*)buf + (lo - addr), log->page + (lo - log->page_addr), hi - lo);
+    }
+    return 0;
+}
+
+// 把页缓冲中尚未写入的部分写入闪存
+static int ProgramPage(FlashLog* log)
+{
+    const FlashBackend* backend = log->backend;
+
+    if (log->page_fill <= log->page_written) {
+        return 0;
+    }
+
+    int ret = backend->write(backend->ctx, log->page_addr + log->page_written,
+        log->page + log->page_written, log->page_fill - log->page_written);
+    // 写入失败也不重试, 残缺的记录读取时由CRC剔除
+    log->page_written = log->page_fill;
+    if (ret != 0) {
+        log->stats.write_errors++;
+        return -1;
+    }
+
+    log->stats.page_writes++;
+    return 0;
+}
+
+// 把addr所在的页载入页缓冲, 从addr开始继续写入
+static int LoadPage(FlashLog* log, uint32_t addr, bool erased)
+{
+    const FlashBackend* backend = log->backend;
+    uint32_t offset = addr % backend->page_size;
+
+    log->page_addr = addr - offset;
+    log->page_fill = offset;
+    log->page_written = offset;
+    memset(log->page, FLASH_ERASED_BYTE, backend->page_size);
+    if (erased || offset == 0) {
+        return 0;
+    }
+    return backend->read(backend->ctx, log->page_addr, log->page, offset);
+}
+
+// 顺序写入页缓冲, 凑满一页时写入闪存并切换到下一页
+static int WriteBytes(FlashLog* log, const void* data, uint32_t len)
+{
+    uint32_t page_size = log->backend->page_size;
+    const uint8_t* src = data;
+    int ret = 0;
+
+    while (len > 0) {
+        uint32_t n = page_size - log->page_fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(log->page + log->page_fill, src, n);
+        log->page_fill += n;
+        src += n;
+        len -= n;
+
+        if (log->page_fill == page_size) {
+            ret |= ProgramPage(log);
+            log->page_addr += page_size;
+            log->page_fill = 0;
+            log->page_written = 0;
+            memset(log->page, FLASH_ERASED_BYTE, page_size);
+        }
+    }
+
+    return ret;
+}
+
+// 已知的最大擦除次数
+static uint32_t MaxEraseCount(const FlashLog* log)
+{
+    uint32_t max = 0;
+
+    for (uint32_t i = 0; i < log->backend->sector_count; i++) {
+        if (log->sectors[i].erase_count > max) {
+            max = log->sectors[i].erase_count;
+        }
+    }
+    return max;
+}
+
+// 按环形顺序获取下一个扇区, 跳过不属于日志的扇区, 没有可用扇区时返回-1
+static int NextSector(const FlashLog* log)
+{
+    uint32_t count = log->backend->sector_count;
+    uint32_t next = log->has_active ? (log->active + 1) % count : 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!log->sectors[next].foreign) {
+            return (int)next;
+        }
+        next = (next + 1) % count;
+    }
+    return -1;
+}
+
+// 擦除扇区, 扇区中的记录不再可读
+static int EraseSector(FlashLog* log, uint32_t sector)
+{
+    const FlashBackend* backend = log->backend;
+    FlashSectorInfo* info = &log->sectors[sector];
+
+    info->valid = false;
+    if (backend->erase(backend->ctx, SectorAddr(log, sector)) != 0) {
+        log->stats.write_errors++;
+        return -1;
+    }
+    log->stats.erases++;
+    info->erase_count++;
+    return 0;
+}
+
+// 按环形顺序擦除并启用下一个扇区, 每个扇区轮流擦除, 磨损均匀
+static int OpenNextSector(FlashLog* log)
+{
+    int sector = NextSector(log);
+    if (sector < 0) {
+        return -1;
+    }
+    uint32_t next = (uint32_t)sector;
+    FlashSectorInfo* info = &log->sectors[next];
+
+    // 写入上一扇区剩余的数据
+    ProgramPage(log);
+
+    // 下一个扇区已由FlashLogPrepare提前擦除时不再等待擦除
+    bool prepared = log->prepared;
+    log->prepared = false;
+    if (!prepared && EraseSector(log, next) != 0) {
+        return -1;
+    }
+
+    info->valid = true;
+    info->seq = log->next_seq++;
+    info->boot = log->boot;
+    log->active = next;
+    log->has_active = true;
+    log->write_slot = 0;
+    LoadPage(log, SectorAddr(log, next), true);
+
+    LogHeader header = {
+        .magic = FLASH_LOG_HEADER_MAGIC,
+        .seq = info->seq,
+        .erase_count = info->erase_count,
+        .boot = info->boot,
+        .crc = 0
+    };
+    header.crc = HeaderCrc(&header);
+    return WriteBytes(log, &header, sizeof(header));
+}
+
+// 槽位是否未写入
+static bool IsSlotErased(const FlashLog* log, uint32_t sector, uint32_t slot)
+{
+    uint8_t buf[FLASH_LOG_RECORD_SIZE];
+
+    if (ReadBytes(log, SlotAddr(log, sector, slot), buf, sizeof(buf)) != 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < sizeof(buf); i++) {
+        if (buf[i] != FLASH_ERASED_BYTE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 查找扇区内第一个空闲槽位: 记录按顺序写入, 按魔数二分查找,
+// 再跳过掉电时只写了一部分的槽位
+static uint32_t FindFreeSlot(const FlashLog* log, uint32_t sector)
+{
+    uint32_t lo = 0;
+    uint32_t hi = log->slots;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint8_t magic = FLASH_ERASED_BYTE;
+        ReadBytes(log, SlotAddr(log, sector, mid), &magic, 1);
+        if (magic != FLASH_ERASED_BYTE) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    while (lo < log->slots && !IsSlotErased(log, sector, lo)) {
+        lo++;
+    }
+    return lo;
+}
+
+// 读取并校验一条记录
+static bool ReadRecord(const FlashLog* log, uint32_t sector, uint32_t slot, LogRecord* record)
+{
+    if (ReadBytes(log, SlotAddr(log, sector, slot), record, sizeof(LogRecord)) != 0) {
+        memset(record, FLASH_ERASED_BYTE, sizeof(LogRecord));
+        return false;
+    }
+    return record->magic == FLASH_LOG_RECORD_MAGIC && record->type < SENSOR_TYPE_MAX &&
+        record->crc == RecordCrc(record);
+}
+
+// 扇区是否全部为擦除状态
+static bool IsSectorErased(const FlashLog* log, uint32_t sector)
+{
+    const FlashBackend* backend = log->backend;
+    uint8_t buf[FLASH_CHECK_CHUNK];
+
+    for (uint32_t offset = 0; offset < backend->sector_size; offset += sizeof(buf)) {
+        uint32_t len = backend->sector_size - offset < sizeof(buf) ? backend->sector_size - offset : sizeof(buf);
+        if (backend->read(backend->ctx, SectorAddr(log, sector) + offset, buf, len) != 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            if (buf[i] != FLASH_ERASED_BYTE) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 扇区头无效的扇区能否作为日志扇区重用
+static bool IsSectorReusable(const FlashLog* log, uint32_t sector)
+{
+    LogRecord record;
+
+    // 掉电时正在启用的扇区, 扇区头及第一批记录可能只写了一部分
+    if (log->has_active && sector == (log->active + 1) % log->backend->sector_count) {
+        return true;
+    }
+    // 扇区头损坏的日志扇区, 记录仍可识别
+    if (ReadRecord(log, sector, 0, &record)) {
+        return true;
+    }
+    return IsSectorErased(log, sector);
+}
+
+// 打开日志
+int FlashLogOpen(FlashLog* log, const FlashBackend* backend)
+{
+    if (log == NULL || backend == NULL || backend->read == NULL || backend->write == NULL ||
+        backend->erase == NULL || backend->sector_count < 2 || backend->page_size == 0 ||
+        backend->sector_size % backend->page_size != 0 ||
+        backend->sector_size < FLASH_LOG_HEADER_SIZE + FLASH_LOG_RECORD_SIZE) {
+        return -1;
+    }
+
+    memset(log, 0, sizeof(FlashLog));
+    log->backend = backend;
+    log->slots = (backend->sector_size - FLASH_LOG_HEADER_SIZE) / FLASH_LOG_RECORD_SIZE;
+    log->sectors = malloc(sizeof(FlashSectorInfo) * backend->sector_count);
+    log->page = malloc(backend->page_size);
+    if (log->sectors == NULL || log->page == NULL) {
+        FlashLogClose(log);
+        return -1;
+    }
+    memset(log->sectors, 0, sizeof(FlashSectorInfo) * backend->sector_count);
+    memset(log->page, FLASH_ERASED_BYTE, backend->page_size);
+
+    // 只读取各扇区头, 顺序号最大的扇区为当前写入扇区
+    for (uint32_t i = 0; i < backend->sector_count; i++) {
+        LogHeader header;
+        if (backend->read(backend->ctx, SectorAddr(log, i), &header, sizeof(header)) != 0) {
+            continue;
+        }
+        if (header.magic != FLASH_LOG_HEADER_MAGIC || header.crc != HeaderCrc(&header)) {
+            continue;
+        }
+
+        FlashSectorInfo* info = &log->sectors[i];
+        info->valid = true;
+        info->seq = header.seq;
+        info->erase_count = header.erase_count;
+        info->boot = header.boot;
+        if (!log->has_active || header.seq > log->sectors[log->active].seq) {
+            log->active = i;
+            log->has_active = true;
+        }
+    }
+
+    // 扇区头无效的扇区擦除次数未知, 按已知的最大值估计; 既未擦除也不属于日志的扇区
+    // 可能是分区配置错误时其他模块的数据, 不擦除
+    uint32_t max_erase = MaxEraseCount(log);
+    for (uint32_t i = 0; i < backend->sector_count; i++) {
+        if (!log->sectors[i].valid) {
+            log->sectors[i].erase_count = max_erase;
+            log->sectors[i].foreign = !IsSectorReusable(log, i);
+            log->stats.foreign_sectors += log->sectors[i].foreign;
+        }
+    }
+
+    if (!log->has_active) {
+        log->next_seq = 1;
+        return 0;
+    }
+
+    const FlashSectorInfo* active = &log->sectors[log->active];
+    log->next_seq = active->seq + 1;
+    log->write_slot = FindFreeSlot(log, log->active);
+
+    // 启动序号取当前扇区最后一条有效记录的启动序号加1
+    uint16_t boot = active->boot;
+    for (uint32_t slot = log->write_slot; slot > 0; slot--) {
+        LogRecord record;
+        if (ReadRecord(log, log->active, slot - 1, &record)) {
+            boot = record.boot;
+            break;
+        }
+    }
+    log->boot = (uint16_t)(boot + 1);
+
+    if (log->write_slot < log->slots &&
+        LoadPage(log, SlotAddr(log, log->active, log->write_slot), false) != 0) {
+        FlashLogClose(log);
+        return -1;
+    }
+
+    return 0;
+}
+
+// 追加一条记录
+int FlashLogAppend(FlashLog* log, const SensorData* data)
+{
+    return FlashLogAppendFlags(log, data, 0);
+}
+
+// 追加一条带标志的记录
+int FlashLogAppendFlags(FlashLog* log, const SensorData* data, uint16_t flags)
+{
+    if (log == NULL || log->page == NULL || data == NULL || data->type >= SENSOR_TYPE_MAX) {
+        return -1;
+    }
+
+    if (!log->has_active || log->write_slot >= log->slots) {
+        if (OpenNextSector(log) != 0) {
+            return -1;
+        }
+    }
+
+    LogRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = FLASH_LOG_RECORD_MAGIC;
+    record.type = (uint8_t)data->type;
+    record.boot = log->boot;
+    record.flags = flags;
+    record.timestamp = data->timestamp;
+    memcpy(&record.data, &data->data, sizeof(SensorDataUnion));
+    record.crc = RecordCrc(&record);
+
+    log->write_slot++;
+    log->stats.appended++;
+    return WriteBytes(log, &record, sizeof(record));
+}
+
+// 提前擦除下一个扇区
+int FlashLogPrepare(FlashLog* log)
+{
+    if (log == NULL || log->page == NULL) {
+        return -1;
+    }
+
+    if (log->prepared || (log->has_active && log->slots - log->write_slot > log->slots / 4)) {
+        return 0;
+    }
+
+    int next = NextSector(log);
+    if (next < 0 || EraseSector(log, (uint32_t)next) != 0) {
+        return -1;
+    }
+    log->prepared = true;
+    return 0;
+}
+
+// 把页缓冲写入闪存
+int FlashLogFlush(FlashLog* log)
+{
+    if (log == NULL || log->page == NULL) {
+        return -1;
+    }
+
+    return ProgramPage(log);
+}
+
+// 查找顺序号不小于seq的最旧扇区
+static int FindSector(const FlashLog* log, uint32_t seq)
+{
+    int found = -1;
+
+    for (uint32_t i = 0; i < log->backend->sector_count; i++) {
+        const FlashSectorInfo* info = &log->sectors[i];
+        if (info->valid && info->seq >= seq && (found < 0 || info->seq < log->sectors[found].seq)) {
+            found = (int)i;
+        }
+    }
+    return found;
+}
+
+// 从游标位置起读取记录
+int FlashLogRead(FlashLog* log, FlashLogCursor* cursor, FlashLogEntry* entries,
+    uint32_t max_count, uint32_t* actual_count)
+{
+    if (log == NULL || log->page == NULL || cursor == NULL || entries == NULL || actual_count == NULL) {
+        return -1;
+    }
+
+    uint32_t found = 0;
+    while (found < max_count) {
+        int sector = FindSector(log, cursor->seq);
+        if (sector < 0) {
+            break;
+        }
+
+        // 游标所在扇区已被覆盖, 从仍保留的最旧扇区继续
+        if (log->sectors[sector].seq != cursor->seq) {
+            cursor->seq = log->sectors[sector].seq;
+            cursor->slot = 0;
+        }
+
+        bool is_active = (uint32_t)sector == log->active;
+        uint32_t limit = is_active ? log->write_slot : log->slots;
+        while (found < max_count && cursor->slot < limit) {
+            LogRecord record;
+            if (ReadRecord(log, (uint32_t)sector, cursor->slot++, &record)) {
+                entries[found].boot = record.boot;
+                entries[found].flags = record.flags;
+                entries[found].data.type = (SensorType)record.type;
+                entries[found].data.timestamp = record.timestamp;
+                memcpy(&entries[found].data.data, &record.data, sizeof(SensorDataUnion));
+                found++;
+            } else if (record.magic != FLASH_ERASED_BYTE) {
+                log->stats.crc_errors++;
+            }
+        }
+
+        // 读到当前写入位置时游标停在原处, 之后追加的记录下次继续读取
+        if (cursor->slot < limit || is_active) {
+            break;
+        }
+        cursor->seq++;
+        cursor->slot = 0;
+    }
+
+    *actual_count = found;
+    return 0;
+}
+
+// 获取统计信息
+int FlashLogGetStats(const FlashLog* log, FlashLogStats* stats)
+{
+    if (log == NULL || log->sectors == NULL || stats == NULL) {
+        return -1;
+    }
+
+    memcpy(stats, &log->stats, sizeof(FlashLogStats));
+    stats->min_erase_count = 0;
+    stats->max_erase_count = 0;
+    bool first = true;
+    for (uint32_t i = 0; i < log->backend->sector_count; i++) {
+        const FlashSectorInfo* info = &log->sectors[i];
+        if (!info->valid) {
+            continue;
+        }
+        if (first || info->erase_count < stats->min_erase_count) {
+            stats->min_erase_count = info->erase_count;
+        }
+        if (first || info->erase_count > stats->max_erase_count) {
+            stats->max_erase_count = info->erase_count;
+        }
+        first = false;
+    }
+
+    return 0;
+}
+
+// 关闭日志
+int FlashLogClose(FlashLog* log)
+{
+    if (log == NULL) {
+        return -1;
+    }
+
+    int ret = 0;
+    if (log->page != NULL) {
+        if (log->has_active) {
+            ret = ProgramPage(log);
+        }
+        free(log->page);
+    }
+    if (log->sectors != NULL) {
+        free(log->sectors);
+    }
+    memset(log, 0, sizeof(FlashLog));
+
+    return ret;
+}
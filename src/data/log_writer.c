@@ -0,0 +1,190 @@
+#include "data/log_writer.h"
+#include <string.h>
+#include "cmsis_os2.h"
+
+// 写入任务参数, 优先级低于采集及投递任务, 闪存擦写不影响采样
+#define LOG_WRITER_STACK_SIZE   2048
+#define LOG_WRITER_PRIORITY     osPriorityBelowNormal
+#define LOG_WRITER_EXIT_WAIT    500     // 等待写入任务写完剩余样本并退出的最长时间(tick)
+#define LOG_WRITER_QUEUE_SIZE   32      // 默认队列长度
+
+// 队列中的控制消息, 用样本类型之外的取值区分
+#define LOG_WRITER_MSG_EXIT     SENSOR_TYPE_MAX         // 退出写入任务
+#define LOG_WRITER_MSG_CAPTURE  (SENSOR_TYPE_MAX + 1)   // 写入已提交的触发捕获
+
+// 全局变量
+static FlashLog* g_log = NULL;
+static osMutexId_t g_log_mutex = NULL;
+static osMessageQueueId_t g_log_queue = NULL;
+static osThreadId_t g_writer_task = NULL;
+static CaptureView g_capture;                // 已提交的触发捕获(提交者写入后由写入任务读取)
+static LogWriterDone g_capture_done = NULL;
+static bool g_capture_busy = false;          // 已提交的捕获尚未写完
+
+// 写入已提交的触发捕获, 每个样本单独持锁, 不长时间阻塞日志读取
+static void WriteCapture(void)
+{
+    for (int part = 0; part < 2; part++) {
+        for (uint32_t i = 0; i < g_capture.count[part]; i++) {
+            if (osMutexAcquire(g_log_mutex, osWaitForever) != osOK) {
+                continue;
+            }
+            FlashLogAppendFlags(g_log, &g_capture.part[part][i], FLASH_LOG_FLAG_CAPTURE);
+            osMutexRelease(g_log_mutex);
+        }
+    }
+
+    LogWriterDone done = g_capture_done;
+    __atomic_store_n(&g_capture_busy, false, __ATOMIC_RELEASE);
+    if (done != NULL) {
+        done();
+    }
+}
+
+// 写入任务
+static void LogWriterTask(void* arg)
+{
+    SensorData data;
+
+    (void)arg;
+
+    // 收到退出消息时队列中之前的样本都已写入
+    for (;;) {
+        if (osMessageQueueGet(g_log_queue, &data, NULL, osWaitForever) != osOK) {
+            continue;
+        }
+        if ((uint32_t)data.type == LOG_WRITER_MSG_CAPTURE) {
+            WriteCapture();
+            continue;
+        }
+        if (data.type >= SENSOR_TYPE_MAX) {
+            break;
+        }
+
+        if (osMutexAcquire(g_log_mutex, osWaitForever) != osOK) {
+            continue;
+        }
+        FlashLogAppend(g_log, &data);
+        // 队列空闲时提前擦除下一个扇区, 切换扇区时不再等待擦除
+        if (osMessageQueueGetCount(g_log_queue) == 0) {
+            FlashLogPrepare(g_log);
+        }
+        osMutexRelease(g_log_mutex);
+    }
+
+    g_writer_task = NULL;
+    osThreadExit();
+}
+
+// 初始化日志写入
+int LogWriterInit(FlashLog* log, uint32_t queue_size)
+{
+    if (log == NULL) {
+        return -1;
+    }
+
+    g_log = log;
+    g_log_mutex = osMutexNew(NULL);
+    g_log_queue = osMessageQueueNew(queue_size != 0 ? queue_size : LOG_WRITER_QUEUE_SIZE, sizeof(SensorData), NULL);
+    if (g_log_mutex == NULL || g_log_queue == NULL) {
+        LogWriterDeinit();
+        return -1;
+    }
+
+    osThreadAttr_t attr = {0};
+    attr.name = "LogWriterTask";
+    attr.stack_size = LOG_WRITER_STACK_SIZE;
+    attr.priority = LOG_WRITER_PRIORITY;
+    g_writer_task = osThreadNew(LogWriterTask, NULL, &attr);
+    if (g_writer_task == NULL) {
+        LogWriterDeinit();
+        return -1;
+    }
+
+    return 0;
+}
+
+// 提交一个样本
+void LogWriterPost(const SensorData* data)
+{
+    if (data == NULL || data->type >= SENSOR_TYPE_MAX || g_log_queue == NULL) {
+        return;
+    }
+
+    osMessageQueuePut(g_log_queue, data, 0, 0);
+}
+
+// 提交触发捕获
+int LogWriterPostCapture(const CaptureView* capture, LogWriterDone done)
+{
+    if (capture == NULL || g_log_queue == NULL || __atomic_exchange_n(&g_capture_busy, true, __ATOMIC_ACQ_REL)) {
+        return -1;
+    }
+
+    // 捕获随控制消息排在之前提交的样本之后写入
+    memcpy(&g_capture, capture, sizeof(CaptureView));
+    g_capture_done = done;
+    SensorData msg = {0};
+    msg.type = (SensorType)LOG_WRITER_MSG_CAPTURE;
+    if (osMessageQueuePut(g_log_queue, &msg, 0, 0) != osOK) {
+        __atomic_store_n(&g_capture_busy, false, __ATOMIC_RELEASE);
+        return -1;
+    }
+
+    return 0;
+}
+
+// 从游标位置起读取日志记录
+int LogWriterRead(FlashLogCursor* cursor, FlashLogEntry* entries, uint32_t max_count, uint32_t* actual_count)
+{
+    if (g_log_mutex == NULL || osMutexAcquire(g_log_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    int ret = FlashLogRead(g_log, cursor, entries, max_count, actual_count);
+    osMutexRelease(g_log_mutex);
+
+    return ret;
+}
+
+// 把页缓冲中的记录写入闪存
+int LogWriterFlush(void)
+{
+    if (g_log_mutex == NULL || osMutexAcquire(g_log_mutex, osWaitForever) != osOK) {
+        return -1;
+    }
+    int ret = FlashLogFlush(g_log);
+    osMutexRelease(g_log_mutex);
+
+    return ret;
+}
+
+// 退出写入任务
+void LogWriterDeinit(void)
+{
+    if (g_writer_task != NULL) {
+        SensorData exit_msg = {0};
+        exit_msg.type = (SensorType)LOG_WRITER_MSG_EXIT;
+
+        // 退出消息排在剩余样本之后, 写入任务写完它们再退出
+        osMessageQueuePut(g_log_queue, &exit_msg, 0, LOG_WRITER_EXIT_WAIT);
+        for (uint32_t i = 0; i < LOG_WRITER_EXIT_WAIT && g_writer_task != NULL; i++) {
+            osDelay(1);
+        }
+        if (g_writer_task != NULL) {
+            osThreadTerminate(g_writer_task);
+            g_writer_task = NULL;
+        }
+    }
+
+    if (g_log_queue != NULL) {
+        osMessageQueueDelete(g_log_queue);
+        g_log_queue = NULL;
+    }
+    if (g_log_mutex != NULL) {
+        FlashLogFlush(g_log);
+        osMutexDelete(g_log_mutex);
+        g_log_mutex = NULL;
+    }
+    g_log = NULL;
+    g_capture_busy = false;
+}
@@ -0,0 +1,149 @@
+#include "data/sample_filter.h"
+#include <string.h>
+#include "data/sample_store.h"
+
+// 定点低通累加器的小数位数
+#define FILTER_IIR_FRAC_BITS 8
+
+// 检查单级滤波参数
+static bool IsStageValid(const FilterStage* stage)
+{
+    switch (stage->type) {
+        case FILTER_STAGE_NONE:
+            return true;
+        case FILTER_STAGE_MEDIAN:
+            return stage->window > 0 && stage->window <= COLLECTOR_MEDIAN_MAX && (stage->window & 1) != 0;
+        case FILTER_STAGE_RATE_LIMIT:
+            return stage->max_rate > 0.0f;
+        case FILTER_STAGE_EMA:
+            return stage->alpha > 0.0f && stage->alpha <= 1.0f;
+        case FILTER_STAGE_IIR:
+            return stage->shift >= 1 && stage->shift <= 8;
+        default:
+            return false;
+    }
+}
+
+// N点中值
+static float ApplyMedian(const FilterStage* stage, FilterStageState* state, float value)
+{
+    float sorted[COLLECTOR_MEDIAN_MAX];
+
+    state->history[state->index] = value;
+    state->index = (state->index + 1) % stage->window;
+    if (state->count < stage->window) {
+        state->count++;
+    }
+
+    // 窗口很小, 插入排序即可
+    for (uint8_t i = 0; i < state->count; i++) {
+        float item = state->history[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > item) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = item;
+    }
+
+    return sorted[state->count / 2];
+}
+
+// 变化率限制
+static float ApplyRateLimit(const FilterStage* stage, FilterStageState* state, float value, uint32_t dt_ms)
+{
+    if (!state->primed) {
+        return value;
+    }
+
+    float limit = stage->max_rate * (float)dt_ms / 1000.0f;
+    if (value > state->output + limit) {
+        return state->output + limit;
+    }
+    if (value < state->output - limit) {
+        return state->output - limit;
+    }
+    return value;
+}
+
+// 指数平滑
+static float ApplyEma(const FilterStage* stage, FilterStageState* state, float value)
+{
+    if (!state->primed) {
+        return value;
+    }
+
+    return state->output + stage->alpha * (value - state->output);
+}
+
+// 定点一阶低通, 在通道定点值上运算, 只用整数加法和移位
+static float ApplyIir(SensorChannel channel, const FilterStage* stage, FilterStageState* state, float value)
+{
+    int32_t input = (int32_t)SampleStoreEncode(channel, value) * (1 << FILTER_IIR_FRAC_BITS);
+
+    if (!state->primed) {
+        state->acc = input;
+    } else {
+        state->acc += (input - state->acc) >> stage->shift;
+    }
+
+    int32_t rounded = (state->acc + (1 << (FILTER_IIR_FRAC_BITS - 1))) >> FILTER_IIR_FRAC_BITS;
+    return SampleStoreDecode(channel, (int16_t)rounded);
+}
+
+// 初始化滤波链
+int SampleFilterInit(SampleFilter* filter, SensorChannel channel, const ChannelFilterConfig* config)
+{
+    if (filter == NULL || channel >= SENSOR_CHANNEL_MAX || config == NULL ||
+        config->stage_count > COLLECTOR_FILTER_STAGES) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < config->stage_count; i++) {
+        if (!IsStageValid(&config->stages[i])) {
+            return -1;
+        }
+    }
+
+    filter->channel = channel;
+    memcpy(&filter->config, config, sizeof(ChannelFilterConfig));
+    SampleFilterReset(filter);
+    return 0;
+}
+
+// 清空滤波状态
+void SampleFilterReset(SampleFilter* filter)
+{
+    memset(filter->state, 0, sizeof(filter->state));
+}
+
+// 输入一个样本并返回滤波结果
+float SampleFilterApply(SampleFilter* filter, float value, uint32_t dt_ms)
+{
+    for (uint8_t i = 0; i < filter->config.stage_count; i++) {
+        const FilterStage* stage = &filter->config.stages[i];
+        FilterStageState* state = &filter->state[i];
+
+        switch (stage->type) {
+            case FILTER_STAGE_MEDIAN:
+                value = ApplyMedian(stage, state, value);
+                break;
+            case FILTER_STAGE_RATE_LIMIT:
+                value = ApplyRateLimit(stage, state, value, dt_ms);
+                break;
+            case FILTER_STAGE_EMA:
+                value = ApplyEma(stage, state, value);
+                break;
+            case FILTER_STAGE_IIR:
+                value = ApplyIir(filter->channel, stage, state, value);
+                break;
+            default:
+                break;
+        }
+
+        state->output = value;
+        state->primed = true;
+    }
+
+    return value;
+}
@@ -0,0 +1,193 @@
+#include "data/sample_ring.h"
+#include <string.h>
+
+// 计算复制完成后仍然有效的最旧序号
+// 生产者公布writing之后才会覆盖序号writing - size及更早的槽位
+static uint32_t ValidFrom(const SampleRing* ring)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint32_t writing = __atomic_load_n(&ring->writing, __ATOMIC_ACQUIRE);
+    uint32_t base = __atomic_load_n(&ring->base, __ATOMIC_ACQUIRE);
+    uint32_t oldest = writing > ring->size ? writing - ring->size : 0;
+
+    return (int32_t)(base - oldest) > 0 ? base : oldest;
+}
+
+// 初始化环形缓存
+int SampleRingInit(SampleRing* ring, SensorData* storage, uint32_t size)
+{
+    if (ring == NULL || storage == NULL || size == 0) {
+        return -1;
+    }
+
+    ring->slots = storage;
+    ring->size = size;
+    ring->head = 0;
+    ring->writing = 0;
+    ring->base = 0;
+    return 0;
+}
+
+// 写入一个样本
+void SampleRingPush(SampleRing* ring, const SensorData* data)
+{
+    uint32_t head = ring->head;
+
+    // 先公布即将覆盖的槽位, 保证其先于槽位写入对读者可见
+    __atomic_store_n(&ring->writing, head + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&ring->slots[head % ring->size], data, sizeof(SensorData));
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// 获取已发布的样本总数
+uint32_t SampleRingHead(const SampleRing* ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+// 获取当前仍可读取的最旧序号
+uint32_t SampleRingOldest(const SampleRing* ring)
+{
+    uint32_t head = SampleRingHead(ring);
+    uint32_t base = __atomic_load_n(&ring->base, __ATOMIC_ACQUIRE);
+    uint32_t oldest = head > ring->size ? head - ring->size : 0;
+
+    return (int32_t)(base - oldest) > 0 ? base : oldest;
+}
+
+// 清除缓存
+void SampleRingClear(SampleRing* ring)
+{
+    __atomic_store_n(&ring->base, SampleRingHead(ring), __ATOMIC_RELEASE);
+}
+
+// 从seq开始复制样本
+int SampleRingRead(const SampleRing* ring, uint32_t seq, SensorData* out, uint32_t max_count,
+    uint32_t* actual_count, uint32_t* first_seq)
+{
+    if (ring == NULL || ring->slots == NULL || out == NULL || actual_count == NULL) {
+        return -1;
+    }
+
+    uint32_t head = SampleRingHead(ring);
+    uint32_t oldest = SampleRingOldest(ring);
+    if ((int32_t)(seq - oldest) < 0) {
+        seq = oldest;
+    }
+
+    uint32_t count = (int32_t)(head - seq) > 0 ? head - seq : 0;
+    if (count > max_count) {
+        count = max_count;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(&out[i], &ring->slots[(seq + i) % ring->size], sizeof(SensorData));
+    }
+
+    // 复制完成后重新检查写入位置, 丢弃复制期间可能被覆盖的最旧样本
+    uint32_t valid = ValidFrom(ring);
+    uint32_t dropped = 0;
+    if ((int32_t)(valid - seq) > 0) {
+        dropped = valid - seq;
+        if (dropped > count) {
+            dropped = count;
+        }
+        memmove(out, &out[dropped], sizeof(SensorData) * (count - dropped));
+    }
+
+    *actual_count = count - dropped;
+    if (first_seq != NULL) {
+        *first_seq = seq + dropped;
+    }
+    return 0;
+}
+
+// 二分查找时间戳
+uint32_t SampleRingFindTime(const SampleRing* ring, uint64_t timestamp, bool upper)
+{
+    uint32_t low = SampleRingOldest(ring);
+    uint32_t high = SampleRingHead(ring);
+
+    // 64位时间戳不会回绕, 直接比较
+    while (low != high) {
+        uint32_t mid = low + (high - low) / 2;
+        uint64_t ts = ring->slots[mid % ring->size].timestamp;
+        if (upper ? ts <= timestamp : ts < timestamp) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // 查找期间被覆盖的槽位可能导致结果偏前, 收敛到仍然有效的范围内
+    uint32_t valid = ValidFrom(ring);
+    return (int32_t)(valid - low) > 0 ? valid : low;
+}
+
+// 检查样本是否仍未被覆盖
+bool SampleRingIsValid(const SampleRing* ring, uint32_t seq)
+{
+    return (int32_t)(seq - ValidFrom(ring)) >= 0;
+}
+
+// 创建迭代器
+void SampleRingIterInit(const SampleRing* ring, SampleRingIter* iter)
+{
+    iter->ring = ring;
+    iter->end = SampleRingHead(ring);
+    iter->seq = SampleRingOldest(ring);
+}
+
+// 创建指定范围的迭代器
+void SampleRingIterInitRange(const SampleRing* ring, SampleRingIter* iter, uint32_t begin, uint32_t end)
+{
+    iter->ring = ring;
+    iter->seq = begin;
+    iter->end = end;
+}
+
+// 零拷贝获取迭代器的下一个样本
+const SensorData* SampleRingIterNextRef(SampleRingIter* iter, uint32_t* seq)
+{
+    const SampleRing* ring = iter->ring;
+
+    // 跳过已被覆盖的样本
+    uint32_t valid = ValidFrom(ring);
+    if ((int32_t)(valid - iter->seq) > 0) {
+        iter->seq = valid;
+    }
+
+    if ((int32_t)(iter->end - iter->seq) <= 0) {
+        return NULL;
+    }
+
+    if (seq != NULL) {
+        *seq = iter->seq;
+    }
+    return &ring->slots[iter->seq++ % ring->size];
+}
+
+// 复制迭代器的下一个样本
+bool SampleRingIterNext(SampleRingIter* iter, SensorData* data)
+{
+    const SampleRing* ring = iter->ring;
+
+    while ((int32_t)(iter->end - iter->seq) > 0) {
+        uint32_t seq = iter->seq++;
+        memcpy(data, &ring->slots[seq % ring->size], sizeof(SensorData));
+
+        uint32_t valid = ValidFrom(ring);
+        if ((int32_t)(seq - valid) >= 0) {
+            return true;
+        }
+
+        // 该样本已被覆盖, 跳到仍然有效的位置继续
+        if ((int32_t)(valid - iter->seq) > 0) {
+            iter->seq = valid;
+        }
+    }
+
+    return false;
+}
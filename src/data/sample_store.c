@@ -0,0 +1,564 @@
+#include "data/sample_store.h"
+#include <stdlib.h>
+#include <string.h>
+#include "common/clock.h"
+
+// 通道定点编码参数: 定点值 = 数值 * scale + offset
+typedef struct {
+    float scale;     // 比例
+    int32_t offset;  // 偏移
+} ChannelCodec;
+
+static const ChannelCodec g_codec[SENSOR_CHANNEL_MAX] = {
+    [SENSOR_CHANNEL_TEMPERATURE] = {100.0f, 0},      // 0.01℃
+    [SENSOR_CHANNEL_HUMIDITY] = {10.0f, 0},          // 0.1%RH
+    [SENSOR_CHANNEL_SMOKE] = {10.0f, 0},             // 0.1ppm
+    [SENSOR_CHANNEL_LIGHT] = {1.0f, -32768}          // 1lux, 覆盖0-65535lux
+};
+
+// 时间列中表示长间隔的标记, 实际间隔保存在长间隔表中
+#define DELTA_GAP UINT16_MAX
+
+// 获取位置index的样本与前一样本的时间差(us)
+static uint64_t DeltaAt(const SampleStore* store, uint32_t index)
+{
+    if (store->deltas[index] != DELTA_GAP) {
+        return (uint64_t)store->deltas[index] * CLOCK_US_PER_MS;
+    }
+
+    for (uint8_t i = 0; i < store->gap_count; i++) {
+        if (store->gaps[i].index == index) {
+            return (uint64_t)store->gaps[i].gap_ms * CLOCK_US_PER_MS;
+        }
+    }
+    return 0;
+}
+
+// 删除第i条长间隔记录
+static void RemoveGap(SampleStore* store, uint8_t i)
+{
+    memmove(&store->gaps[i], &store->gaps[i + 1], (store->gap_count - i - 1) * sizeof(SampleStoreGap));
+    store->gap_count--;
+}
+
+// 长间隔表已满时丢弃最早一段样本, 使最早的长间隔之后的样本成为最旧样本
+static void DropOldestSegment(SampleStore* store)
+{
+    uint32_t target = store->gaps[0].index;
+    uint32_t index = (store->head + store->capacity - store->count) % store->capacity;
+    uint64_t ts = store->first_ts;
+
+    while (index != target) {
+        index = (index + 1) % store->capacity;
+        ts += DeltaAt(store, index);
+    }
+
+    uint32_t count = (store->head + store->capacity - target) % store->capacity;
+    store->count = count == 0 ? store->capacity : count;
+    store->first_ts = ts;
+    store->deltas[target] = 0;
+    RemoveGap(store, 0);
+}
+
+// 取出传感器数据中各通道的数值
+static void ExtractValues(const SampleStore* store, const SensorData* data, float* values)
+{
+    switch (store->type) {
+        case SENSOR_TYPE_DHT11:
+            values[0] = data->data.dht11.temperature;
+            values[1] = data->data.dht11.humidity;
+            break;
+        case SENSOR_TYPE_MQ2:
+            values[0] = data->data.mq2.smoke;
+            break;
+        case SENSOR_TYPE_BH1750:
+            values[0] = data->data.bh1750.light;
+            break;
+        default:
+            break;
+    }
+}
+
+// 将各通道的定点值解码填回传感器数据
+static void DecodeValues(const SampleStore* store, const int16_t* fixed, SensorData* data)
+{
+    data->type = store->type;
+    switch (store->type) {
+        case SENSOR_TYPE_DHT11:
+            data->data.dht11.temperature = SampleStoreDecode(store->channels[0], fixed[0]);
+            data->data.dht11.humidity = SampleStoreDecode(store->channels[1], fixed[1]);
+            break;
+        case SENSOR_TYPE_MQ2:
+            data->data.mq2.smoke = SampleStoreDecode(store->channels[0], fixed[0]);
+            break;
+        case SENSOR_TYPE_BH1750:
+            data->data.bh1750.light = SampleStoreDecode(store->channels[0], fixed[0]);
+            break;
+        default:
+            break;
+    }
+}
+
+// 将位置index的样本数值填回传感器数据
+static void FillValues(const SampleStore* store, uint32_t index, SensorData* data)
+{
+    int16_t fixed[SAMPLE_STORE_MAX_CHANNELS] = {0};
+
+    for (uint8_t i = 0; i < store->channel_count; i++) {
+        fixed[i] = store->values[i][index];
+    }
+    DecodeValues(store, fixed, data);
+}
+
+// 获取最旧样本的位置
+static uint32_t OldestIndex(const SampleStore* store)
+{
+    return (store->head + store->capacity - store->count) % store->capacity;
+}
+
+// 获取从最旧样本起第pos个样本的时间戳
+// 从它之前最近的锚点(锚点已被覆盖时从最旧样本)起累加差值, 最多累加一个锚点间隔
+static uint64_t TimestampAt(const SampleStore* store, uint32_t pos)
+{
+    uint32_t oldest = OldestIndex(store);
+    uint32_t index = (oldest + pos) % store->capacity;
+    uint32_t anchor = index - index % SAMPLE_STORE_ANCHOR_INTERVAL;
+    uint32_t anchor_pos = (anchor + store->capacity - oldest) % store->capacity;
+    uint64_t ts = store->first_ts;
+    uint32_t from = 0;
+
+    if (anchor_pos <= pos) {
+        ts = store->anchors[anchor / SAMPLE_STORE_ANCHOR_INTERVAL];
+        from = anchor_pos;
+    }
+    for (uint32_t i = from + 1; i <= pos; i++) {
+        ts += DeltaAt(store, (oldest + i) % store->capacity);
+    }
+
+    return ts;
+}
+
+// 查找第一个不早于since_ts的样本, 返回它从最旧样本起的序号(没有时为count)及时间戳
+// 锚点按从旧到新的顺序二分查找, 再从早于since_ts的最后一个锚点起最多累加一个锚点间隔
+static uint32_t FindFirst(const SampleStore* store, uint64_t since_ts, uint64_t* start_ts)
+{
+    uint32_t oldest = OldestIndex(store);
+    uint32_t anchor_count = (store->capacity + SAMPLE_STORE_ANCHOR_INTERVAL - 1) / SAMPLE_STORE_ANCHOR_INTERVAL;
+    uint32_t first = (oldest + SAMPLE_STORE_ANCHOR_INTERVAL - 1) / SAMPLE_STORE_ANCHOR_INTERVAL;
+    uint32_t low = 0;
+    uint32_t high = anchor_count;
+
+    // 从最旧样本起第j个锚点的序号随j递增, 超出样本数量的锚点视为晚于since_ts
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        uint32_t anchor = (first + mid) % anchor_count;
+        uint32_t pos = (anchor * SAMPLE_STORE_ANCHOR_INTERVAL + store->capacity - oldest) % store->capacity;
+        if (pos >= store->count || store->anchors[anchor] >= since_ts) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    uint32_t pos = 0;
+    uint64_t ts = store->first_ts;
+    if (low > 0) {
+        uint32_t anchor = (first + low - 1) % anchor_count;
+        pos = (anchor * SAMPLE_STORE_ANCHOR_INTERVAL + store->capacity - oldest) % store->capacity;
+        ts = store->anchors[anchor];
+    }
+    while (pos < store->count && ts < since_ts) {
+        pos++;
+        if (pos < store->count) {
+            ts += DeltaAt(store, (oldest + pos) % store->capacity);
+        }
+    }
+
+    *start_ts = ts;
+    return pos;
+}
+
+// 浮点值编码为通道定点值
+int16_t SampleStoreEncode(SensorChannel channel, float value)
+{
+    if (channel >= SENSOR_CHANNEL_MAX) {
+        return 0;
+    }
+
+    float scaled = value * g_codec[channel].scale;
+    int32_t fixed = (int32_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f) + g_codec[channel].offset;
+
+    if (fixed > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (fixed < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)fixed;
+}
+
+// 通道定点值解码为浮点值
+float SampleStoreDecode(SensorChannel channel, int16_t value)
+{
+    if (channel >= SENSOR_CHANNEL_MAX) {
+        return 0.0f;
+    }
+
+    return (float)((int32_t)value - g_codec[channel].offset) / g_codec[channel].scale;
+}
+
+// 每个样本占用的字节数
+uint32_t SampleStoreSampleBytes(SensorType type)
+{
+    uint32_t channels = type == SENSOR_TYPE_DHT11 ? 2 : 1;
+    return sizeof(uint16_t) + sizeof(int16_t) * channels;
+}
+
+// 初始化样本存储
+int SampleStoreInit(SampleStore* store, SensorType type, uint32_t capacity)
+{
+    if (store == NULL || type >= SENSOR_TYPE_MAX || capacity == 0) {
+        return -1;
+    }
+
+    memset(store, 0, sizeof(SampleStore));
+    store->type = type;
+    store->capacity = capacity;
+
+    switch (type) {
+        case SENSOR_TYPE_DHT11:
+            store->channel_count = 2;
+            store->channels[0] = SENSOR_CHANNEL_TEMPERATURE;
+            store->channels[1] = SENSOR_CHANNEL_HUMIDITY;
+            break;
+        case SENSOR_TYPE_MQ2:
+            store->channel_count = 1;
+            store->channels[0] = SENSOR_CHANNEL_SMOKE;
+            break;
+        default:
+            store->channel_count = 1;
+            store->channels[0] = SENSOR_CHANNEL_LIGHT;
+            break;
+    }
+
+    store->deltas = malloc(sizeof(uint16_t) * capacity);
+    store->anchors = malloc(sizeof(uint64_t) *
+        ((capacity + SAMPLE_STORE_ANCHOR_INTERVAL - 1) / SAMPLE_STORE_ANCHOR_INTERVAL));
+    if (store->deltas == NULL || store->anchors == NULL) {
+        SampleStoreDeinit(store);
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < store->channel_count; i++) {
+        store->values[i] = malloc(sizeof(int16_t) * capacity);
+        if (store->values[i] == NULL) {
+            SampleStoreDeinit(store);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// 释放样本存储
+void SampleStoreDeinit(SampleStore* store)
+{
+    if (store == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SAMPLE_STORE_MAX_CHANNELS; i++) {
+        if (store->values[i] != NULL) {
+            free(store->values[i]);
+            store->values[i] = NULL;
+        }
+    }
+
+    if (store->deltas != NULL) {
+        free(store->deltas);
+        store->deltas = NULL;
+    }
+
+    if (store->anchors != NULL) {
+        free(store->anchors);
+        store->anchors = NULL;
+    }
+
+    store->capacity = 0;
+    store->count = 0;
+    store->head = 0;
+}
+
+// 追加一个样本
+int SampleStoreAppend(SampleStore* store, const SensorData* data)
+{
+    if (store == NULL || data == NULL || store->deltas == NULL || data->type != store->type) {
+        return -1;
+    }
+
+    // 时间倒退或间隔超出长间隔表可表示的范围时无法继续差分编码, 重新开始
+    if (store->count > 0 && (data->timestamp < store->last_ts ||
+        (data->timestamp - store->last_ts) / CLOCK_US_PER_MS > UINT32_MAX)) {
+        SampleStoreClear(store);
+    }
+
+    // 差分按毫秒截断, 累计的时间戳始终不晚于实际时间, 误差不会累积
+    uint64_t delta = (data->timestamp - store->last_ts) / CLOCK_US_PER_MS;
+    if (store->count == 0) {
+        store->first_ts = data->timestamp;
+        store->last_ts = data->timestamp;
+        delta = 0;
+    } else if (store->count == store->capacity) {
+        // 覆盖最旧样本, 最旧时间戳前移到下一个样本
+        store->first_ts += DeltaAt(store, (store->head + 1) % store->capacity);
+        store->count--;
+    }
+
+    // 被覆盖位置上的长间隔记录不再有效
+    for (uint8_t i = 0; i < store->gap_count; i++) {
+        if (store->gaps[i].index == store->head) {
+            RemoveGap(store, i);
+            break;
+        }
+    }
+
+    // 间隔超出16位范围(如停止后重新启动)时记入长间隔表, 保留之前的样本
+    uint16_t column_delta = (uint16_t)delta;
+    if (delta >= DELTA_GAP) {
+        if (store->gap_count == SAMPLE_STORE_MAX_GAPS) {
+            DropOldestSegment(store);
+        }
+        store->gaps[store->gap_count].index = store->head;
+        store->gaps[store->gap_count].gap_ms = (uint32_t)delta;
+        store->gap_count++;
+        column_delta = DELTA_GAP;
+    }
+
+    float values[SAMPLE_STORE_MAX_CHANNELS] = {0};
+    ExtractValues(store, data, values);
+    for (uint8_t i = 0; i < store->channel_count; i++) {
+        store->values[i][store->head] = SampleStoreEncode(store->channels[i], values[i]);
+    }
+    store->deltas[store->head] = column_delta;
+
+    store->last_ts += delta * CLOCK_US_PER_MS;
+    if (store->head % SAMPLE_STORE_ANCHOR_INTERVAL == 0) {
+        store->anchors[store->head / SAMPLE_STORE_ANCHOR_INTERVAL] = store->last_ts;
+    }
+    store->head = (store->head + 1) % store->capacity;
+    store->count++;
+    store->total++;
+
+    return 0;
+}
+
+// 清空样本存储
+void SampleStoreClear(SampleStore* store)
+{
+    if (store == NULL) {
+        return;
+    }
+
+    store->count = 0;
+    store->head = 0;
+    store->gap_count = 0;
+}
+
+// 读取since_ts之后的样本
+int SampleStoreRead(const SampleStore* store, uint64_t since_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count)
+{
+    if (store == NULL || data == NULL || actual_count == NULL) {
+        return -1;
+    }
+
+    *actual_count = 0;
+    if (store->count == 0) {
+        return 0;
+    }
+
+    // 超过max_count时从最新的max_count个样本开始
+    uint64_t ts = 0;
+    uint32_t pos = FindFirst(store, since_ts, &ts);
+    if (store->count - pos > max_count) {
+        pos = store->count - max_count;
+        ts = TimestampAt(store, pos);
+    }
+    uint32_t index = (OldestIndex(store) + pos) % store->capacity;
+    uint32_t found = store->count - pos;
+
+    for (uint32_t i = 0; i < found; i++) {
+        if (i > 0) {
+            ts += DeltaAt(store, index);
+        }
+        memset(&data[i], 0, sizeof(SensorData));
+        FillValues(store, index, &data[i]);
+        data[i].timestamp = ts;
+        index = (index + 1) % store->capacity;
+    }
+
+    *actual_count = found;
+    return 0;
+}
+
+// 读取since_ts到until_ts之间的样本
+int SampleStoreReadRange(const SampleStore* store, uint64_t since_ts, uint64_t until_ts, SensorData* data,
+    uint32_t max_count, uint32_t* actual_count)
+{
+    if (store == NULL || data == NULL || actual_count == NULL) {
+        return -1;
+    }
+
+    *actual_count = 0;
+    if (store->count == 0 || since_ts > until_ts) {
+        return 0;
+    }
+
+    uint64_t ts = 0;
+    uint32_t pos = FindFirst(store, since_ts, &ts);
+    uint32_t index = (OldestIndex(store) + pos) % store->capacity;
+    uint32_t found = store->count - pos;
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < found && count < max_count; i++) {
+        if (i > 0) {
+            ts += DeltaAt(store, index);
+        }
+        if (ts > until_ts) {
+            break;
+        }
+        memset(&data[count], 0, sizeof(SensorData));
+        FillValues(store, index, &data[count]);
+        data[count].timestamp = ts;
+        count++;
+        index = (index + 1) % store->capacity;
+    }
+
+    *actual_count = count;
+    return 0;
+}
+
+// 查找读取起点的序号
+uint32_t SampleStoreSeek(const SampleStore* store, uint64_t since_ts, uint32_t max_count)
+{
+    if (store == NULL || store->count == 0) {
+        return store == NULL ? 0 : store->total;
+    }
+
+    uint64_t ts = 0;
+    uint32_t pos = FindFirst(store, since_ts, &ts);
+    if (store->count - pos > max_count) {
+        pos = store->count - max_count;
+    }
+
+    return store->total - store->count + pos;
+}
+
+// 从序号起复制一块样本
+int SampleStoreCopy(const SampleStore* store, uint32_t sequence, uint64_t until_ts, SampleStoreChunk* chunk)
+{
+    if (store == NULL || chunk == NULL || store->deltas == NULL) {
+        return -1;
+    }
+
+    uint32_t oldest = store->total - store->count;
+    if ((int32_t)(sequence - oldest) < 0) {
+        sequence = oldest;
+    }
+    chunk->count = 0;
+    chunk->next = sequence;
+    if ((int32_t)(store->total - sequence) <= 0) {
+        return 0;
+    }
+
+    uint32_t pos = sequence - oldest;
+    uint32_t index = (OldestIndex(store) + pos) % store->capacity;
+    uint64_t ts = TimestampAt(store, pos);
+    while (chunk->count < SAMPLE_STORE_CHUNK_SIZE && pos < store->count) {
+        if (chunk->count > 0) {
+            ts += DeltaAt(store, index);
+        }
+        if (ts > until_ts) {
+            break;
+        }
+        chunk->timestamps[chunk->count] = ts;
+        for (uint8_t i = 0; i < store->channel_count; i++) {
+            chunk->values[i][chunk->count] = store->values[i][index];
+        }
+        chunk->count++;
+        pos++;
+        index = (index + 1) % store->capacity;
+    }
+
+    chunk->next = oldest + pos;
+    return 0;
+}
+
+// 解码块中的样本
+void SampleStoreDecodeChunk(const SampleStore* store, const SampleStoreChunk* chunk, uint32_t i, SensorData* data)
+{
+    int16_t fixed[SAMPLE_STORE_MAX_CHANNELS] = {0};
+
+    for (uint8_t c = 0; c < store->channel_count; c++) {
+        fixed[c] = chunk->values[c][i];
+    }
+    memset(data, 0, sizeof(SensorData));
+    DecodeValues(store, fixed, data);
+    data->timestamp = chunk->timestamps[i];
+}
+
+// 扫描指定通道
+int SampleStoreScan(const SampleStore* store, SensorChannel channel, uint64_t since_ts,
+    int16_t* min, int16_t* max, int32_t* sum, uint32_t* count)
+{
+    if (store == NULL || min == NULL || max == NULL || sum == NULL || count == NULL) {
+        return -1;
+    }
+
+    const int16_t* column = NULL;
+    for (uint8_t i = 0; i < store->channel_count; i++) {
+        if (store->channels[i] == channel) {
+            column = store->values[i];
+        }
+    }
+    if (column == NULL) {
+        return -1;
+    }
+
+    *min = INT16_MAX;
+    *max = INT16_MIN;
+    *sum = 0;
+    *count = 0;
+    if (store->count == 0) {
+        return 0;
+    }
+
+    uint64_t start_ts = 0;
+    uint32_t pos = FindFirst(store, since_ts, &start_ts);
+    uint32_t start = (OldestIndex(store) + pos) % store->capacity;
+    uint32_t found = store->count - pos;
+
+    // 数值列在环形缓冲中最多分成两段连续内存
+    uint32_t first_span = store->capacity - start;
+    if (first_span > found) {
+        first_span = found;
+    }
+    const int16_t* spans[2] = {&column[start], column};
+    const uint32_t lengths[2] = {first_span, found - first_span};
+
+    for (int s = 0; s < 2; s++) {
+        for (uint32_t i = 0; i < lengths[s]; i++) {
+            int16_t value = spans[s][i];
+            if (value < *min) {
+                *min = value;
+            }
+            if (value > *max) {
+                *max = value;
+            }
+            *sum += value;
+        }
+    }
+
+    *count = found;
+    return 0;
+}
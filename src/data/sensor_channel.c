@@ -0,0 +1,43 @@
+#include "data/data_collector.h"
+#include <stddef.h>
+
+// 获取通道所属的传感器类型
+SensorType CollectorGetChannelSensor(SensorChannel channel)
+{
+    switch (channel) {
+        case SENSOR_CHANNEL_TEMPERATURE:
+        case SENSOR_CHANNEL_HUMIDITY:
+            return SENSOR_TYPE_DHT11;
+        case SENSOR_CHANNEL_SMOKE:
+            return SENSOR_TYPE_MQ2;
+        case SENSOR_CHANNEL_LIGHT:
+            return SENSOR_TYPE_BH1750;
+        default:
+            return SENSOR_TYPE_MAX;
+    }
+}
+
+// 从传感器数据中取出指定通道的数值
+int CollectorGetChannelValue(const SensorData* data, SensorChannel channel, float* value)
+{
+    if (data == NULL || value == NULL || data->type != CollectorGetChannelSensor(channel)) {
+        return -1;
+    }
+    
+    switch (channel) {
+        case SENSOR_CHANNEL_TEMPERATURE:
+            *value = data->data.dht11.temperature;
+            break;
+        case SENSOR_CHANNEL_HUMIDITY:
+            *value = data->data.dht11.humidity;
+            break;
+        case SENSOR_CHANNEL_SMOKE:
+            *value = data->data.mq2.smoke;
+            break;
+        default:
+            *value = data->data.bh1750.light;
+            break;
+    }
+    
+    return 0;
+}
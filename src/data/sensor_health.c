@@ -0,0 +1,62 @@
+#include "data/sensor_health.h"
+#include <string.h>
+
+// 初始化传感器健康信息
+void SensorHealthInit(SensorHealth* health)
+{
+    memset(health, 0, sizeof(SensorHealth));
+    health->state = SENSOR_HEALTH_OK;
+}
+
+// 计算降级状态下的读取间隔
+static uint32_t NextBackoff(const SensorHealth* health, const HealthPolicy* policy, uint32_t period_ms)
+{
+    uint32_t backoff = health->backoff_ms != 0 ? health->backoff_ms * 2 : period_ms * 2;
+
+    if (backoff > policy->max_backoff_ms) {
+        backoff = policy->max_backoff_ms;
+    }
+    return backoff > period_ms ? backoff : period_ms;
+}
+
+// 记录一次读取结果
+uint32_t SensorHealthReport(SensorHealth* health, const HealthPolicy* policy, bool success,
+    uint32_t period_ms, uint64_t timestamp)
+{
+    health->total_reads++;
+
+    if (success) {
+        health->state = SENSOR_HEALTH_OK;
+        health->consecutive_failures = 0;
+        health->retries = 0;
+        health->backoff_ms = 0;
+        health->last_success_ts = timestamp;
+        return 0;
+    }
+
+    health->total_failures++;
+    health->consecutive_failures++;
+
+    // 连续失败过多, 降频读取, 不再占用总线时间
+    if (policy->degrade_threshold != 0 && health->consecutive_failures >= policy->degrade_threshold) {
+        health->state = SENSOR_HEALTH_DEGRADED;
+        health->retries = 0;
+        health->backoff_ms = NextBackoff(health, policy, period_ms);
+        return health->backoff_ms;
+    }
+
+    health->state = SENSOR_HEALTH_RETRYING;
+    if (health->retries < policy->max_retries) {
+        uint32_t delay = policy->retry_delay_ms << health->retries;
+        health->retries++;
+
+        // 重试延迟达到一个周期时直接等下一周期
+        if (delay < period_ms) {
+            return delay;
+        }
+    }
+
+    // 本周期的重试次数用完, 下一周期重新计数
+    health->retries = 0;
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "data/sensor_read.h"
+#include <string.h>
+#include "common/clock.h"
+
+// 每个传感器的读取状态
+// 读取只在采集任务中执行, 结果不需要加锁; 统计由其他任务读取, 计数器原子访问
+typedef struct {
+    bool valid;              // 是否有成功的结果
+    SensorData data;         // 最近一次成功读取的数据
+    SensorReadStats stats;   // 统计
+} ReadSlot;
+
+// 全局变量
+static ReadSlot g_read_slots[SENSOR_TYPE_MAX] = {0};
+static SensorReadFunc g_read = NULL;
+
+// 初始化按需读取
+int SensorReadInit(SensorReadFunc read)
+{
+    if (read == NULL) {
+        return -1;
+    }
+
+    memset(g_read_slots, 0, sizeof(g_read_slots));
+    g_read = read;
+    return 0;
+}
+
+// 读取传感器
+int SensorReadShared(SensorType type, uint32_t max_age_ms, SensorData* data)
+{
+    if (type >= SENSOR_TYPE_MAX || data == NULL || g_read == NULL) {
+        return -1;
+    }
+
+    ReadSlot* slot = &g_read_slots[type];
+    uint64_t now = ClockNowUs();
+    if (slot->valid && now - slot->data.timestamp <= (uint64_t)max_age_ms * CLOCK_US_PER_MS) {
+        memcpy(data, &slot->data, sizeof(SensorData));
+        __atomic_fetch_add(&slot->stats.cache_hits, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    SensorData result;
+    memset(&result, 0, sizeof(SensorData));
+    int ret = g_read(type, &result);
+
+    // 异步转换未完成时稍后还会再读, 只在读取完成时计数
+    if (ret != SENSOR_READ_BUSY) {
+        __atomic_fetch_add(&slot->stats.bus_reads, 1, __ATOMIC_RELAXED);
+    }
+    if (ret == 0) {
+        memcpy(&slot->data, &result, sizeof(SensorData));
+        slot->valid = true;
+        memcpy(data, &result, sizeof(SensorData));
+    }
+
+    return ret;
+}
+
+// 记录一次合并到尚未执行的读取的请求
+void SensorReadCountJoined(SensorType type)
+{
+    if (type >= SENSOR_TYPE_MAX) {
+        return;
+    }
+    __atomic_fetch_add(&g_read_slots[type].stats.joined, 1, __ATOMIC_RELAXED);
+}
+
+// 获取读取统计
+void SensorReadGetStats(SensorType type, SensorReadStats* stats)
+{
+    if (type >= SENSOR_TYPE_MAX || stats == NULL) {
+        return;
+    }
+
+    const SensorReadStats* src = &g_read_slots[type].stats;
+    stats->bus_reads = __atomic_load_n(&src->bus_reads, __ATOMIC_RELAXED);
+    stats->joined = __atomic_load_n(&src->joined, __ATOMIC_RELAXED);
+    stats->cache_hits = __atomic_load_n(&src->cache_hits, __ATOMIC_RELAXED);
+}
+
+// 释放按需读取资源
+void SensorReadDeinit(void)
+{
+    g_read = NULL;
+}
@@ -0,0 +1,171 @@
+#include "data/sensor_scheduler.h"
+#include <string.h>
+
+// 比较两个调度项, a应先于b执行时返回true
+// 到期时间按有符号差值比较, 以正确处理tick计数回绕
+static bool EntryBefore(const SchedulerEntry* a, const SchedulerEntry* b)
+{
+    int32_t diff = (int32_t)(a->due - b->due);
+    if (diff != 0) {
+        return diff < 0;
+    }
+    return a->priority > b->priority;
+}
+
+// 交换堆中两个元素
+static void SwapEntry(SchedulerEntry* a, SchedulerEntry* b)
+{
+    SchedulerEntry tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// 上浮
+static void SiftUp(SensorScheduler* sched, uint32_t index)
+{
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!EntryBefore(&sched->heap[index], &sched->heap[parent])) {
+            break;
+        }
+        SwapEntry(&sched->heap[index], &sched->heap[parent]);
+        index = parent;
+    }
+}
+
+// 下沉
+static void SiftDown(SensorScheduler* sched, uint32_t index)
+{
+    for (;;) {
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+        uint32_t first = index;
+
+        if (left < sched->count && EntryBefore(&sched->heap[left], &sched->heap[first])) {
+            first = left;
+        }
+        if (right < sched->count && EntryBefore(&sched->heap[right], &sched->heap[first])) {
+            first = right;
+        }
+        if (first == index) {
+            break;
+        }
+        SwapEntry(&sched->heap[index], &sched->heap[first]);
+        index = first;
+    }
+}
+
+// 删除指定位置的元素
+static void RemoveAt(SensorScheduler* sched, uint32_t index)
+{
+    sched->count--;
+    if (index == sched->count) {
+        return;
+    }
+    sched->heap[index] = sched->heap[sched->count];
+    SiftDown(sched, index);
+    SiftUp(sched, index);
+}
+
+// 初始化调度器
+void SchedulerInit(SensorScheduler* sched)
+{
+    if (sched == NULL) {
+        return;
+    }
+    memset(sched, 0, sizeof(SensorScheduler));
+}
+
+// 添加调度项
+int SchedulerAdd(SensorScheduler* sched, uint8_t id, uint32_t period, uint32_t first_due, uint8_t priority)
+{
+    if (sched == NULL || period == 0 || sched->count >= SCHEDULER_MAX_ENTRIES) {
+        return -1;
+    }
+
+    // 同一标识只允许存在一个调度项
+    SchedulerRemove(sched, id);
+
+    SchedulerEntry* entry = &sched->heap[sched->count];
+    entry->due = first_due;
+    entry->period = period;
+    entry->priority = priority;
+    entry->id = id;
+    sched->count++;
+    SiftUp(sched, sched->count - 1);
+
+    return 0;
+}
+
+// 移除调度项
+int SchedulerRemove(SensorScheduler* sched, uint8_t id)
+{
+    if (sched == NULL) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < sched->count; i++) {
+        if (sched->heap[i].id == id) {
+            RemoveAt(sched, i);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+// 查看最早到期的调度项
+int SchedulerPeek(const SensorScheduler* sched, SchedulerEntry* entry)
+{
+    if (sched == NULL || entry == NULL || sched->count == 0) {
+        return -1;
+    }
+
+    *entry = sched->heap[0];
+    return 0;
+}
+
+// 取出一个已到期的调度项
+int SchedulerPopDue(SensorScheduler* sched, uint32_t now, SchedulerEntry* entry)
+{
+    if (sched == NULL || entry == NULL || sched->count == 0) {
+        return -1;
+    }
+
+    if ((int32_t)(sched->heap[0].due - now) > 0) {
+        return -1;
+    }
+
+    *entry = sched->heap[0];
+    RemoveAt(sched, 0);
+    return 0;
+}
+
+// 按周期重新入堆
+int SchedulerReschedule(SensorScheduler* sched, const SchedulerEntry* entry, uint32_t now, uint32_t* skipped)
+{
+    if (sched == NULL || entry == NULL || entry->period == 0 || sched->count >= SCHEDULER_MAX_ENTRIES) {
+        return -1;
+    }
+
+    SchedulerEntry next = *entry;
+    uint32_t missed = 0;
+
+    // 保持相位不变, 下次到期时间按周期累加; 已错过的周期直接跳过, 避免突发补采
+    next.due += next.period;
+    if ((int32_t)(next.due - now) <= 0) {
+        uint32_t late = now - next.due;
+        missed = late / next.period + 1;
+        next.due += missed * next.period;
+    }
+
+    if (skipped != NULL) {
+        *skipped = missed;
+    }
+
+    sched->heap[sched->count] = next;
+    sched->count++;
+    SiftUp(sched, sched->count - 1);
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "data/subscription.h"
+#include <string.h>
+
+// 判断是否有启用死区的通道变化超过死区
+static bool IsOutsideDeadband(const Subscriber* subscriber, const SensorData* data)
+{
+    bool has_deadband = false;
+
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        float deadband = subscriber->filter.deadband[channel];
+        float value = 0.0f;
+        if (deadband <= 0.0f || CollectorGetChannelValue(data, channel, &value) != 0) {
+            continue;
+        }
+
+        has_deadband = true;
+        float diff = value - subscriber->last_value[channel];
+        if (diff >= deadband || diff <= -deadband) {
+            return true;
+        }
+    }
+
+    // 该传感器没有启用死区的通道时每个样本都通知
+    return !has_deadband;
+}
+
+// 清空订阅表
+void SubscriptionInit(SubscriptionTable* table)
+{
+    memset(table, 0, sizeof(SubscriptionTable));
+}
+
+// 添加订阅
+int SubscriptionAdd(SubscriptionTable* table, DataCallback callback, const SubscriptionFilter* filter,
+    uint64_t min_interval)
+{
+    if (table == NULL || callback == NULL || filter == NULL) {
+        return -1;
+    }
+
+    for (int id = 0; id < COLLECTOR_MAX_SUBSCRIBERS; id++) {
+        Subscriber* subscriber = &table->entries[id];
+        if (subscriber->used) {
+            continue;
+        }
+
+        memset(subscriber, 0, sizeof(Subscriber));
+        subscriber->callback = callback;
+        memcpy(&subscriber->filter, filter, sizeof(SubscriptionFilter));
+        subscriber->min_interval = min_interval;
+        subscriber->used = true;
+        table->count++;
+        return id;
+    }
+
+    return -1;
+}
+
+// 删除订阅
+int SubscriptionRemove(SubscriptionTable* table, int id)
+{
+    if (table == NULL || id < 0 || id >= COLLECTOR_MAX_SUBSCRIBERS || !table->entries[id].used) {
+        return -1;
+    }
+
+    table->entries[id].used = false;
+    table->count--;
+    return 0;
+}
+
+// 判断订阅者是否需要该样本
+bool SubscriptionAccept(Subscriber* subscriber, const SensorData* data)
+{
+    if (!subscriber->used || data->type >= SENSOR_TYPE_MAX ||
+        (subscriber->filter.sensor_mask & COLLECTOR_SENSOR_MASK(data->type)) == 0) {
+        return false;
+    }
+
+    // 第一个样本总是通知, 之后依次检查最小间隔和死区
+    uint32_t mask = COLLECTOR_SENSOR_MASK(data->type);
+    if (subscriber->reported & mask) {
+        if (data->timestamp - subscriber->last_ts[data->type] < subscriber->min_interval) {
+            return false;
+        }
+        if (!IsOutsideDeadband(subscriber, data)) {
+            return false;
+        }
+    }
+
+    subscriber->reported |= mask;
+    subscriber->last_ts[data->type] = data->timestamp;
+    for (SensorChannel channel = SENSOR_CHANNEL_TEMPERATURE; channel < SENSOR_CHANNEL_MAX; channel++) {
+        CollectorGetChannelValue(data, channel, &subscriber->last_value[channel]);
+    }
+    return true;
+}
+
+// 对所有需要该样本的订阅者回调
+uint32_t SubscriptionDispatch(SubscriptionTable* table, const SensorData* data)
+{
+    uint32_t delivered = 0;
+
+    if (table == NULL || data == NULL || table->count == 0) {
+        return 0;
+    }
+
+    for (int id = 0; id < COLLECTOR_MAX_SUBSCRIBERS; id++) {
+        Subscriber* subscriber = &table->entries[id];
+        if (SubscriptionAccept(subscriber, data)) {
+            subscriber->callback(data);
+            delivered++;
+        }
+    }
+
+    return delivered;
+}
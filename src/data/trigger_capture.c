@@ -0,0 +1,141 @@
+#include "data/trigger_capture.h"
+#include <stdlib.h>
+#include <string.h>
+#include "common/clock.h"
+
+// 最旧样本的位置
+static uint32_t Oldest(const TriggerCapture* capture)
+{
+    return (capture->head + capture->capacity - capture->count) % capture->capacity;
+}
+
+// 初始化触发捕获缓冲区
+int TriggerCaptureInit(TriggerCapture* capture, uint32_t capacity, uint32_t pre_ms, uint32_t post_ms)
+{
+    if (capture == NULL || capacity == 0) {
+        return -1;
+    }
+
+    memset(capture, 0, sizeof(TriggerCapture));
+    capture->slots = malloc(sizeof(SensorData) * capacity);
+    if (capture->slots == NULL) {
+        return -1;
+    }
+
+    capture->capacity = capacity;
+    capture->pre_us = (uint64_t)pre_ms * CLOCK_US_PER_MS;
+    capture->post_us = (uint64_t)post_ms * CLOCK_US_PER_MS;
+    capture->state = CAPTURE_STATE_ARMED;
+    return 0;
+}
+
+// 写入一个原始样本
+bool TriggerCapturePush(TriggerCapture* capture, const SensorData* data)
+{
+    if (capture->slots == NULL || capture->state == CAPTURE_STATE_COMPLETE) {
+        return false;
+    }
+
+    // 触发后窗口结束后的样本不再属于本次捕获
+    if (capture->state == CAPTURE_STATE_TRIGGERED &&
+        data->timestamp > capture->trigger_ts + capture->post_us) {
+        capture->state = CAPTURE_STATE_COMPLETE;
+        return true;
+    }
+
+    memcpy(&capture->slots[capture->head], data, sizeof(SensorData));
+    capture->head = (capture->head + 1) % capture->capacity;
+    if (capture->count < capture->capacity) {
+        capture->count++;
+    }
+
+    // 触发后写满时提前结束, 不能覆盖触发前的样本
+    if (capture->state == CAPTURE_STATE_TRIGGERED && capture->count == capture->capacity) {
+        capture->state = CAPTURE_STATE_COMPLETE;
+        capture->truncated = true;
+        return true;
+    }
+
+    return false;
+}
+
+// 触发捕获
+int TriggerCaptureFire(TriggerCapture* capture, uint64_t trigger_ts)
+{
+    if (capture->slots == NULL || capture->state != CAPTURE_STATE_ARMED) {
+        return -1;
+    }
+
+    // 丢弃早于触发前窗口的样本
+    uint64_t since = trigger_ts > capture->pre_us ? trigger_ts - capture->pre_us : 0;
+    while (capture->count > 0 && capture->slots[Oldest(capture)].timestamp < since) {
+        capture->count--;
+    }
+
+    capture->pre_count = capture->count;
+    capture->trigger_ts = trigger_ts;
+    capture->state = CAPTURE_STATE_TRIGGERED;
+
+    // 整个缓冲区都是触发前样本时更早的样本已被覆盖, 且需丢弃最旧的一个才能继续追加
+    capture->truncated = capture->count == capture->capacity;
+    if (capture->truncated) {
+        capture->count--;
+        capture->pre_count--;
+    }
+    return 0;
+}
+
+// 检查触发后窗口是否已结束
+bool TriggerCaptureUpdate(TriggerCapture* capture, uint64_t now)
+{
+    if (capture->state != CAPTURE_STATE_TRIGGERED || now <= capture->trigger_ts + capture->post_us) {
+        return false;
+    }
+
+    capture->state = CAPTURE_STATE_COMPLETE;
+    return true;
+}
+
+// 获取已完成捕获的样本视图
+int TriggerCaptureGet(const TriggerCapture* capture, CaptureView* view)
+{
+    if (capture == NULL || view == NULL || capture->state != CAPTURE_STATE_COMPLETE) {
+        return -1;
+    }
+
+    // 缓冲区回绕时样本分为两段, 第一段在前
+    uint32_t oldest = Oldest(capture);
+    uint32_t first = capture->capacity - oldest;
+    if (first > capture->count) {
+        first = capture->count;
+    }
+
+    memset(view, 0, sizeof(CaptureView));
+    view->trigger_ts = capture->trigger_ts;
+    view->pre_count = capture->pre_count;
+    view->part[0] = &capture->slots[oldest];
+    view->count[0] = first;
+    view->part[1] = capture->slots;
+    view->count[1] = capture->count - first;
+    view->truncated = capture->truncated;
+    return 0;
+}
+
+// 释放已完成的捕获
+void TriggerCaptureRearm(TriggerCapture* capture)
+{
+    if (capture->state == CAPTURE_STATE_COMPLETE) {
+        capture->state = CAPTURE_STATE_ARMED;
+    }
+}
+
+// 释放触发捕获缓冲区
+void TriggerCaptureDeinit(TriggerCapture* capture)
+{
+    if (capture == NULL) {
+        return;
+    }
+
+    free(capture->slots);
+    memset(capture, 0, sizeof(TriggerCapture));
+}
@@ -0,0 +1,394 @@
+#include "data/ts_block.h"
+#include <stdlib.h>
+#include <string.h>
+#include "data/sample_store.h"
+#include "common/clock.h"
+
+// 块数据区的比特容量
+#define TS_BLOCK_BITS (TS_BLOCK_DATA_SIZE * 8)
+
+// 写入count个比特(高位在前)
+static void WriteBits(TsBlock* block, uint32_t value, uint32_t count)
+{
+    for (uint32_t i = count; i > 0; i--) {
+        uint32_t pos = block->bit_len++;
+        uint8_t mask = (uint8_t)(0x80 >> (pos & 7));
+        if ((value >> (i - 1)) & 1) {
+            block->data[pos >> 3] |= mask;
+        } else {
+            block->data[pos >> 3] &= (uint8_t)~mask;
+        }
+    }
+}
+
+// 读取count个比特(高位在前)
+static uint32_t ReadBits(TsBlockReader* reader, uint32_t count)
+{
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t pos = reader->bit_pos++;
+        value = (value << 1) | ((reader->block->data[pos >> 3] >> (7 - (pos & 7))) & 1);
+    }
+
+    return value;
+}
+
+// 读取前缀码, 返回前缀中连续1的个数(最多max_ones个)
+static uint32_t ReadPrefix(TsBlockReader* reader, uint32_t max_ones)
+{
+    uint32_t ones = 0;
+
+    while (ones < max_ones && ReadBits(reader, 1) == 1) {
+        ones++;
+    }
+
+    return ones;
+}
+
+// 时间差的差值编码所需比特数
+static uint32_t TimestampBits(int32_t dod)
+{
+    if (dod == 0) {
+        return 1;
+    }
+    if (dod >= -63 && dod <= 64) {
+        return 2 + 7;
+    }
+    if (dod >= -255 && dod <= 256) {
+        return 3 + 9;
+    }
+    if (dod >= -2047 && dod <= 2048) {
+        return 4 + 12;
+    }
+    return 4 + 32;
+}
+
+// 定点值差值编码所需比特数
+static uint32_t ValueBits(int32_t diff)
+{
+    if (diff == 0) {
+        return 1;
+    }
+    if (diff >= -8 && diff <= 7) {
+        return 2 + 4;
+    }
+    if (diff >= -128 && diff <= 127) {
+        return 3 + 8;
+    }
+    if (diff >= -2048 && diff <= 2047) {
+        return 4 + 12;
+    }
+    return 4 + 16;
+}
+
+// 写入时间差的差值
+static void WriteTimestamp(TsBlock* block, int32_t dod)
+{
+    if (dod == 0) {
+        WriteBits(block, 0x0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        WriteBits(block, 0x2, 2);
+        WriteBits(block, (uint32_t)(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+        WriteBits(block, 0x6, 3);
+        WriteBits(block, (uint32_t)(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+        WriteBits(block, 0xE, 4);
+        WriteBits(block, (uint32_t)(dod + 2047), 12);
+    } else {
+        WriteBits(block, 0xF, 4);
+        WriteBits(block, (uint32_t)dod, 32);
+    }
+}
+
+// 写入定点值, 差值过大时直接写入原值
+static void WriteValue(TsBlock* block, int32_t diff, int16_t value)
+{
+    if (diff == 0) {
+        WriteBits(block, 0x0, 1);
+    } else if (diff >= -8 && diff <= 7) {
+        WriteBits(block, 0x2, 2);
+        WriteBits(block, (uint32_t)(diff + 8), 4);
+    } else if (diff >= -128 && diff <= 127) {
+        WriteBits(block, 0x6, 3);
+        WriteBits(block, (uint32_t)(diff + 128), 8);
+    } else if (diff >= -2048 && diff <= 2047) {
+        WriteBits(block, 0xE, 4);
+        WriteBits(block, (uint32_t)(diff + 2048), 12);
+    } else {
+        WriteBits(block, 0xF, 4);
+        WriteBits(block, (uint16_t)value, 16);
+    }
+}
+
+// 初始化块写入器
+void TsBlockWriterInit(TsBlockWriter* writer, TsBlock* block)
+{
+    memset(block, 0, sizeof(TsBlock));
+    writer->block = block;
+    writer->prev_ts = 0;
+    writer->prev_delta = 0;
+    writer->prev_value = 0;
+}
+
+// 追加一个样本
+int TsBlockAppend(TsBlockWriter* writer, uint64_t ts, int16_t value)
+{
+    TsBlock* block = writer->block;
+
+    if (block->count == UINT16_MAX) {
+        return -1;
+    }
+
+    // 第一个样本: 时间戳记录在块头, 数值直接写入
+    if (block->count == 0) {
+        block->start_ts = ts;
+        WriteBits(block, (uint16_t)value, 16);
+    } else {
+        // 时间倒退或间隔超出32位时无法差分编码
+        if (ts < writer->prev_ts || ts - writer->prev_ts > INT32_MAX) {
+            return -1;
+        }
+
+        int32_t delta = (int32_t)(ts - writer->prev_ts);
+        int32_t dod = delta - writer->prev_delta;
+        int32_t diff = (int32_t)value - writer->prev_value;
+        if (block->bit_len + TimestampBits(dod) + ValueBits(diff) > TS_BLOCK_BITS) {
+            return -1;
+        }
+
+        WriteTimestamp(block, dod);
+        WriteValue(block, diff, value);
+        writer->prev_delta = delta;
+    }
+
+    writer->prev_ts = ts;
+    writer->prev_value = value;
+    block->end_ts = ts;
+    block->count++;
+    return 0;
+}
+
+// 初始化块解码器
+void TsBlockReaderInit(TsBlockReader* reader, const TsBlock* block)
+{
+    memset(reader, 0, sizeof(TsBlockReader));
+    reader->block = block;
+}
+
+// 顺序解码下一个样本
+bool TsBlockReaderNext(TsBlockReader* reader, uint64_t* ts, int16_t* value)
+{
+    const TsBlock* block = reader->block;
+
+    if (reader->index >= block->count) {
+        return false;
+    }
+
+    if (reader->index == 0) {
+        reader->ts = block->start_ts;
+        reader->value = (int16_t)ReadBits(reader, 16);
+    } else {
+        // 时间差的差值
+        int32_t dod = 0;
+        switch (ReadPrefix(reader, 4)) {
+            case 0:
+                break;
+            case 1:
+                dod = (int32_t)ReadBits(reader, 7) - 63;
+                break;
+            case 2:
+                dod = (int32_t)ReadBits(reader, 9) - 255;
+                break;
+            case 3:
+                dod = (int32_t)ReadBits(reader, 12) - 2047;
+                break;
+            default:
+                dod = (int32_t)ReadBits(reader, 32);
+                break;
+        }
+        reader->delta += dod;
+        reader->ts += (uint32_t)reader->delta;
+
+        // 定点值差值
+        switch (ReadPrefix(reader, 4)) {
+            case 0:
+                break;
+            case 1:
+                reader->value = (int16_t)(reader->value + (int32_t)ReadBits(reader, 4) - 8);
+                break;
+            case 2:
+                reader->value = (int16_t)(reader->value + (int32_t)ReadBits(reader, 8) - 128);
+                break;
+            case 3:
+                reader->value = (int16_t)(reader->value + (int32_t)ReadBits(reader, 12) - 2048);
+                break;
+            default:
+                reader->value = (int16_t)ReadBits(reader, 16);
+                break;
+        }
+    }
+
+    reader->index++;
+    *ts = reader->ts;
+    *value = reader->value;
+    return true;
+}
+
+// 解码块内的时间范围
+uint32_t TsBlockQuery(const TsBlock* block, SensorChannel channel, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count)
+{
+    uint32_t found = 0;
+
+    // 根据块头的时间范围跳过整个块, 不必解码
+    if (block->count == 0 || block->end_ts * CLOCK_US_PER_MS < since_ts ||
+        block->start_ts * CLOCK_US_PER_MS > until_ts) {
+        return 0;
+    }
+
+    TsBlockReader reader;
+    uint64_t ts = 0;
+    int16_t value = 0;
+    TsBlockReaderInit(&reader, block);
+    while (found < max_count && TsBlockReaderNext(&reader, &ts, &value)) {
+        if (ts * CLOCK_US_PER_MS < since_ts) {
+            continue;
+        }
+        if (ts * CLOCK_US_PER_MS > until_ts) {
+            break;
+        }
+        samples[found].timestamp = ts * CLOCK_US_PER_MS;
+        samples[found].value = SampleStoreDecode(channel, value);
+        found++;
+    }
+
+    return found;
+}
+
+// 获取累计序号对应的块下标
+static uint32_t BlockIndex(const TsArchive* archive, uint32_t sequence)
+{
+    uint32_t back = (archive->sequence - sequence) % archive->block_count;
+    return (archive->current + archive->block_count - back) % archive->block_count;
+}
+
+// 初始化压缩归档
+int TsArchiveInit(TsArchive* archive, SensorChannel channel, uint32_t block_count)
+{
+    if (archive == NULL || channel >= SENSOR_CHANNEL_MAX || block_count == 0) {
+        return -1;
+    }
+
+    memset(archive, 0, sizeof(TsArchive));
+    archive->blocks = malloc(sizeof(TsBlock) * block_count);
+    if (archive->blocks == NULL) {
+        return -1;
+    }
+
+    archive->channel = channel;
+    archive->block_count = block_count;
+    archive->used = 1;
+    TsBlockWriterInit(&archive->writer, &archive->blocks[0]);
+    return 0;
+}
+
+// 释放压缩归档
+void TsArchiveDeinit(TsArchive* archive)
+{
+    if (archive == NULL) {
+        return;
+    }
+
+    if (archive->blocks != NULL) {
+        free(archive->blocks);
+        archive->blocks = NULL;
+    }
+    archive->block_count = 0;
+    archive->used = 0;
+}
+
+// 追加一个样本
+int TsArchiveAppend(TsArchive* archive, uint64_t ts, float value)
+{
+    if (archive == NULL || archive->blocks == NULL) {
+        return -1;
+    }
+
+    ts /= CLOCK_US_PER_MS;
+    int16_t fixed = SampleStoreEncode(archive->channel, value);
+    if (TsBlockAppend(&archive->writer, ts, fixed) == 0) {
+        return 0;
+    }
+
+    // 当前块已满(或时间戳倒退), 切换到下一个块, 写满后覆盖最旧的块
+    archive->current = (archive->current + 1) % archive->block_count;
+    archive->sequence++;
+    if (archive->used < archive->block_count) {
+        archive->used++;
+    }
+    TsBlockWriterInit(&archive->writer, &archive->blocks[archive->current]);
+
+    return TsBlockAppend(&archive->writer, ts, fixed);
+}
+
+// 查找第一个包含不早于since_ts的样本的块
+uint32_t TsArchiveSeek(const TsArchive* archive, uint64_t since_ts)
+{
+    if (archive == NULL || archive->blocks == NULL) {
+        return 0;
+    }
+
+    uint32_t sequence = archive->sequence - (archive->used - 1);
+    for (; sequence != archive->sequence + 1; sequence++) {
+        const TsBlock* block = &archive->blocks[BlockIndex(archive, sequence)];
+        if (block->count > 0 && block->end_ts * CLOCK_US_PER_MS >= since_ts) {
+            break;
+        }
+    }
+
+    return sequence;
+}
+
+// 复制块
+int TsArchiveCopyBlock(const TsArchive* archive, uint32_t* sequence, TsBlock* block)
+{
+    if (archive == NULL || archive->blocks == NULL || sequence == NULL || block == NULL) {
+        return -1;
+    }
+
+    uint32_t oldest = archive->sequence - (archive->used - 1);
+    if ((int32_t)(*sequence - oldest) < 0) {
+        *sequence = oldest;
+    }
+    if ((int32_t)(*sequence - archive->sequence) > 0) {
+        return -1;
+    }
+
+    memcpy(block, &archive->blocks[BlockIndex(archive, *sequence)], sizeof(TsBlock));
+    return 0;
+}
+
+// 解码查询
+int TsArchiveQuery(const TsArchive* archive, uint64_t since_ts, uint64_t until_ts,
+    ChannelSample* samples, uint32_t max_count, uint32_t* actual_count)
+{
+    if (archive == NULL || archive->blocks == NULL || samples == NULL || actual_count == NULL) {
+        return -1;
+    }
+
+    uint32_t found = 0;
+    uint32_t oldest = (archive->current + archive->block_count - archive->used + 1) % archive->block_count;
+
+    for (uint32_t i = 0; i < archive->used && found < max_count; i++) {
+        const TsBlock* block = &archive->blocks[(oldest + i) % archive->block_count];
+        if (block->count > 0 && block->start_ts * CLOCK_US_PER_MS > until_ts) {
+            break;
+        }
+        found += TsBlockQuery(block, archive->channel, since_ts, until_ts, &samples[found], max_count - found);
+    }
+
+    *actual_count = found;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "data/virtual_sensor.h"
+#include <math.h>
+#include <string.h>
+
+// Magnus公式系数
+#define MAGNUS_B 17.62f
+#define MAGNUS_C 243.12f
+
+// 计算光照比值时的最小光照强度(lux), 避免黑暗中除以0
+#define RATIO_MIN_LIGHT 1.0f
+
+// 湿度下限(%), 避免对0取对数
+#define MIN_HUMIDITY 0.1f
+
+// 虚拟传感器计算函数
+typedef float (*VirtualComputeFunc)(const SensorData latest[SENSOR_TYPE_MAX]);
+
+// 虚拟传感器定义
+typedef struct {
+    uint32_t inputs;             // 依赖的真实传感器
+    VirtualComputeFunc compute;  // 计算函数
+} VirtualSensorDef;
+
+static float ComputeDewPoint(const SensorData latest[SENSOR_TYPE_MAX])
+{
+    const DHT11Data* dht11 = &latest[SENSOR_TYPE_DHT11].data.dht11;
+    return VirtualDewPoint(dht11->temperature, dht11->humidity);
+}
+
+static float ComputeHeatIndex(const SensorData latest[SENSOR_TYPE_MAX])
+{
+    const DHT11Data* dht11 = &latest[SENSOR_TYPE_DHT11].data.dht11;
+    return VirtualHeatIndex(dht11->temperature, dht11->humidity);
+}
+
+static float ComputeAbsoluteHumidity(const SensorData latest[SENSOR_TYPE_MAX])
+{
+    const DHT11Data* dht11 = &latest[SENSOR_TYPE_DHT11].data.dht11;
+    return VirtualAbsoluteHumidity(dht11->temperature, dht11->humidity);
+}
+
+static float ComputeSmokeLightRatio(const SensorData latest[SENSOR_TYPE_MAX])
+{
+    float light = latest[SENSOR_TYPE_BH1750].data.bh1750.light;
+    return latest[SENSOR_TYPE_MQ2].data.mq2.smoke / (light > RATIO_MIN_LIGHT ? light : RATIO_MIN_LIGHT);
+}
+
+// 虚拟传感器注册表, 按类型顺序排列
+static const VirtualSensorDef g_virtual_sensors[SENSOR_TYPE_VIRTUAL_COUNT] = {
+    {1U << SENSOR_TYPE_DHT11, ComputeDewPoint},
+    {1U << SENSOR_TYPE_DHT11, ComputeHeatIndex},
+    {1U << SENSOR_TYPE_DHT11, ComputeAbsoluteHumidity},
+    {(1U << SENSOR_TYPE_MQ2) | (1U << SENSOR_TYPE_BH1750), ComputeSmokeLightRatio}
+};
+
+// 是否为虚拟传感器
+bool VirtualSensorIsVirtual(SensorType type)
+{
+    return type > SENSOR_TYPE_MAX && type < SENSOR_TYPE_VIRTUAL_MAX;
+}
+
+// 虚拟传感器依赖的真实传感器
+uint32_t VirtualSensorInputMask(SensorType type)
+{
+    if (!VirtualSensorIsVirtual(type)) {
+        return 0;
+    }
+    return g_virtual_sensors[type - SENSOR_TYPE_MAX - 1].inputs;
+}
+
+// 计算虚拟传感器的值
+int VirtualSensorCompute(SensorType type, const SensorData latest[SENSOR_TYPE_MAX], SensorData* data)
+{
+    if (!VirtualSensorIsVirtual(type) || latest == NULL || data == NULL) {
+        return -1;
+    }
+
+    const VirtualSensorDef* def = &g_virtual_sensors[type - SENSOR_TYPE_MAX - 1];
+    memset(data, 0, sizeof(SensorData));
+    data->type = type;
+    data->data.derived.value = def->compute(latest);
+    for (SensorType input = SENSOR_TYPE_DHT11; input < SENSOR_TYPE_MAX; input++) {
+        if ((def->inputs & (1U << input)) && latest[input].timestamp > data->timestamp) {
+            data->timestamp = latest[input].timestamp;
+        }
+    }
+
+    return 0;
+}
+
+// 露点
+float VirtualDewPoint(float temperature, float humidity)
+{
+    if (humidity < MIN_HUMIDITY) {
+        humidity = MIN_HUMIDITY;
+    }
+
+    float gamma = logf(humidity / 100.0f) + MAGNUS_B * temperature / (MAGNUS_C + temperature);
+    return MAGNUS_C * gamma / (MAGNUS_B - gamma);
+}
+
+// 体感温度
+float VirtualHeatIndex(float temperature, float humidity)
+{
+    float t = temperature * 1.8f + 32.0f;
+    float rh = humidity;
+
+    // 先用简化公式, 结果低于80℉时直接采用
+    float hi = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + rh * 0.094f);
+    if ((hi + t) / 2.0f >= 80.0f) {
+        // Rothfusz回归式
+        hi = -42.379f + 2.04901523f * t + 10.14333127f * rh - 0.22475541f * t * rh -
+            0.00683783f * t * t - 0.05481717f * rh * rh + 0.00122874f * t * t * rh +
+            0.00085282f * t * rh * rh - 0.00000199f * t * t * rh * rh;
+
+        // 低湿度和高湿度修正
+        if (rh < 13.0f && t >= 80.0f && t <= 112.0f) {
+            hi -= (13.0f - rh) / 4.0f * sqrtf((17.0f - fabsf(t - 95.0f)) / 17.0f);
+        } else if (rh > 85.0f && t >= 80.0f && t <= 87.0f) {
+            hi += (rh - 85.0f) / 10.0f * (87.0f - t) / 5.0f;
+        }
+    }
+
+    return (hi - 32.0f) / 1.8f;
+}
+
+// 绝对湿度: 饱和水汽压乘以相对湿度, 再按理想气体换算为水汽密度
+float VirtualAbsoluteHumidity(float temperature, float humidity)
+{
+    float saturation = 6.112f * expf(17.67f * temperature / (temperature + 243.5f));
+    return saturation * humidity * 2.1674f / (273.15f + temperature);
+}
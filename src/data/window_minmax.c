@@ -0,0 +1,190 @@
+#include "data/window_minmax.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 获取队列中第index个样本
+static ChannelSample* DequeAt(const MonoDeque* deque, uint32_t index)
+{
+    return &deque->items[(deque->head + index) % deque->capacity];
+}
+
+// 移除队首样本
+static void DequePopFront(MonoDeque* deque)
+{
+    deque->head = (deque->head + 1) % deque->capacity;
+    deque->count--;
+}
+
+// 因队列容量不足丢弃队首样本, 记录极值恢复准确的时间
+static void DequeDropFront(WindowMinMax* win, MonoDeque* deque)
+{
+    uint64_t until = DequeAt(deque, 0)->timestamp + win->window;
+    if (until > win->overflow_until) {
+        win->overflow_until = until;
+    }
+    DequePopFront(deque);
+}
+
+// 移除窗口外的样本
+static void DequeExpire(MonoDeque* deque, uint64_t timestamp, uint64_t window)
+{
+    while (deque->count > 0 && timestamp - DequeAt(deque, 0)->timestamp >= window) {
+        DequePopFront(deque);
+    }
+}
+
+// 从队尾压入样本, 先弹出被新样本支配的候选
+// keep_max为true时维护最大值队列, 否则维护最小值队列
+static void DequePush(WindowMinMax* win, MonoDeque* deque, uint64_t timestamp, float value, bool keep_max)
+{
+    while (deque->count > 0) {
+        float back = DequeAt(deque, deque->count - 1)->value;
+        if (keep_max ? back > value : back < value) {
+            break;
+        }
+        deque->count--;
+    }
+
+    if (deque->count == deque->capacity) {
+        DequeDropFront(win, deque);
+    }
+
+    ChannelSample* item = DequeAt(deque, deque->count);
+    item->timestamp = timestamp;
+    item->value = value;
+    deque->count++;
+}
+
+// 修改单个队列的容量
+static int DequeResize(WindowMinMax* win, MonoDeque* deque, uint32_t capacity)
+{
+    ChannelSample* items = malloc(sizeof(ChannelSample) * capacity);
+    if (items == NULL) {
+        return -1;
+    }
+
+    while (deque->count > capacity) {
+        DequeDropFront(win, deque);
+    }
+    for (uint32_t i = 0; i < deque->count; i++) {
+        items[i] = *DequeAt(deque, i);
+    }
+
+    free(deque->items);
+    deque->items = items;
+    deque->capacity = capacity;
+    deque->head = 0;
+    return 0;
+}
+
+// 初始化滑动窗口
+int WindowMinMaxInit(WindowMinMax* win, uint64_t window, uint32_t capacity)
+{
+    if (win == NULL || window == 0 || capacity == 0) {
+        return -1;
+    }
+
+    memset(win, 0, sizeof(WindowMinMax));
+    win->min.items = malloc(sizeof(ChannelSample) * capacity);
+    win->max.items = malloc(sizeof(ChannelSample) * capacity);
+    if (win->min.items == NULL || win->max.items == NULL) {
+        WindowMinMaxDeinit(win);
+        return -1;
+    }
+
+    win->window = window;
+    win->min.capacity = capacity;
+    win->max.capacity = capacity;
+    return 0;
+}
+
+// 释放滑动窗口
+void WindowMinMaxDeinit(WindowMinMax* win)
+{
+    if (win == NULL) {
+        return;
+    }
+
+    if (win->min.items != NULL) {
+        free(win->min.items);
+        win->min.items = NULL;
+    }
+    if (win->max.items != NULL) {
+        free(win->max.items);
+        win->max.items = NULL;
+    }
+    win->min.capacity = 0;
+    win->max.capacity = 0;
+    WindowMinMaxReset(win);
+}
+
+// 清空窗口内的样本
+void WindowMinMaxReset(WindowMinMax* win)
+{
+    win->min.head = 0;
+    win->min.count = 0;
+    win->max.head = 0;
+    win->max.count = 0;
+    win->last_ts = 0;
+    win->overflow_until = 0;
+}
+
+// 修改窗口长度
+void WindowMinMaxSetWindow(WindowMinMax* win, uint64_t window)
+{
+    if (window == 0) {
+        return;
+    }
+
+    // 窗口变长时被丢弃的样本在窗口内停留得更久
+    if (window > win->window && win->overflow_until != 0) {
+        win->overflow_until += window - win->window;
+    }
+    win->window = window;
+}
+
+// 修改队列容量
+int WindowMinMaxResize(WindowMinMax* win, uint32_t capacity)
+{
+    if (win == NULL || capacity == 0 || win->min.items == NULL || win->max.items == NULL) {
+        return -1;
+    }
+
+    if (capacity != win->min.capacity && DequeResize(win, &win->min, capacity) != 0) {
+        return -1;
+    }
+    if (capacity != win->max.capacity && DequeResize(win, &win->max, capacity) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// 输入一个样本
+void WindowMinMaxPush(WindowMinMax* win, uint64_t timestamp, float value)
+{
+    if (win->min.items == NULL || win->max.items == NULL) {
+        return;
+    }
+
+    DequeExpire(&win->min, timestamp, win->window);
+    DequeExpire(&win->max, timestamp, win->window);
+    DequePush(win, &win->min, timestamp, value, false);
+    DequePush(win, &win->max, timestamp, value, true);
+    win->last_ts = timestamp;
+}
+
+// 获取窗口内的最小/最大值样本
+bool WindowMinMaxGet(const WindowMinMax* win, ChannelSample* min, ChannelSample* max)
+{
+    if (win->min.count == 0 || win->max.count == 0 || win->last_ts < win->overflow_until) {
+        return false;
+    }
+
+    if (min != NULL) {
+        memcpy(min, DequeAt(&win->min, 0), sizeof(ChannelSample));
+    }
+    if (max != NULL) {
+        memcpy(max, DequeAt(&win->max, 0), sizeof(ChannelSample));
+    }
+    return true;
+}
@@ -3,6 +3,7 @@
 #include "iot_gpio.h"
 #include "iot_errno.h"
 #include "drivers/output/relay.h"
+#include "common/clock.h"
 
 // GPIO引脚定义
 #define RELAY_GPIO_PIN      10    // 继电器控制引脚
@@ -89,7 +90,7 @@ static int SetFanGpio(FanSpeed speed)
 static void CheckRelayStatus(void)
 {
     if (g_relay_state == RELAY_STATE_ON) {
-        uint32_t current_time = (uint32_t)time(NULL) * 1000;  // 转换为毫秒
+        uint32_t current_time = ClockNowMs();  // 无符号差值可正确处理回绕
         if (current_time - g_relay_on_time > RELAY_PROTECT_TIMEOUT) {
             // 超时保护
             RelaySetState(RELAY_STATE_OFF);
@@ -143,7 +144,7 @@ int RelaySetState(RelayState state)
 
     g_relay_state = state;
     if (state == RELAY_STATE_ON) {
-        g_relay_on_time = (uint32_t)time(NULL) * 1000;  // 记录开启时间
+        g_relay_on_time = ClockNowMs();  // 记录开启时间(ms)
     }
 
     return IOT_SUCCESS;
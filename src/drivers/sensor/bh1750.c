@@ -1,11 +1,25 @@
 #include <stdio.h>
 #include <unistd.h>
 #include "drivers/sensor/bh1750.h"
+#include "drivers/sensor/sensor.h"
+#include "common/clock.h"
 #include "iot_i2c.h"
 
 #define BH1750_I2C_IDX     0    // I2C设备索引
 #define BH1750_I2C_BAUDRATE 100000  // 100KHz
 
+// 单次转换结果在完成后的有效期(ms), 超过后再次触发时重新转换
+#define BH1750_RESULT_TTL_MS BH1750_CONVERSION_MS
+
+// 单次转换状态
+#define BH1750_ONESHOT_IDLE         0   // 未触发
+#define BH1750_ONESHOT_STARTING     1   // 正在发送触发命令
+#define BH1750_ONESHOT_CONVERTING   2   // 转换中或结果待读取
+
+// 单次转换状态由采集任务和按需读取的任务共享, 原子访问
+static uint32_t g_oneshot_state = BH1750_ONESHOT_IDLE;
+static uint32_t g_oneshot_ready_us = 0;    // 转换完成时间(us), 只用于计算差值
+
 // 写命令
 static int bh1750_write_cmd(uint8_t cmd)
 {
@@ -47,10 +61,10 @@ int BH1750Init(void)
     return 0;
 }
 
-// 获取BH1750传感器数据
-int BH1750GetData(float* light)
+// 获取BH1750原始计数
+int BH1750GetRaw(uint16_t* count)
 {
-    if (light == NULL) {
+    if (count == NULL) {
         return -1;
     }
     
@@ -60,8 +74,23 @@ int BH1750GetData(float* light)
         return -1;
     }
     
+    *count = (data[0] << 8) | data[1];
+    return 0;
+}
+
+// 获取BH1750传感器数据
+int BH1750GetData(float* light)
+{
+    if (light == NULL) {
+        return -1;
+    }
+    
+    uint16_t value;
+    if (BH1750GetRaw(&value) != 0) {
+        return -1;
+    }
+    
     // 计算光照强度(单位:lx)
-    uint16_t value = (data[0] << 8) | data[1];
     *light = (float)value / 1.2f;
     
     return 0;
@@ -81,3 +110,179 @@ int BH1750Deinit(void)
     
     return 0;
 }
+
+// 以单次测量模式初始化BH1750传感器
+int BH1750InitOneShot(void)
+{
+    IoTI2cInit(BH1750_I2C_IDX, BH1750_I2C_BAUDRATE);
+    
+    // 开启并重置数据寄存器后断电, 每次测量时再上电
+    if (bh1750_write_cmd(BH1750_POWER_ON) != 0 || bh1750_write_cmd(BH1750_RESET) != 0 ||
+        bh1750_write_cmd(BH1750_POWER_DOWN) != 0) {
+        printf("BH1750 init failed\n");
+        return -1;
+    }
+    
+    __atomic_store_n(&g_oneshot_state, BH1750_ONESHOT_IDLE, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 触发单次转换
+int BH1750StartOneShot(void)
+{
+    uint32_t now = (uint32_t)ClockNowUs();
+    uint32_t state = __atomic_load_n(&g_oneshot_state, __ATOMIC_ACQUIRE);
+    
+    // 共用进行中或刚完成的转换
+    if (state == BH1750_ONESHOT_STARTING) {
+        return 0;
+    }
+    if (state == BH1750_ONESHOT_CONVERTING &&
+        (int32_t)(now - __atomic_load_n(&g_oneshot_ready_us, __ATOMIC_RELAXED)) <=
+        (int32_t)(BH1750_RESULT_TTL_MS * CLOCK_US_PER_MS)) {
+        return 0;
+    }
+    if (!__atomic_compare_exchange_n(&g_oneshot_state, &state, BH1750_ONESHOT_STARTING, false,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    
+    // 单次模式测量完成后自动断电, 需先上电
+    if (bh1750_write_cmd(BH1750_POWER_ON) != 0 || bh1750_write_cmd(BH1750_ONE_H_MODE) != 0) {
+        printf("BH1750 start conversion failed\n");
+        __atomic_store_n(&g_oneshot_state, BH1750_ONESHOT_IDLE, __ATOMIC_RELEASE);
+        return -1;
+    }
+    
+    __atomic_store_n(&g_oneshot_ready_us, (uint32_t)ClockNowUs() + BH1750_CONVERSION_MS * CLOCK_US_PER_MS,
+        __ATOMIC_RELAXED);
+    __atomic_store_n(&g_oneshot_state, BH1750_ONESHOT_CONVERTING, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 读取单次转换结果
+int BH1750ReadOneShot(uint16_t* count)
+{
+    if (count == NULL) {
+        return -1;
+    }
+    
+    uint32_t state = __atomic_load_n(&g_oneshot_state, __ATOMIC_ACQUIRE);
+    if (state == BH1750_ONESHOT_STARTING) {
+        return 1;
+    }
+    if (state != BH1750_ONESHOT_CONVERTING) {
+        return -1;
+    }
+    if ((int32_t)((uint32_t)ClockNowUs() - __atomic_load_n(&g_oneshot_ready_us, __ATOMIC_RELAXED)) < 0) {
+        return 1;
+    }
+    
+    // 结果只读取一次, 下次测量重新触发
+    if (!__atomic_compare_exchange_n(&g_oneshot_state, &state, BH1750_ONESHOT_IDLE, false,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return 1;
+    }
+    return BH1750GetRaw(count);
+}
+
+static sensor_status_t bh1750_init(void)
+{
+    return BH1750Init() == 0 ? SENSOR_OK : SENSOR_ERROR_TIMEOUT;
+}
+
+static sensor_status_t bh1750_read(sensor_data_t* data)
+{
+    if (data == NULL || BH1750GetData(&data->light) != 0) {
+        return SENSOR_ERROR_DATA;
+    }
+    return SENSOR_OK;
+}
+
+static sensor_status_t bh1750_read_channels(sensor_raw_t* raw)
+{
+    uint16_t count = 0;
+
+    if (raw == NULL || BH1750GetRaw(&count) != 0) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    raw->mask = 1U << SENSOR_RAW_LIGHT;
+    raw->value[SENSOR_RAW_LIGHT] = count;
+    return SENSOR_OK;
+}
+
+static sensor_status_t bh1750_deinit(void)
+{
+    return BH1750Deinit() == 0 ? SENSOR_OK : SENSOR_ERROR_TIMEOUT;
+}
+
+// 导出BH1750操作接口
+const sensor_ops_t bh1750_ops = {
+    .type = SENSOR_TYPE_LIGHT,
+    .init = bh1750_init,
+    .read = bh1750_read,
+    .deinit = bh1750_deinit,
+    .read_raw = bh1750_read_channels,
+    .caps = {0, SENSOR_BUS_I2C, 0}
+};
+
+static sensor_status_t bh1750_oneshot_init(void)
+{
+    return BH1750InitOneShot() == 0 ? SENSOR_OK : SENSOR_ERROR_TIMEOUT;
+}
+
+static sensor_status_t bh1750_oneshot_start(void)
+{
+    return BH1750StartOneShot() == 0 ? SENSOR_OK : SENSOR_ERROR_TIMEOUT;
+}
+
+static sensor_status_t bh1750_oneshot_read_channels(sensor_raw_t* raw)
+{
+    uint16_t count = 0;
+
+    if (raw == NULL) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    int ret = BH1750ReadOneShot(&count);
+    if (ret != 0) {
+        return ret > 0 ? SENSOR_ERROR_BUSY : SENSOR_ERROR_DATA;
+    }
+
+    raw->mask = 1U << SENSOR_RAW_LIGHT;
+    raw->value[SENSOR_RAW_LIGHT] = count;
+    return SENSOR_OK;
+}
+
+// 同步读取: 触发转换后等待转换完成
+static sensor_status_t bh1750_oneshot_read(sensor_data_t* data)
+{
+    sensor_raw_t raw;
+
+    if (data == NULL || bh1750_oneshot_start() != SENSOR_OK) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    sensor_status_t status;
+    while ((status = bh1750_oneshot_read_channels(&raw)) == SENSOR_ERROR_BUSY) {
+        usleep(10 * 1000);
+    }
+    if (status != SENSOR_OK) {
+        return status;
+    }
+
+    data->light = (float)raw.value[SENSOR_RAW_LIGHT] / 1.2f;
+    return SENSOR_OK;
+}
+
+// 导出BH1750单次测量模式操作接口
+const sensor_ops_t bh1750_oneshot_ops = {
+    .type = SENSOR_TYPE_LIGHT,
+    .init = bh1750_oneshot_init,
+    .read = bh1750_oneshot_read,
+    .deinit = bh1750_deinit,
+    .read_raw = bh1750_oneshot_read_channels,
+    .caps = {0, SENSOR_BUS_I2C, SENSOR_CAP_ASYNC, BH1750_CONVERSION_MS},
+    .start = bh1750_oneshot_start
+};
@@ -1,22 +1,19 @@
 #include <stdio.h>
 #include <unistd.h>
 #include "drivers/sensor/sensor.h"
+#include "drivers/sensor/dht11.h"
+#include "drivers/sensor/dht11_decode.h"
+#include "cmsis_os2.h"
+#include "common/clock.h"
 #include "hi_gpio.h"
 #include "hi_time.h"
 
 // DHT11 GPIO引脚定义
 #define DHT11_GPIO_PIN          11    // GPIO11用于DHT11
-#define DHT11_TIMEOUT_MS        1000  // 超时时间1秒
 
-// DHT11内部延时参数（微秒）
+// DHT11时序参数
 #define DHT11_START_SIGNAL_MS   20    // 起始信号持续20ms
-#define DHT11_RESPONSE_US       40    // 响应信号40us
-#define DHT11_DATA_BIT_US       50    // 数据位信号50us
-
-// 私有函数声明
-static sensor_status_t dht11_reset(void);
-static sensor_status_t dht11_read_byte(uint8_t* data);
-static uint8_t dht11_check_sum(uint8_t* data, int len);
+#define DHT11_DEADLINE_US       8000  // 释放数据线后整个传输的截止时间(us), 标称约4.5ms
 
 // GPIO操作封装
 static sensor_status_t gpio_init(void)
@@ -37,12 +34,41 @@ static void gpio_set_output(uint8_t level)
     hi_gpio_set_ouput_val(DHT11_GPIO_PIN, level);
 }
 
-static uint8_t gpio_read_input(void)
+// 记录数据线边沿及其时间, 直到收齐一帧或到达截止时间
+static uint32_t gpio_capture_edges(DHT11Edge* edges, uint32_t max_count)
 {
+    hi_gpio_value level = HI_GPIO_VALUE1;
     hi_gpio_value val;
+    uint32_t count = 0;
+
     hi_gpio_set_dir(DHT11_GPIO_PIN, HI_GPIO_DIR_IN);
-    hi_gpio_get_input_val(DHT11_GPIO_PIN, &val);
-    return (uint8_t)val;
+
+    // 采集期间禁止任务切换, 中断造成的个别脉宽偏差由解码按范围判定
+    int32_t lock = osKernelLock();
+    uint32_t start = (uint32_t)ClockNowUs();
+    for (;;) {
+        uint32_t now = (uint32_t)ClockNowUs();
+        if (now - start > DHT11_DEADLINE_US) {
+            break;
+        }
+
+        hi_gpio_get_input_val(DHT11_GPIO_PIN, &val);
+        if (val == level) {
+            continue;
+        }
+        level = val;
+        edges[count].time_us = now;
+        edges[count].level = (uint8_t)val;
+        count++;
+
+        // 第一个边沿是响应的下降沿时收齐即可结束
+        if (count == max_count || (count == DHT11_EDGE_COUNT && edges[0].level == 0)) {
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+
+    return count;
 }
 
 // DHT11初始化
@@ -59,39 +85,51 @@ static sensor_status_t dht11_init(void)
     return SENSOR_OK;
 }
 
+// DHT11原始数据读取, 转换为0.1℃/0.1%为单位的整数
+// 起始信号之后只在截止时间内记录边沿, 再按脉宽解码, 整个读取的耗时有上限
+static sensor_status_t dht11_read_raw(int16_t* temperature, int16_t* humidity)
+{
+    DHT11Edge edges[DHT11_EDGE_COUNT + 1];  // 可能多记录一个主机释放数据线的边沿
+    uint8_t frame[DHT11_FRAME_BYTES];
+
+    // 发送起始信号: 拉低至少18ms后释放数据线
+    gpio_set_output(0);
+    usleep(DHT11_START_SIGNAL_MS * 1000);
+    gpio_set_output(1);
+
+    uint32_t count = gpio_capture_edges(edges, DHT11_EDGE_COUNT + 1);
+    switch (DHT11Decode(edges, count, frame)) {
+        case DHT11_DECODE_OK:
+            break;
+        case DHT11_DECODE_SHORT:
+            return SENSOR_ERROR_TIMEOUT;
+        case DHT11_DECODE_CHECKSUM:
+            return SENSOR_ERROR_CHECKSUM;
+        default:
+            return SENSOR_ERROR_DATA;
+    }
+
+    DHT11FrameToRaw(frame, temperature, humidity);
+    return SENSOR_OK;
+}
+
 // DHT11数据读取
 static sensor_status_t dht11_read(sensor_data_t* data)
 {
-    uint8_t raw_data[5] = {0};  // DHT11原始数据
-    sensor_status_t status;
+    int16_t temperature = 0;
+    int16_t humidity = 0;
     
     if (data == NULL) {
         return SENSOR_ERROR_DATA;
     }
 
-    // 发送起始信号
-    status = dht11_reset();
+    sensor_status_t status = dht11_read_raw(&temperature, &humidity);
     if (status != SENSOR_OK) {
         return status;
     }
 
-    // 读取5字节数据
-    for (int i = 0; i < 5; i++) {
-        status = dht11_read_byte(&raw_data[i]);
-        if (status != SENSOR_OK) {
-            return status;
-        }
-    }
-
-    // 校验数据
-    if (!dht11_check_sum(raw_data, 5)) {
-        return SENSOR_ERROR_CHECKSUM;
-    }
-
-    // 解析数据
-    data->humidity = (float)raw_data[0] + raw_data[1] * 0.1f;
-    data->temperature = (float)raw_data[2] + raw_data[3] * 0.1f;
-    
+    data->humidity = humidity * 0.1f;
+    data->temperature = temperature * 0.1f;
     return SENSOR_OK;
 }
 
@@ -102,92 +140,61 @@ static sensor_status_t dht11_deinit(void)
     return SENSOR_OK;
 }
 
-// DHT11复位和响应检测
-static sensor_status_t dht11_reset(void)
+// 初始化DHT11传感器
+int DHT11Init(void)
 {
-    uint32_t timeout = 0;
-    
-    // 发送起始信号
-    gpio_set_output(0);
-    usleep(DHT11_START_SIGNAL_MS * 1000);
-    gpio_set_output(1);
-    usleep(30);  // 等待30us
-    
-    // 等待DHT11响应
-    while (gpio_read_input() == 1) {
-        if (++timeout > DHT11_TIMEOUT_MS) {
-            return SENSOR_ERROR_TIMEOUT;
-        }
-        usleep(1);
-    }
-    
-    timeout = 0;
-    while (gpio_read_input() == 0) {
-        if (++timeout > DHT11_TIMEOUT_MS) {
-            return SENSOR_ERROR_TIMEOUT;
-        }
-        usleep(1);
-    }
-    
-    timeout = 0;
-    while (gpio_read_input() == 1) {
-        if (++timeout > DHT11_TIMEOUT_MS) {
-            return SENSOR_ERROR_TIMEOUT;
-        }
-        usleep(1);
+    return dht11_init() == SENSOR_OK ? 0 : -1;
+}
+
+// 获取DHT11传感器数据
+int DHT11GetData(float* temperature, float* humidity)
+{
+    sensor_data_t data;
+
+    if (temperature == NULL || humidity == NULL || dht11_read(&data) != SENSOR_OK) {
+        return -1;
     }
-    
-    return SENSOR_OK;
+
+    *temperature = data.temperature;
+    *humidity = data.humidity;
+    return 0;
 }
 
-// 读取一个字节数据
-static sensor_status_t dht11_read_byte(uint8_t* data)
+// 获取DHT11原始读数
+int DHT11GetRaw(int16_t* temperature, int16_t* humidity)
 {
-    uint8_t bit;
-    uint8_t byte = 0;
-    uint32_t timeout;
-    
-    for (int i = 0; i < 8; i++) {
-        // 等待50us低电平开始
-        timeout = 0;
-        while (gpio_read_input() == 0) {
-            if (++timeout > DHT11_TIMEOUT_MS) {
-                return SENSOR_ERROR_TIMEOUT;
-            }
-            usleep(1);
-        }
-        
-        // 延时40us
-        usleep(40);
-        
-        // 读取数据位
-        bit = gpio_read_input();
-        
-        // 等待高电平结束
-        timeout = 0;
-        while (gpio_read_input() == 1) {
-            if (++timeout > DHT11_TIMEOUT_MS) {
-                return SENSOR_ERROR_TIMEOUT;
-            }
-            usleep(1);
-        }
-        
-        byte <<= 1;
-        if (bit) {
-            byte |= 1;
-        }
+    if (temperature == NULL || humidity == NULL) {
+        return -1;
     }
-    
-    *data = byte;
-    return SENSOR_OK;
+
+    return dht11_read_raw(temperature, humidity) == SENSOR_OK ? 0 : -1;
 }
 
-// 校验和检查
-static uint8_t dht11_check_sum(uint8_t* data, int len)
+// 反初始化DHT11传感器
+int DHT11Deinit(void)
 {
-    if (len != 5) return 0;
-    
-    return (data[0] + data[1] + data[2] + data[3]) == data[4];
+    return dht11_deinit() == SENSOR_OK ? 0 : -1;
+}
+
+// 读取温湿度原始通道
+static sensor_status_t dht11_read_channels(sensor_raw_t* raw)
+{
+    int16_t temperature = 0;
+    int16_t humidity = 0;
+
+    if (raw == NULL) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    sensor_status_t status = dht11_read_raw(&temperature, &humidity);
+    if (status != SENSOR_OK) {
+        return status;
+    }
+
+    raw->mask = (1U << SENSOR_RAW_TEMPERATURE) | (1U << SENSOR_RAW_HUMIDITY);
+    raw->value[SENSOR_RAW_TEMPERATURE] = temperature;
+    raw->value[SENSOR_RAW_HUMIDITY] = humidity;
+    return SENSOR_OK;
 }
 
 // 导出DHT11操作接口
@@ -195,5 +202,7 @@ const sensor_ops_t dht11_ops = {
     .type = SENSOR_TYPE_TEMP_HUMID,
     .init = dht11_init,
     .read = dht11_read,
-    .deinit = dht11_deinit
+    .deinit = dht11_deinit,
+    .read_raw = dht11_read_channels,
+    .caps = {DHT11_MIN_INTERVAL_MS, SENSOR_BUS_GPIO, 0}
 };
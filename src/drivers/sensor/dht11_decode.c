@@ -0,0 +1,67 @@
+#include "drivers/sensor/dht11_decode.h"
+#include <string.h>
+
+// 第index个边沿开始的脉冲宽度, 要求该边沿之后为指定电平
+static int PulseWidth(const DHT11Edge* edges, uint32_t index, uint8_t level, uint32_t min_us, uint32_t max_us,
+    uint32_t* width)
+{
+    if (edges[index].level != level || edges[index + 1].level == level) {
+        return -1;
+    }
+
+    *width = edges[index + 1].time_us - edges[index].time_us;
+    return (*width >= min_us && *width <= max_us) ? 0 : -1;
+}
+
+// 按脉宽解码一帧数据
+DHT11DecodeResult DHT11Decode(const DHT11Edge* edges, uint32_t count, uint8_t frame[DHT11_FRAME_BYTES])
+{
+    uint32_t width;
+    uint32_t start = 0;
+
+    if (edges == NULL || frame == NULL) {
+        return DHT11_DECODE_SHORT;
+    }
+
+    // 从第一个下降沿(传感器响应)开始, 之前可能记录到主机释放数据线的上升沿
+    while (start < count && edges[start].level != 0) {
+        start++;
+    }
+    if (count - start < DHT11_EDGE_COUNT) {
+        return DHT11_DECODE_SHORT;
+    }
+    edges += start;
+
+    // 响应信号: 低电平和高电平各约80us
+    if (PulseWidth(edges, 0, 0, DHT11_RESPONSE_MIN_US, DHT11_RESPONSE_MAX_US, &width) != 0 ||
+        PulseWidth(edges, 1, 1, DHT11_RESPONSE_MIN_US, DHT11_RESPONSE_MAX_US, &width) != 0) {
+        return DHT11_DECODE_TIMING;
+    }
+
+    // 每一位由约50us低电平开始, 随后高电平的宽度决定位值
+    memset(frame, 0, DHT11_FRAME_BYTES);
+    for (uint32_t bit = 0; bit < DHT11_FRAME_BYTES * 8; bit++) {
+        uint32_t index = 2 + bit * 2;
+        if (PulseWidth(edges, index, 0, DHT11_LOW_MIN_US, DHT11_LOW_MAX_US, &width) != 0 ||
+            PulseWidth(edges, index + 1, 1, DHT11_HIGH_MIN_US, DHT11_HIGH_MAX_US, &width) != 0) {
+            return DHT11_DECODE_TIMING;
+        }
+        if (width > DHT11_BIT_THRESHOLD_US) {
+            frame[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+        }
+    }
+
+    // 校验和为前4字节之和的低8位
+    uint8_t sum = (uint8_t)(frame[0] + frame[1] + frame[2] + frame[3]);
+    return sum == frame[4] ? DHT11_DECODE_OK : DHT11_DECODE_CHECKSUM;
+}
+
+// 将一帧数据转换为整数读数
+void DHT11FrameToRaw(const uint8_t frame[DHT11_FRAME_BYTES], int16_t* temperature, int16_t* humidity)
+{
+    *humidity = (int16_t)(frame[0] * 10 + frame[1]);
+    *temperature = (int16_t)(frame[2] * 10 + (frame[3] & 0x7F));
+    if (frame[3] & 0x80) {
+        *temperature = -*temperature;
+    }
+}
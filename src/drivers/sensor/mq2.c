@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "drivers/sensor/mq2.h"
+#include "drivers/sensor/sensor.h"
 #include "iot_gpio.h"
 #include "iot_adc.h"
 #include "hi_adc.h"
@@ -28,10 +29,10 @@ int MQ2Init(void)
     return 0;
 }
 
-// 获取MQ2传感器数据
-int MQ2GetData(float* smoke)
+// 获取MQ2原始ADC值
+int MQ2GetRaw(uint16_t* adc)
 {
-    if (smoke == NULL) {
+    if (adc == NULL) {
         return -1;
     }
     
@@ -41,8 +42,24 @@ int MQ2GetData(float* smoke)
         return -1;
     }
     
+    *adc = data;
+    return 0;
+}
+
+// 获取MQ2传感器数据
+int MQ2GetData(float* smoke)
+{
+    if (smoke == NULL) {
+        return -1;
+    }
+    
+    uint16_t data;
+    if (MQ2GetRaw(&data) != 0) {
+        return -1;
+    }
+    
     // 将ADC值转换为PPM浓度值
-    // 这里使用简单的线性转换,实际应用中需要根据传感器特性曲线进行校准
+    // 这里使用简单的线性转换, 采集器按校准系数换算原始值
     *smoke = (float)data * 0.1f;
     
     return 0;
@@ -74,3 +91,45 @@ int MQ2Deinit(void)
     
     return 0;
 }
+
+static sensor_status_t mq2_init(void)
+{
+    return MQ2Init() == 0 ? SENSOR_OK : SENSOR_ERROR_GPIO;
+}
+
+static sensor_status_t mq2_read(sensor_data_t* data)
+{
+    if (data == NULL || MQ2GetData(&data->smoke) != 0) {
+        return SENSOR_ERROR_DATA;
+    }
+    return SENSOR_OK;
+}
+
+static sensor_status_t mq2_read_channels(sensor_raw_t* raw)
+{
+    uint16_t adc = 0;
+
+    if (raw == NULL || MQ2GetRaw(&adc) != 0) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    raw->mask = 1U << SENSOR_RAW_SMOKE;
+    raw->value[SENSOR_RAW_SMOKE] = adc;
+    return SENSOR_OK;
+}
+
+static sensor_status_t mq2_deinit(void)
+{
+    MQ2Deinit();
+    return SENSOR_OK;
+}
+
+// 导出MQ2操作接口
+const sensor_ops_t mq2_ops = {
+    .type = SENSOR_TYPE_SMOKE,
+    .init = mq2_init,
+    .read = mq2_read,
+    .deinit = mq2_deinit,
+    .read_raw = mq2_read_channels,
+    .caps = {0, SENSOR_BUS_ADC, 0}
+};
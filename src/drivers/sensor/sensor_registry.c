@@ -0,0 +1,69 @@
+#include "drivers/sensor/sensor_registry.h"
+#include <stdio.h>
+#include <stddef.h>
+
+// 各类型的驱动, 采集任务读取时无锁获取
+static const sensor_ops_t* g_sensor_ops[SENSOR_TYPE_COUNT] = {0};
+
+// 注册传感器驱动
+int SensorRegister(const sensor_ops_t* ops)
+{
+    if (ops == NULL || ops->type >= SENSOR_TYPE_COUNT || ops->read_raw == NULL) {
+        return -1;
+    }
+
+    // 异步驱动必须能触发转换
+    if ((ops->caps.flags & SENSOR_CAP_ASYNC) && ops->start == NULL) {
+        return -1;
+    }
+
+    __atomic_store_n(&g_sensor_ops[ops->type], ops, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 注销传感器驱动
+void SensorUnregister(sensor_type_t type)
+{
+    if (type < SENSOR_TYPE_COUNT) {
+        __atomic_store_n(&g_sensor_ops[type], NULL, __ATOMIC_RELEASE);
+    }
+}
+
+// 获取传感器驱动
+const sensor_ops_t* SensorGetOps(sensor_type_t type)
+{
+    if (type >= SENSOR_TYPE_COUNT) {
+        return NULL;
+    }
+    return __atomic_load_n(&g_sensor_ops[type], __ATOMIC_ACQUIRE);
+}
+
+// 初始化所有已注册的传感器
+sensor_status_t SensorInitAll(void)
+{
+    for (sensor_type_t type = SENSOR_TYPE_TEMP_HUMID; type < SENSOR_TYPE_COUNT; type++) {
+        const sensor_ops_t* ops = SensorGetOps(type);
+        if (ops == NULL || ops->init == NULL) {
+            continue;
+        }
+
+        sensor_status_t status = ops->init();
+        if (status != SENSOR_OK) {
+            printf("Sensor %d init failed: %d\n", type, status);
+            return status;
+        }
+    }
+
+    return SENSOR_OK;
+}
+
+// 反初始化所有已注册的传感器
+void SensorDeinitAll(void)
+{
+    for (sensor_type_t type = SENSOR_TYPE_TEMP_HUMID; type < SENSOR_TYPE_COUNT; type++) {
+        const sensor_ops_t* ops = SensorGetOps(type);
+        if (ops != NULL && ops->deinit != NULL) {
+            ops->deinit();
+        }
+    }
+}
@@ -0,0 +1,245 @@
+#include "drivers/sensor/sensor_sim.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <unistd.h>
+#include "common/clock.h"
+#include "drivers/sensor/sensor_registry.h"
+#include "drivers/sensor/dht11.h"
+
+// 模拟传感器状态
+typedef struct {
+    sensor_raw_t raw;        // 模拟读数
+    sensor_status_t status;  // 模拟读取结果
+    uint32_t reads;          // 累计读取次数
+    bool converting;         // 异步转换进行中
+    uint32_t ready_us;       // 异步转换完成时间(us), 只用于计算差值
+} SimSensor;
+
+static SimSensor g_sim[SENSOR_TYPE_COUNT] = {
+    [SENSOR_TYPE_TEMP_HUMID] = {
+        .raw = {(1U << SENSOR_RAW_TEMPERATURE) | (1U << SENSOR_RAW_HUMIDITY), {250, 500, 0, 0}}
+    },
+    [SENSOR_TYPE_SMOKE] = {
+        .raw = {1U << SENSOR_RAW_SMOKE, {0, 0, 100, 0}}
+    },
+    [SENSOR_TYPE_LIGHT] = {
+        .raw = {1U << SENSOR_RAW_LIGHT, {0, 0, 0, 360}}
+    }
+};
+
+// 模拟驱动操作接口, 定义在后
+static sensor_ops_t g_sim_ops[SENSOR_TYPE_COUNT];
+
+// 触发模拟转换, 转换进行中时不重新触发
+static sensor_status_t SimStart(sensor_type_t type)
+{
+    SimSensor* sim = &g_sim[type];
+
+    if (!__atomic_exchange_n(&sim->converting, true, __ATOMIC_ACQ_REL)) {
+        __atomic_store_n(&sim->ready_us,
+            (uint32_t)ClockNowUs() + g_sim_ops[type].caps.conversion_ms * CLOCK_US_PER_MS, __ATOMIC_RELEASE);
+    }
+    return SENSOR_OK;
+}
+
+// 读取模拟数据, 读数可能被其他任务修改, 逐项原子读取
+static sensor_status_t SimRead(sensor_type_t type, sensor_raw_t* raw)
+{
+    SimSensor* sim = &g_sim[type];
+
+    // 异步模式下只有转换完成后才能读取, 结果只读取一次
+    if (g_sim_ops[type].caps.flags & SENSOR_CAP_ASYNC) {
+        if (!__atomic_load_n(&sim->converting, __ATOMIC_ACQUIRE)) {
+            return SENSOR_ERROR_DATA;
+        }
+        if ((int32_t)((uint32_t)ClockNowUs() - __atomic_load_n(&sim->ready_us, __ATOMIC_ACQUIRE)) < 0) {
+            return SENSOR_ERROR_BUSY;
+        }
+        __atomic_store_n(&sim->converting, false, __ATOMIC_RELEASE);
+    }
+
+    __atomic_fetch_add(&sim->reads, 1, __ATOMIC_RELAXED);
+    sensor_status_t status = __atomic_load_n(&sim->status, __ATOMIC_RELAXED);
+    if (status != SENSOR_OK) {
+        return status;
+    }
+
+    raw->mask = __atomic_load_n(&sim->raw.mask, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < SENSOR_RAW_MAX; i++) {
+        raw->value[i] = __atomic_load_n(&sim->raw.value[i], __ATOMIC_RELAXED);
+    }
+    return SENSOR_OK;
+}
+
+// 按各驱动的默认换算转换为物理量
+static sensor_status_t SimReadData(sensor_type_t type, sensor_data_t* data)
+{
+    sensor_raw_t raw;
+
+    if (data == NULL) {
+        return SENSOR_ERROR_DATA;
+    }
+
+    if (g_sim_ops[type].caps.flags & SENSOR_CAP_ASYNC) {
+        SimStart(type);
+    }
+    sensor_status_t status;
+    while ((status = SimRead(type, &raw)) == SENSOR_ERROR_BUSY) {
+        usleep(1000);
+    }
+    if (status != SENSOR_OK) {
+        return status;
+    }
+
+    data->temperature = raw.value[SENSOR_RAW_TEMPERATURE] * 0.1f;
+    data->humidity = raw.value[SENSOR_RAW_HUMIDITY] * 0.1f;
+    data->smoke = raw.value[SENSOR_RAW_SMOKE] * 0.1f;
+    data->light = raw.value[SENSOR_RAW_LIGHT] / 1.2f;
+    return SENSOR_OK;
+}
+
+static sensor_status_t sim_init(void)
+{
+    return SENSOR_OK;
+}
+
+static sensor_status_t sim_deinit(void)
+{
+    return SENSOR_OK;
+}
+
+static sensor_status_t sim_temp_humid_read(sensor_data_t* data)
+{
+    return SimReadData(SENSOR_TYPE_TEMP_HUMID, data);
+}
+
+static sensor_status_t sim_temp_humid_read_raw(sensor_raw_t* raw)
+{
+    return SimRead(SENSOR_TYPE_TEMP_HUMID, raw);
+}
+
+static sensor_status_t sim_temp_humid_start(void)
+{
+    return SimStart(SENSOR_TYPE_TEMP_HUMID);
+}
+
+static sensor_status_t sim_smoke_read(sensor_data_t* data)
+{
+    return SimReadData(SENSOR_TYPE_SMOKE, data);
+}
+
+static sensor_status_t sim_smoke_read_raw(sensor_raw_t* raw)
+{
+    return SimRead(SENSOR_TYPE_SMOKE, raw);
+}
+
+static sensor_status_t sim_smoke_start(void)
+{
+    return SimStart(SENSOR_TYPE_SMOKE);
+}
+
+static sensor_status_t sim_light_read(sensor_data_t* data)
+{
+    return SimReadData(SENSOR_TYPE_LIGHT, data);
+}
+
+static sensor_status_t sim_light_read_raw(sensor_raw_t* raw)
+{
+    return SimRead(SENSOR_TYPE_LIGHT, raw);
+}
+
+static sensor_status_t sim_light_start(void)
+{
+    return SimStart(SENSOR_TYPE_LIGHT);
+}
+
+// 模拟驱动操作接口, 温湿度保持与DHT11相同的读取间隔限制
+static sensor_ops_t g_sim_ops[SENSOR_TYPE_COUNT] = {
+    {
+        .type = SENSOR_TYPE_TEMP_HUMID,
+        .init = sim_init,
+        .read = sim_temp_humid_read,
+        .deinit = sim_deinit,
+        .read_raw = sim_temp_humid_read_raw,
+        .caps = {DHT11_MIN_INTERVAL_MS, SENSOR_BUS_NONE, 0},
+        .start = sim_temp_humid_start
+    },
+    {
+        .type = SENSOR_TYPE_SMOKE,
+        .init = sim_init,
+        .read = sim_smoke_read,
+        .deinit = sim_deinit,
+        .read_raw = sim_smoke_read_raw,
+        .caps = {0, SENSOR_BUS_NONE, 0},
+        .start = sim_smoke_start
+    },
+    {
+        .type = SENSOR_TYPE_LIGHT,
+        .init = sim_init,
+        .read = sim_light_read,
+        .deinit = sim_deinit,
+        .read_raw = sim_light_read_raw,
+        .caps = {0, SENSOR_BUS_NONE, 0},
+        .start = sim_light_start
+    }
+};
+
+// 注册模拟驱动
+int SensorSimRegister(void)
+{
+    for (sensor_type_t type = SENSOR_TYPE_TEMP_HUMID; type < SENSOR_TYPE_COUNT; type++) {
+        if (SensorRegister(&g_sim_ops[type]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 设置模拟读数
+int SensorSimSetRaw(sensor_type_t type, const sensor_raw_t* raw)
+{
+    if (type >= SENSOR_TYPE_COUNT || raw == NULL) {
+        return -1;
+    }
+
+    SimSensor* sim = &g_sim[type];
+    __atomic_store_n(&sim->raw.mask, raw->mask, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < SENSOR_RAW_MAX; i++) {
+        __atomic_store_n(&sim->raw.value[i], raw->value[i], __ATOMIC_RELAXED);
+    }
+    return 0;
+}
+
+// 设置模拟转换时间
+int SensorSimSetConversion(sensor_type_t type, uint32_t conversion_ms)
+{
+    if (type >= SENSOR_TYPE_COUNT) {
+        return -1;
+    }
+
+    sensor_caps_t* caps = &g_sim_ops[type].caps;
+    caps->conversion_ms = conversion_ms;
+    caps->flags = conversion_ms != 0 ? (caps->flags | SENSOR_CAP_ASYNC) : (caps->flags & ~SENSOR_CAP_ASYNC);
+    __atomic_store_n(&g_sim[type].converting, false, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 设置模拟读取结果
+int SensorSimSetStatus(sensor_type_t type, sensor_status_t status)
+{
+    if (type >= SENSOR_TYPE_COUNT) {
+        return -1;
+    }
+
+    __atomic_store_n(&g_sim[type].status, status, __ATOMIC_RELAXED);
+    return 0;
+}
+
+// 获取累计读取次数
+uint32_t SensorSimGetReads(sensor_type_t type)
+{
+    if (type >= SENSOR_TYPE_COUNT) {
+        return 0;
+    }
+    return __atomic_load_n(&g_sim[type].reads, __ATOMIC_RELAXED);
+}
@@ -2,24 +2,34 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <float.h>
 #include <unistd.h>
 #include "cmsis_os2.h"
+#include "common/clock.h"
 #include "data/data_collector.h"
+#include "data/flash_log.h"
+#include "data/flash_backend.h"
 #include "business/alarm.h"
+#include "business/monitor.h"
 #include "drivers/sensor/dht11.h"
 #include "drivers/sensor/mq2.h"
 #include "drivers/sensor/bh1750.h"
+#include "drivers/sensor/sensor_registry.h"
 #include "drivers/output/led.h"
 #include "drivers/output/buzzer.h"
 
 // 系统状态
 static SystemState g_system_state = SYSTEM_STATE_INIT;
 static SystemError g_system_error = SYSTEM_ERROR_NONE;
-static uint32_t g_system_start_time = 0;
+static uint64_t g_system_start_time = 0;
 
 // 定时器
 static osTimerId_t g_alarm_timer = NULL;
 
+// 持久化日志
+static FlashBackend g_log_backend;
+static FlashLog g_flash_log;
+
 // 默认报警规则配置
 static const AlarmRule g_default_rules[] = {
     {
@@ -77,6 +87,14 @@ static const AlarmRule g_default_rules[] = {
         .thresholdLow = 10.0f,
         .isEnabled = true,
         .delaySeconds = 3
+    },
+    {
+        .type = ALARM_TYPE_HEAT_INDEX_HIGH,
+        .level = ALARM_LEVEL_WARNING,
+        .thresholdHigh = 40.0f,
+        .thresholdLow = -999.0f,
+        .isEnabled = true,
+        .delaySeconds = 5
     }
 };
 
@@ -94,6 +112,20 @@ static void HandleAlarm(const AlarmRecord* record)
         record->type, record->level, record->value, record->description);
 }
 
+// 触发捕获回调函数, 发布捕获摘要并写入闪存日志, 写完后由采集器释放
+static void HandleCapture(const CaptureView* capture)
+{
+    uint32_t total = capture->count[0] + capture->count[1];
+    printf("[CAPTURE] Trigger: %u ms, Samples: %u (pre %u, post %u)\n",
+        (uint32_t)(capture->trigger_ts / CLOCK_US_PER_MS), total, capture->pre_count,
+        total - capture->pre_count);
+    // 闪存日志不可用时只保留摘要, 直接释放以便再次触发
+    if (CollectorLogCapture() != 0) {
+        printf("[CAPTURE] Not logged\n");
+        CollectorReleaseCapture();
+    }
+}
+
 // 定时器回调函数
 static void AlarmTimerCallback(void* arg)
 {
@@ -101,35 +133,84 @@ static void AlarmTimerCallback(void* arg)
     AlarmCheck();
 }
 
-// 初始化传感器
+// 注册并初始化传感器, 采集器通过注册表读取
+// BH1750使用单次测量模式, 由采集器提前触发转换, 测量之间保持断电
 static int InitSensors(void)
 {
-    int ret = 0;
-    
-    // 初始化DHT11
-    ret = DHT11Init();
-    if (ret != 0) {
-        printf("DHT11 init failed: %d\n", ret);
-        return -1;
-    }
-    
-    // 初始化MQ2
-    ret = MQ2Init();
-    if (ret != 0) {
-        printf("MQ2 init failed: %d\n", ret);
+    if (SensorRegister(&dht11_ops) != 0 || SensorRegister(&mq2_ops) != 0 ||
+        SensorRegister(&bh1750_oneshot_ops) != 0) {
+        printf("Sensor register failed\n");
         return -1;
     }
     
-    // 初始化BH1750
-    ret = BH1750Init();
-    if (ret != 0) {
-        printf("BH1750 init failed: %d\n", ret);
+    sensor_status_t status = SensorInitAll();
+    if (status != SENSOR_OK) {
+        printf("Sensor init failed: %d\n", status);
         return -1;
     }
     
     return 0;
 }
 
+// 自适应采样: 各通道视为快速变化的变化率(单位/秒)及接近阈值的判定范围
+static const AdaptiveChannel g_adaptive_channels[SENSOR_CHANNEL_MAX] = {
+    [SENSOR_CHANNEL_TEMPERATURE] = {.rate = 0.5f, .margin = 2.0f},
+    [SENSOR_CHANNEL_HUMIDITY] = {.rate = 2.0f, .margin = 5.0f},
+    [SENSOR_CHANNEL_SMOKE] = {.rate = 10.0f, .margin = 20.0f},
+    [SENSOR_CHANNEL_LIGHT] = {.rate = 200.0f, .margin = 50.0f}
+};
+
+// 报警类型对应的通道
+static SensorChannel GetAlarmChannel(AlarmType type)
+{
+    switch (type) {
+        case ALARM_TYPE_TEMPERATURE_HIGH:
+        case ALARM_TYPE_TEMPERATURE_LOW:
+            return SENSOR_CHANNEL_TEMPERATURE;
+        case ALARM_TYPE_HUMIDITY_HIGH:
+        case ALARM_TYPE_HUMIDITY_LOW:
+            return SENSOR_CHANNEL_HUMIDITY;
+        case ALARM_TYPE_SMOKE:
+            return SENSOR_CHANNEL_SMOKE;
+        case ALARM_TYPE_LIGHT_HIGH:
+        case ALARM_TYPE_LIGHT_LOW:
+            return SENSOR_CHANNEL_LIGHT;
+        default:
+            return SENSOR_CHANNEL_MAX;
+    }
+}
+
+// 按默认报警规则填写自适应采样的阈值
+static void InitAdaptiveConfig(AdaptiveConfig* adaptive, uint32_t collect_interval)
+{
+    adaptive->enabled = true;
+    adaptive->min_period_ms = collect_interval / 4;
+    adaptive->max_period_ms = collect_interval * 8;
+
+    for (int i = 0; i < SENSOR_CHANNEL_MAX; i++) {
+        adaptive->channel[i] = g_adaptive_channels[i];
+        adaptive->channel[i].high = FLT_MAX;
+        adaptive->channel[i].low = -FLT_MAX;
+    }
+
+    for (size_t i = 0; i < sizeof(g_default_rules) / sizeof(AlarmRule); i++) {
+        const AlarmRule* rule = &g_default_rules[i];
+        SensorChannel channel = GetAlarmChannel(rule->type);
+        if (channel == SENSOR_CHANNEL_MAX || !rule->isEnabled) {
+            continue;
+        }
+        // 与报警检查一致: 过低报警只看下限, 其余只看上限
+        bool is_low = rule->type == ALARM_TYPE_TEMPERATURE_LOW || rule->type == ALARM_TYPE_HUMIDITY_LOW ||
+            rule->type == ALARM_TYPE_LIGHT_LOW;
+        if (is_low && rule->thresholdLow > adaptive->channel[channel].low) {
+            adaptive->channel[channel].low = rule->thresholdLow;
+        }
+        if (!is_low && rule->thresholdHigh < adaptive->channel[channel].high) {
+            adaptive->channel[channel].high = rule->thresholdHigh;
+        }
+    }
+}
+
 // 初始化报警规则
 static int InitAlarmRules(void)
 {
@@ -156,13 +237,13 @@ static int SpaceStationGetSystemError(void)
     return g_system_error;
 }
 
-// 获取系统运行时间
+// 获取系统运行时间(ms)
 uint32_t GetSystemUptime(void)
 {
     if (g_system_start_time == 0) {
         return 0;
     }
-    return osKernelGetTickCount() - g_system_start_time;
+    return (uint32_t)((ClockNowUs() - g_system_start_time) / CLOCK_US_PER_MS);
 }
 
 // 系统初始化
@@ -182,16 +263,61 @@ int SystemInit(const SystemConfig* config)
         return -1;
     }
     
+    // 初始化监测汇总模块, 采集到的数据按秒/分钟/小时汇总
+    ret = MonitorInit();
+    if (ret != 0) {
+        UpdateSystemState(SYSTEM_STATE_ERROR, SYSTEM_ERROR_COLLECTOR);
+        return -1;
+    }
+    
     // 初始化数据采集模块
     CollectorConfig collector_config = {
         .collect_interval = config->collect_interval,
-        .cache_size = 10  // 每个传感器缓存10条数据
+        .cache_size = 10,  // 每个传感器缓存10条数据
+        .filter = {
+            // DHT11偶尔读到校验通过的跳变值, 用3点中值去除
+            [SENSOR_CHANNEL_TEMPERATURE] = {
+                .stage_count = 1,
+                .stages = {{.type = FILTER_STAGE_MEDIAN, .window = 3}}
+            },
+            [SENSOR_CHANNEL_HUMIDITY] = {
+                .stage_count = 1,
+                .stages = {{.type = FILTER_STAGE_MEDIAN, .window = 3}}
+            },
+            // MQ2的ADC读数噪声较大, 中值去毛刺后再做定点低通
+            [SENSOR_CHANNEL_SMOKE] = {
+                .stage_count = 2,
+                .stages = {
+                    {.type = FILTER_STAGE_MEDIAN, .window = 3},
+                    {.type = FILTER_STAGE_IIR, .shift = 2}
+                }
+            }
+        }
     };
+    // 严重报警时保存前10秒的原始样本, 并以200ms周期继续采集5秒
+    collector_config.capture.pre_ms = 10000;
+    collector_config.capture.post_ms = 5000;
+    collector_config.capture.burst_period_ms = 200;
+    // 信号平稳时降低采样频率, 变化快或接近报警阈值时加快
+    InitAdaptiveConfig(&collector_config.adaptive, config->collect_interval);
+    // 采集数据写入分区表中用户预留分区上的闪存日志, 打开失败时只保留内存中的历史
+    if (FlashBackendHiInit(&g_log_backend) == 0 &&
+        FlashLogOpen(&g_flash_log, &g_log_backend) == 0) {
+        collector_config.flash_log = &g_flash_log;
+    } else {
+        printf("Flash log unavailable\n");
+    }
     ret = CollectorInit(&collector_config);
     if (ret != 0) {
         UpdateSystemState(SYSTEM_STATE_ERROR, SYSTEM_ERROR_COLLECTOR);
         return -1;
     }
+    CollectorRegisterCaptureCallback(HandleCapture);
+    
+    // 加载配置, 传感器配置中的校准系数随即下发到采集器; 存储不可用时采集器保持默认系数
+    if (ConfigInit() != 0) {
+        printf("Config unavailable, using default calibration\n");
+    }
     
     // 初始化报警管理模块
     ret = AlarmInit();
@@ -253,7 +379,7 @@ int SystemStart(void)
     }
     
     // 记录启动时间
-    g_system_start_time = osKernelGetTickCount();
+    g_system_start_time = ClockNowUs();
     
     UpdateSystemState(SYSTEM_STATE_RUNNING, SYSTEM_ERROR_NONE);
     return 0;
@@ -289,10 +415,11 @@ int SystemDeinit(void)
     
     // 反初始化各个模块
     AlarmDeinit();
+    ConfigDeinit();
     CollectorDeinit();
-    DHT11Deinit();
-    MQ2Deinit();
-    BH1750Deinit();
+    FlashLogClose(&g_flash_log);
+    MonitorDeinit();
+    SensorDeinitAll();
     
     UpdateSystemState(SYSTEM_STATE_INIT, SYSTEM_ERROR_NONE);
     return 0;
@@ -301,25 +428,33 @@ int SystemDeinit(void)
 // 处理系统事件
 static void ProcessSystemEvents(void)
 {
-    // 处理传感器数据
-    SensorData data;
-    if (CollectorGetLatestData(SENSOR_TYPE_ALL, &data) == 0) {
-        // 更新LED状态
-        if (data.data.dht11.temperature > 30.0f) {
+    // 处理传感器数据, 每个采集周期处理一次
+    static uint32_t last_seq = 0;
+    SensorFrame frame;
+    if (CollectorGetLatestFrame(&frame) != 0 || frame.seq == last_seq) {
+        return;
+    }
+    last_seq = frame.seq;
+    
+    // 更新LED状态
+    if (SENSOR_FRAME_VALID(&frame, SENSOR_CHANNEL_TEMPERATURE)) {
+        float temperature = frame.value[SENSOR_CHANNEL_TEMPERATURE];
+        if (temperature > 30.0f) {
             LEDSetColor(LED_COLOR_RED);
-        } else if (data.data.dht11.temperature < 10.0f) {
+        } else if (temperature < 10.0f) {
             LEDSetColor(LED_COLOR_BLUE);
         } else {
             LEDSetColor(LED_COLOR_GREEN);
         }
-        
-        // 打印传感器数据
-        printf("Temperature: %.1f°C, Humidity: %.1f%%, Smoke: %.1fppm, Light: %.1flx\n",
-            data.data.dht11.temperature, 
-            data.data.dht11.humidity,
-            data.data.mq2.smoke,
-            data.data.bh1750.light);
     }
+    
+    // 打印传感器数据
+    printf("Temperature: %.1f°C, Humidity: %.1f%%, Smoke: %.1fppm, Light: %.1flx (valid 0x%x)\n",
+        frame.value[SENSOR_CHANNEL_TEMPERATURE],
+        frame.value[SENSOR_CHANNEL_HUMIDITY],
+        frame.value[SENSOR_CHANNEL_SMOKE],
+        frame.value[SENSOR_CHANNEL_LIGHT],
+        frame.valid_mask);
 }
 
 // 重命名main函数为SpaceStationMain
@@ -329,7 +464,8 @@ int SpaceStationMain(void)
     SystemConfig config = {
         .collect_interval = 1000,  // 1秒采集一次数据
         .check_interval = 1000,    // 1秒检查一次报警
-        .record_capacity = 100     // 最多保存100条报警记录
+        .record_capacity = 100,    // 最多保存100条报警记录
+        .log_enabled = true        // 启用日志
     };
     
     // 初始化系统
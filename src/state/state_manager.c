@@ -3,6 +3,8 @@
 #include "state/state_manager.h"
 #include "utils/kv_store/kv_store.h"
 #include "cmsis_os2.h"
+#include "common/clock.h"
+#include "data/data_collector.h"
 
 // 状态存储的键名
 #define STATE_KEY "spacestation_state"
@@ -14,7 +16,7 @@
 typedef struct {
     DeviceState state;           // 当前状态
     uint32_t error_count;        // 错误计数
-    uint32_t last_error_time;    // 最后一次错误时间
+    uint64_t last_error_time;    // 最后一次错误时间(单调时钟, us)
     uint32_t retry_count;        // 重试计数
     StateCallback callbacks[MAX_CALLBACKS];  // 回调函数数组
     void* callback_args[MAX_CALLBACKS];      // 回调函数参数
@@ -154,7 +156,7 @@ int StateManagerSetDeviceState(DeviceType device, DeviceState state)
         // 如果进入错误状态，记录错误信息
         if (state == DEVICE_STATE_ERROR) {
             status->error_count++;
-            status->last_error_time = osKernelGetTickCount();
+            status->last_error_time = ClockNowUs();
         }
         
         // 通知所有回调函数
@@ -295,10 +297,10 @@ int StateManagerDiagnoseDevice(DeviceType device)
     // 根据设备类型执行不同的诊断
     switch (device) {
         case DEVICE_TYPE_DHT11:
-            // 尝试读取DHT11数据
+            // 尝试读取DHT11数据, 与采集任务共用总线读取
             {
-                float temperature, humidity;
-                if (DHT11GetData(&temperature, &humidity) == 0) {
+                SensorData data;
+                if (CollectorReadSensor(SENSOR_TYPE_DHT11, &data) == 0) {
                     return 0;
                 }
             }
@@ -307,8 +309,8 @@ int StateManagerDiagnoseDevice(DeviceType device)
         case DEVICE_TYPE_MQ2:
             // 尝试读取MQ2数据
             {
-                float smoke;
-                if (MQ2GetData(&smoke) == 0) {
+                SensorData data;
+                if (CollectorReadSensor(SENSOR_TYPE_MQ2, &data) == 0) {
                     return 0;
                 }
             }
@@ -317,8 +319,8 @@ int StateManagerDiagnoseDevice(DeviceType device)
         case DEVICE_TYPE_BH1750:
             // 尝试读取BH1750数据
             {
-                float light;
-                if (BH1750GetData(&light) == 0) {
+                SensorData data;
+                if (CollectorReadSensor(SENSOR_TYPE_BH1750, &data) == 0) {
                     return 0;
                 }
             }
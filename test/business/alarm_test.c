@@ -11,7 +11,7 @@ static void OnAlarm(const AlarmRecord* record)
     printf("\n收到报警:\n");
     printf("类型: %s\n", GetAlarmTypeString(record->type));
     printf("级别: %s\n", GetAlarmLevelString(record->level));
-    printf("时间: %ld\n", record->timestamp);
+    printf("时间: %u ms\n", (uint32_t)(record->timestamp / 1000));
     printf("数值: %.2f\n", record->value);
     printf("描述: %s\n", record->description);
     printf("\n");
@@ -104,7 +104,7 @@ static void TestAlarmRecords(void)
             printf("\n记录 %d:\n", i + 1);
             printf("类型: %s\n", GetAlarmTypeString(records[i].type));
             printf("级别: %s\n", GetAlarmLevelString(records[i].level));
-            printf("时间: %ld\n", records[i].timestamp);
+            printf("时间: %u ms\n", (uint32_t)(records[i].timestamp / 1000));
             printf("数值: %.2f\n", records[i].value);
             printf("描述: %s\n", records[i].description);
         }
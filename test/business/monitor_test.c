@@ -0,0 +1,123 @@
+#include "business/monitor.h"
+#include <stdio.h>
+#include "common/clock.h"
+
+// 浮点比较容差
+#define TEST_EPSILON 0.01f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 打印汇总结果
+static void PrintSummary(const char* name, const RollupBucket* summary)
+{
+    float mean = summary->count > 0 ? summary->sum / summary->count : 0.0f;
+    printf("%s: count=%u, min=%.2f, max=%.2f, mean=%.2f, last=%.2f\n",
+        name, summary->count, summary->min, summary->max, mean, summary->last);
+}
+
+// 测试秒级桶及窗口汇总
+static int TestSecondRollup(void)
+{
+    RollupBucket summary;
+    RollupBucket buckets[MONITOR_SECOND_BUCKETS];
+    uint32_t count = 0;
+    uint64_t second = CLOCK_US_PER_SEC;
+    uint64_t now = ClockNowUs();
+
+    printf("\nTesting second rollup...\n");
+    MonitorReset();
+
+    // 过去30秒内每秒4个烟雾样本, 第k秒的数值为k
+    uint64_t base = now - now % second - 29 * second;
+    for (uint32_t k = 0; k < 30; k++) {
+        for (uint32_t j = 0; j < 4; j++) {
+            MonitorFeed(SENSOR_CHANNEL_SMOKE, base + k * second + j * (second / 4), (float)k);
+        }
+    }
+
+    MonitorGetBuckets(SENSOR_CHANNEL_SMOKE, MONITOR_RESOLUTION_SECOND, buckets, MONITOR_SECOND_BUCKETS, &count);
+    printf("Second buckets: %u\n", count);
+    if (count != 30 || buckets[0].count != 4 || !FloatEqual(buckets[29].last, 29.0f)) {
+        printf("FAILED: unexpected buckets\n");
+        return -1;
+    }
+
+    // 最近10秒: 数值20-29
+    MonitorGetWindow(SENSOR_CHANNEL_SMOKE, 10000, &summary);
+    PrintSummary("Last 10s", &summary);
+    if (summary.count != 40 || !FloatEqual(summary.min, 20.0f) || !FloatEqual(summary.max, 29.0f) ||
+        !FloatEqual(summary.sum, 4.0f * 245.0f) || !FloatEqual(summary.last, 29.0f)) {
+        printf("FAILED: unexpected window summary\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试分钟级和小时级桶
+static int TestCoarseRollup(void)
+{
+    RollupBucket summary;
+    RollupBucket buckets[MONITOR_MINUTE_BUCKETS];
+    uint32_t count = 0;
+    uint64_t now = ClockNowUs();
+
+    printf("\nTesting coarse rollup...\n");
+    MonitorReset();
+
+    // 过去20分钟每10秒一个温度样本
+    uint64_t minute = 60 * CLOCK_US_PER_SEC;
+    uint64_t base = now - now % minute - 19 * minute;
+    for (uint32_t k = 0; k < 20 * 6; k++) {
+        MonitorFeed(SENSOR_CHANNEL_TEMPERATURE, base + k * 10 * CLOCK_US_PER_SEC, 20.0f + (float)(k / 6));
+    }
+
+    MonitorGetBuckets(SENSOR_CHANNEL_TEMPERATURE, MONITOR_RESOLUTION_MINUTE, buckets, 5, &count);
+    if (count != 5 || !FloatEqual(buckets[4].min, 39.0f) || buckets[4].count != 6) {
+        printf("FAILED: unexpected minute buckets, count=%u\n", count);
+        return -1;
+    }
+
+    // 最近10分钟选用分钟桶
+    MonitorGetWindow(SENSOR_CHANNEL_TEMPERATURE, 10 * 60 * 1000, &summary);
+    PrintSummary("Last 10min", &summary);
+    if (summary.count != 60 || !FloatEqual(summary.min, 30.0f) || !FloatEqual(summary.max, 39.0f)) {
+        printf("FAILED: unexpected window summary\n");
+        return -1;
+    }
+
+    // 其他通道不受影响
+    MonitorGetWindow(SENSOR_CHANNEL_HUMIDITY, 10 * 60 * 1000, &summary);
+    if (summary.count != 0) {
+        printf("FAILED: humidity should be empty\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Monitor Rollup Test Program\n");
+
+    if (MonitorInit() != 0) {
+        printf("Failed to initialize monitor\n");
+        return -1;
+    }
+
+    failed += TestSecondRollup() != 0;
+    failed += TestCoarseRollup() != 0;
+
+    MonitorDeinit();
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
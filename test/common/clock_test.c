@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include "common/clock.h"
+
+// 测试单调时钟
+static int TestMonotonic(void)
+{
+    printf("\nTesting monotonic clock...\n");
+
+    uint64_t prev = ClockNowUs();
+    for (int i = 0; i < 100000; i++) {
+        uint64_t now = ClockNowUs();
+        if (now < prev) {
+            printf("FAILED: clock went backwards\n");
+            return -1;
+        }
+        prev = now;
+    }
+
+    printf("Now: %u ms\n", ClockNowMs());
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试墙上时间换算
+static int TestWallTime(void)
+{
+    uint64_t wall = 0;
+
+    printf("\nTesting wall time...\n");
+
+    if (ClockHasWallTime() || ClockToWallTime(ClockNowUs(), &wall) == 0) {
+        printf("FAILED: wall time set before sync\n");
+        return -1;
+    }
+
+    // 2024-01-01 00:00:00 UTC
+    uint64_t epoch = 1704067200ULL * CLOCK_US_PER_SEC;
+    uint64_t mono = ClockNowUs();
+    if (ClockSetWallTime(epoch) != 0 || !ClockHasWallTime()) {
+        printf("FAILED: set wall time\n");
+        return -1;
+    }
+
+    // 校时之后的单调时间换算结果不早于校时时刻, 差值与单调时钟一致
+    uint64_t later = ClockNowUs();
+    ClockToWallTime(later, &wall);
+    if (wall < epoch || wall - epoch > later - mono) {
+        printf("FAILED: unexpected wall time\n");
+        return -1;
+    }
+
+    ClockToWallTime(later + 5 * CLOCK_US_PER_SEC, &wall);
+    uint64_t shifted = 0;
+    ClockToWallTime(later, &shifted);
+    if (wall - shifted != 5 * CLOCK_US_PER_SEC) {
+        printf("FAILED: offset not constant\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Clock Test Program\n");
+
+    failed += TestMonotonic() != 0;
+    failed += TestWallTime() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
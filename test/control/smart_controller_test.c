@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "control/smart_controller.h"
 #include "data/data_collector.h"
+#include "common/clock.h"
 
 // 测试阈值规则
 static void TestThresholdRule(void)
@@ -107,7 +108,7 @@ static void TestTimingRule(void)
 
     for (i = 0; i < sizeof(times)/sizeof(times[0]); i++) {
         // 设置系统时间(仅用于测试)
-        data.timestamp = times[i] * 1000;
+        data.timestamp = times[i] * CLOCK_US_PER_SEC;
         ControllerHandleData(&data);
         
         // 获取历史记录
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/adaptive_rate.h"
+
+// 基础采样周期(ms)
+#define TEST_BASE_PERIOD 1000
+
+// 构造烟雾样本
+static SensorData MakeSmoke(float smoke)
+{
+    SensorData data;
+    memset(&data, 0, sizeof(SensorData));
+    data.type = SENSOR_TYPE_MQ2;
+    data.data.mq2.smoke = smoke;
+    return data;
+}
+
+// 测试平稳放慢及快速变化加快
+static int TestRateChange(void)
+{
+    AdaptiveRate rate;
+    AdaptiveConfig config;
+    SensorData data;
+    uint32_t period = 0;
+
+    printf("\nTesting rate change...\n");
+
+    memset(&config, 0, sizeof(AdaptiveConfig));
+    config.enabled = true;
+    config.channel[SENSOR_CHANNEL_SMOKE].rate = 10.0f;
+
+    // 平稳信号逐步放慢到默认上限(基础周期的4倍)
+    AdaptiveRateInit(&rate, TEST_BASE_PERIOD);
+    for (int i = 0; i < 20; i++) {
+        data = MakeSmoke(50.0f);
+        period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    }
+    printf("Flat period: %u ms\n", period);
+    if (period != TEST_BASE_PERIOD * 4) {
+        printf("FAILED: flat signal not slowed down\n");
+        return -1;
+    }
+
+    // 4秒内上升60, 15/s超过10/s, 立即切换到默认下限
+    data = MakeSmoke(110.0f);
+    period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    printf("Fast period: %u ms\n", period);
+    if (period != TEST_BASE_PERIOD / 4) {
+        printf("FAILED: fast change not sped up\n");
+        return -1;
+    }
+
+    // 250ms内上升2, 8/s介于一半和阈值之间, 保持周期
+    data = MakeSmoke(112.0f);
+    period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    if (period != TEST_BASE_PERIOD / 4) {
+        printf("FAILED: moderate change should hold, period=%u\n", period);
+        return -1;
+    }
+
+    // 恢复平稳后按1/4逐步放慢
+    data = MakeSmoke(112.0f);
+    period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    if (period != TEST_BASE_PERIOD / 4 + TEST_BASE_PERIOD / 16) {
+        printf("FAILED: unexpected decay, period=%u\n", period);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试接近报警阈值
+static int TestThreshold(void)
+{
+    AdaptiveRate rate;
+    AdaptiveConfig config;
+    SensorData data;
+    uint32_t period = 0;
+
+    printf("\nTesting threshold proximity...\n");
+
+    memset(&config, 0, sizeof(AdaptiveConfig));
+    config.enabled = true;
+    config.min_period_ms = 200;
+    config.max_period_ms = 8000;
+    config.channel[SENSOR_CHANNEL_TEMPERATURE].high = 30.0f;
+    config.channel[SENSOR_CHANNEL_TEMPERATURE].low = 10.0f;
+    config.channel[SENSOR_CHANNEL_TEMPERATURE].margin = 2.0f;
+    config.channel[SENSOR_CHANNEL_HUMIDITY].high = 999.0f;
+    config.channel[SENSOR_CHANNEL_HUMIDITY].low = -999.0f;
+
+    memset(&data, 0, sizeof(SensorData));
+    data.type = SENSOR_TYPE_DHT11;
+    data.data.dht11.humidity = 50.0f;
+
+    // 远离阈值, 不按变化率调整时持续放慢
+    AdaptiveRateInit(&rate, TEST_BASE_PERIOD);
+    data.data.dht11.temperature = 20.0f;
+    for (int i = 0; i < 30; i++) {
+        period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    }
+    if (period != 8000) {
+        printf("FAILED: period not at maximum, period=%u\n", period);
+        return -1;
+    }
+
+    // 进入上限附近
+    data.data.dht11.temperature = 28.5f;
+    period = AdaptiveRateUpdate(&rate, &config, &data, period, TEST_BASE_PERIOD);
+    printf("Near high: %u ms\n", period);
+    if (period != 200) {
+        printf("FAILED: near high threshold\n");
+        return -1;
+    }
+
+    // 进入下限附近
+    AdaptiveRateInit(&rate, TEST_BASE_PERIOD);
+    data.data.dht11.temperature = 11.0f;
+    period = AdaptiveRateUpdate(&rate, &config, &data, 0, TEST_BASE_PERIOD);
+    printf("Near low: %u ms\n", period);
+    if (period != 200) {
+        printf("FAILED: near low threshold\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Adaptive Rate Test Program\n");
+
+    failed += TestRateChange() != 0;
+    failed += TestThreshold() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/calibration.h"
+
+// 浮点比较容差, 不超过一个定点最小单位
+#define TEST_EPSILON (1.0f / 256.0f)
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试默认系数与驱动原来的浮点换算一致
+static int TestDefault(void)
+{
+    printf("\nTesting default...\n");
+
+    for (int32_t raw = 0; raw < 1000; raw += 37) {
+        if (!FloatEqual(CalibrationApply(NULL, SENSOR_CHANNEL_TEMPERATURE, raw), raw * 0.1f) ||
+            !FloatEqual(CalibrationApply(NULL, SENSOR_CHANNEL_HUMIDITY, raw), raw * 0.1f)) {
+            printf("FAILED: DHT11 raw %d\n", raw);
+            return -1;
+        }
+    }
+    for (int32_t raw = 0; raw < 4096; raw += 111) {
+        if (!FloatEqual(CalibrationApply(NULL, SENSOR_CHANNEL_SMOKE, raw), raw * 0.1f)) {
+            printf("FAILED: MQ2 raw %d\n", raw);
+            return -1;
+        }
+    }
+
+    // 光照满量程附近误差仍在0.01lux以内
+    float light = CalibrationApply(NULL, SENSOR_CHANNEL_LIGHT, 65535) - 65535 / 1.2f;
+    if (light > 0.01f || light < -0.01f || !FloatEqual(CalibrationApply(NULL, SENSOR_CHANNEL_LIGHT, 120), 100.0f)) {
+        printf("FAILED: light %.3f\n", light);
+        return -1;
+    }
+
+    // 负温度
+    if (!FloatEqual(CalibrationApply(NULL, SENSOR_CHANNEL_TEMPERATURE, -55), -5.5f)) {
+        printf("FAILED: negative temperature\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试偏移、增益及多项式系数
+static int TestPolynomial(void)
+{
+    ChannelCalibration calibration;
+
+    printf("\nTesting polynomial...\n");
+
+    // 温度偏移-1.5℃, 增益放大2%
+    memset(&calibration, 0, sizeof(calibration));
+    calibration.order = 1;
+    calibration.coef[0] = -384;
+    calibration.coef[1] = 26738;
+    if (!FloatEqual(CalibrationApply(&calibration, SENSOR_CHANNEL_TEMPERATURE, 250), 24.0f)) {
+        printf("FAILED: offset/gain %.3f\n", CalibrationApply(&calibration, SENSOR_CHANNEL_TEMPERATURE, 250));
+        return -1;
+    }
+
+    // 烟雾: 10 + 100u + 400u^2, u = raw / 4096
+    calibration.order = 2;
+    calibration.coef[0] = 10 * 256;
+    calibration.coef[1] = 100 * 256;
+    calibration.coef[2] = 400 * 256;
+    float smoke = CalibrationApply(&calibration, SENSOR_CHANNEL_SMOKE, 2048);
+    if (!FloatEqual(smoke, 10.0f + 50.0f + 100.0f)) {
+        printf("FAILED: quadratic %.3f\n", smoke);
+        return -1;
+    }
+
+    // 三阶项, 定点结果为输出单位的1/256
+    calibration.order = 3;
+    calibration.coef[3] = 800 * 256;
+    if (CalibrationApplyFixed(&calibration, SENSOR_CHANNEL_SMOKE, 2048) != (160 + 100) * 256) {
+        printf("FAILED: cubic\n");
+        return -1;
+    }
+
+    // 阶数超出范围时无效
+    calibration.order = CALIBRATION_MAX_ORDER + 1;
+    if (CalibrationIsValid(&calibration)) {
+        printf("FAILED: invalid order accepted\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Calibration Test Program\n");
+
+    failed += TestDefault() != 0;
+    failed += TestPolynomial() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
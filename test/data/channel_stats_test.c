@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <math.h>
+#include "data/channel_stats.h"
+
+// 浮点比较容差
+#define TEST_EPSILON 0.01f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试均值和方差
+static int TestWelford(void)
+{
+    ChannelStatsState state;
+    ChannelStats stats;
+    const uint32_t tau_ms[COLLECTOR_EWMA_COUNT] = {1000, 10000};
+    const float values[] = {2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, 9.0f};
+
+    printf("\nTesting Welford mean/variance...\n");
+
+    ChannelStatsInit(&state, tau_ms);
+    for (uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        ChannelStatsUpdate(&state, values[i], 1000);
+    }
+    ChannelStatsGet(&state, &stats);
+
+    // 均值5, 样本方差32/7
+    printf("Count: %u, Mean: %.3f, Variance: %.3f\n", stats.count, stats.mean, stats.variance);
+    if (stats.count != 8 || !FloatEqual(stats.mean, 5.0f) || !FloatEqual(stats.variance, 32.0f / 7.0f)) {
+        printf("FAILED: unexpected mean/variance\n");
+        return -1;
+    }
+
+    // 大偏置数值下方差保持精确
+    ChannelStatsReset(&state);
+    for (uint32_t i = 0; i < 1000; i++) {
+        ChannelStatsUpdate(&state, 50000.0f + (float)(i % 2), 1000);
+    }
+    ChannelStatsGet(&state, &stats);
+    printf("Offset variance: %.4f\n", stats.variance);
+    if (stats.count != 1000 || !FloatEqual(stats.variance, 0.25025f)) {
+        printf("FAILED: offset variance\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试EWMA时间常数与采样间隔无关
+static int TestEwma(void)
+{
+    ChannelStatsState fast;
+    ChannelStatsState slow;
+    ChannelStats stats_fast;
+    ChannelStats stats_slow;
+    const uint32_t tau_ms[COLLECTOR_EWMA_COUNT] = {5000, 60000};
+
+    printf("\nTesting EWMA...\n");
+
+    // 阶跃输入0->1, 分别以100ms和1000ms间隔采样10秒
+    ChannelStatsInit(&fast, tau_ms);
+    ChannelStatsInit(&slow, tau_ms);
+    ChannelStatsUpdate(&fast, 0.0f, 0);
+    ChannelStatsUpdate(&slow, 0.0f, 0);
+    for (uint32_t i = 0; i < 100; i++) {
+        ChannelStatsUpdate(&fast, 1.0f, 100);
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        ChannelStatsUpdate(&slow, 1.0f, 1000);
+    }
+    ChannelStatsGet(&fast, &stats_fast);
+    ChannelStatsGet(&slow, &stats_slow);
+
+    // 经过两个时间常数, 理论值1-e^-2
+    float expected = 1.0f - expf(-2.0f);
+    printf("Step response: 100ms=%.3f, 1000ms=%.3f, expected=%.3f\n",
+        stats_fast.ewma[0], stats_slow.ewma[0], expected);
+    if (fabsf(stats_fast.ewma[0] - expected) > 0.02f || fabsf(stats_slow.ewma[0] - expected) > 0.05f) {
+        printf("FAILED: time constant depends on sample interval\n");
+        return -1;
+    }
+    if (stats_fast.ewma[1] >= stats_fast.ewma[0]) {
+        printf("FAILED: slow EWMA should lag\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Channel Stats Test Program\n");
+
+    failed += TestWelford() != 0;
+    failed += TestEwma() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -1,12 +1,16 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include "cmsis_os2.h"
 #include "data/data_collector.h"
+#include "common/clock.h"
+#include "drivers/sensor/sensor_sim.h"
 
 // 测试配置参数
 #define TEST_COLLECT_INTERVAL    1000    // 采集间隔1秒
 #define TEST_CACHE_SIZE         10      // 缓存10条数据
 #define TEST_RUN_TIME          10000    // 运行10秒
+#define TEST_HISTORY_MAX        64      // 迭代器对比查询的最大记录数
 
 // 数据回调函数
 static void OnData(const SensorData* data)
@@ -34,10 +38,19 @@ static void OnData(const SensorData* data)
             printf("Unknown\n");
             break;
     }
-    printf("Timestamp: %u\n", data->timestamp);
+    printf("Timestamp: %u ms\n", (uint32_t)(data->timestamp / CLOCK_US_PER_MS));
     printf("\n");
 }
 
+// 数据帧回调函数
+static void OnFrame(const SensorFrame* frame)
+{
+    printf("Frame %u - valid 0x%x, updated 0x%x: %.1f°C %.1f%% %.1fppm %.1flux\n",
+        frame->seq, frame->valid_mask, frame->updated_mask,
+        frame->value[SENSOR_CHANNEL_TEMPERATURE], frame->value[SENSOR_CHANNEL_HUMIDITY],
+        frame->value[SENSOR_CHANNEL_SMOKE], frame->value[SENSOR_CHANNEL_LIGHT]);
+}
+
 // 测试基本功能
 void TestBasicFunction(void)
 {
@@ -57,6 +70,7 @@ void TestBasicFunction(void)
     
     // 注册回调函数
     CollectorRegisterCallback(OnData);
+    CollectorRegisterFrameCallback(OnFrame);
     
     // 启动采集
     printf("Starting collector...\n");
@@ -74,6 +88,32 @@ void TestBasicFunction(void)
     printf("Stopping collector...\n");
     CollectorStop();
     
+    // 最新数据帧与最后一次回调的帧一致
+    SensorFrame frame;
+    if (CollectorGetLatestFrame(&frame) == 0) {
+        printf("Latest frame: %u, valid 0x%x\n", frame.seq, frame.valid_mask);
+    }
+    
+    // 打印采集周期时序
+    CollectorTimingStats stats;
+    if (CollectorGetTimingStats(&stats) == 0) {
+        printf("Cycles: %u, Skipped: %u, Max jitter: %ums, Max busy: %ums\n",
+            stats.cycles, stats.skipped, stats.max_jitter_ms, stats.max_busy_ms);
+        printf("Jitter histogram:");
+        for (int i = 0; i < COLLECTOR_JITTER_BUCKETS; i++) {
+            printf(" %u", stats.jitter_histogram[i]);
+        }
+        printf("\n");
+    }
+    
+    // 打印最近的采集周期记录
+    CollectorCycleRecord records[4];
+    uint32_t record_count = 0;
+    if (CollectorGetCycleLog(records, 4, &record_count) == 0 && record_count > 0) {
+        printf("Last %u cycles, latest due %u start %u finish %u\n", record_count,
+            records[record_count - 1].due, records[record_count - 1].start, records[record_count - 1].finish);
+    }
+    
     // 清理
     printf("Cleaning up...\n");
     CollectorDeinit();
@@ -112,11 +152,64 @@ void TestManualTrigger(void)
     CollectorTrigger(SENSOR_TYPE_BH1750);
     sleep(1);
     
+    // 虚拟传感器按需计算, 输入未更新时序号不变
+    SensorData derived;
+    uint32_t seq = 0;
+    uint32_t again = 0;
+    for (SensorType type = SENSOR_TYPE_DEW_POINT; type < SENSOR_TYPE_VIRTUAL_MAX; type++) {
+        if (CollectorGetLatestSnapshot(type, &derived, &seq) == 0 &&
+            CollectorGetLatestSnapshot(type, &derived, &again) == 0) {
+            printf("Virtual sensor %d: %.2f (seq %u, %s)\n", type, derived.data.derived.value, seq,
+                seq == again ? "cached" : "recomputed");
+        }
+    }
+    
+    // 连续按需读取, 第二次在有效期内直接返回
+    SensorData sample;
+    SensorReadStats stats;
+    CollectorReadSensor(SENSOR_TYPE_MQ2, &sample);
+    CollectorReadSensor(SENSOR_TYPE_MQ2, &sample);
+    if (CollectorGetReadStats(SENSOR_TYPE_MQ2, &stats) == 0) {
+        printf("MQ2 reads: bus %u, joined %u, cache hits %u\n",
+            stats.bus_reads, stats.joined, stats.cache_hits);
+    }
+    
     // 清理
     printf("Cleaning up...\n");
     CollectorDeinit();
 }
 
+// 检查历史迭代器与按时间范围查询覆盖相同的样本
+static void CheckHistoryIter(void)
+{
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        SensorData history[TEST_HISTORY_MAX];
+        uint32_t count = 0;
+        CollectorHistoryIter iter;
+        const SensorData* data = NULL;
+        uint32_t matched = 0;
+        bool agree = true;
+        
+        if (CollectorGetHistory(type, 0, UINT64_MAX, history, TEST_HISTORY_MAX, &count) != 0 ||
+            CollectorHistoryIterInit(type, 0, UINT64_MAX, &iter) != 0) {
+            continue;
+        }
+        while ((data = CollectorHistoryIterNext(&iter)) != NULL) {
+            if (matched >= count || data->timestamp != history[matched].timestamp ||
+                memcmp(&data->data, &history[matched].data, sizeof(SensorDataUnion)) != 0) {
+                agree = false;
+                break;
+            }
+            matched++;
+        }
+        if (agree && matched == count) {
+            printf("History iterator matches range query for sensor type %d (%u records)\n", type, count);
+        } else {
+            printf("History iterator mismatch for sensor type %d at %u of %u!\n", type, matched, count);
+        }
+    }
+}
+
 // 测试历史数据
 void TestHistoryData(void)
 {
@@ -164,6 +257,24 @@ void TestHistoryData(void)
         }
     }
     
+    // 按时间范围查询最近2秒的数据
+    for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
+        SensorData latest;
+        SensorData history[TEST_CACHE_SIZE];
+        uint32_t count = 0;
+        
+        if (CollectorGetLatestData(type, &latest) != 0) {
+            continue;
+        }
+        uint64_t since = latest.timestamp - 2 * CLOCK_US_PER_SEC;
+        if (CollectorGetHistory(type, since, latest.timestamp, history, TEST_CACHE_SIZE, &count) == 0) {
+            printf("Found %u records in last 2 seconds for sensor type %d\n", count, type);
+        }
+    }
+    
+    // 迭代器与按时间范围查询覆盖相同的样本
+    CheckHistoryIter();
+    
     // 清除历史数据
     printf("Clearing history data...\n");
     for (SensorType type = SENSOR_TYPE_DHT11; type < SENSOR_TYPE_MAX; type++) {
@@ -175,14 +286,209 @@ void TestHistoryData(void)
     CollectorDeinit();
 }
 
+// 慢速订阅者, 模拟MQTT发布或OLED刷新
+static void OnDataSlow(const SensorData* data)
+{
+    (void)data;
+    osDelay(osKernelGetTickFreq() / 2);
+}
+
+// 测试异步投递
+void TestAsyncDelivery(void)
+{
+    printf("\nTesting async delivery...\n");
+    
+    // 采集间隔100ms, 订阅者每次回调耗时500ms
+    CollectorConfig config = {
+        .collect_interval = 100,
+        .cache_size = TEST_CACHE_SIZE,
+        .delivery = {
+            .mode = DELIVERY_MODE_ASYNC,
+            .policy = DELIVERY_COALESCE
+        }
+    };
+    SubscriptionFilter filter = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK_ALL
+    };
+    
+    if (CollectorInit(&config) != 0) {
+        printf("Failed to initialize collector!\n");
+        return;
+    }
+    CollectorSubscribe(OnDataSlow, &filter);
+    CollectorStart();
+    sleep(TEST_RUN_TIME / 2000);
+    CollectorStop();
+    
+    // 采集周期不受回调耗时影响
+    CollectorTimingStats timing;
+    DeliveryStats delivery;
+    CollectorGetTimingStats(&timing);
+    CollectorGetDeliveryStats(&delivery);
+    printf("Cycles: %u, Max busy: %ums\n", timing.cycles, timing.max_busy_ms);
+    printf("Enqueued: %u, Delivered: %u, Dropped: %u, Coalesced: %u, Max depth: %u\n",
+        delivery.enqueued, delivery.delivered, delivery.dropped, delivery.coalesced, delivery.max_depth);
+    
+    printf("Cleaning up...\n");
+    CollectorDeinit();
+}
+
+// 测试报警触发捕获
+void TestTriggerCapture(void)
+{
+    printf("\nTesting trigger capture...\n");
+    
+    // 触发前保留3秒, 触发后以200ms周期采集2秒
+    CollectorConfig config = {
+        .collect_interval = TEST_COLLECT_INTERVAL,
+        .cache_size = TEST_CACHE_SIZE,
+        .capture = {
+            .pre_ms = 3000,
+            .post_ms = 2000,
+            .burst_period_ms = 200
+        }
+    };
+    
+    if (CollectorInit(&config) != 0 || CollectorStart() != 0) {
+        printf("Failed to start collector!\n");
+        CollectorDeinit();
+        return;
+    }
+    
+    sleep(4);
+    if (CollectorTriggerCapture() != 0) {
+        printf("Failed to trigger capture!\n");
+    }
+    sleep(3);
+    
+    // 捕获的样本直接在缓冲区内访问
+    CaptureView view;
+    if (CollectorGetCapture(&view) == 0) {
+        uint32_t total = view.count[0] + view.count[1];
+        printf("Captured %u samples (pre %u, post %u)%s\n", total, view.pre_count, total - view.pre_count,
+            view.truncated ? ", truncated" : "");
+        CollectorReleaseCapture();
+    } else {
+        printf("Capture not complete!\n");
+    }
+    
+    // 停止采集后检查, 突发采样后的历史跨越迭代器的多个批次
+    CollectorStop();
+    CheckHistoryIter();
+    
+    printf("Cleaning up...\n");
+    CollectorDeinit();
+}
+
+// 测试通过注册表读取模拟驱动
+void TestSimulatedDriver(void)
+{
+    printf("\nTesting simulated driver...\n");
+    
+    CollectorConfig config = {
+        .collect_interval = TEST_COLLECT_INTERVAL,
+        .cache_size = TEST_CACHE_SIZE,
+        .schedule = {
+            [SENSOR_TYPE_DHT11] = {.period_ms = 100}
+        }
+    };
+    
+    if (CollectorInit(&config) != 0) {
+        printf("Failed to initialize collector!\n");
+        return;
+    }
+    
+    // 调度周期按驱动的最小读取间隔限制
+    uint32_t period = 0;
+    CollectorGetSamplePeriod(SENSOR_TYPE_DHT11, &period);
+    printf("DHT11 period: %ums\n", period);
+    
+    // 模拟读数按默认校准系数换算
+    sensor_raw_t raw = {1U << SENSOR_RAW_SMOKE, {0, 0, 500, 0}};
+    SensorData sample;
+    SensorSimSetRaw(SENSOR_TYPE_SMOKE, &raw);
+    if (CollectorReadSensor(SENSOR_TYPE_MQ2, &sample) == 0) {
+        printf("Simulated smoke: %.1fppm\n", sample.data.mq2.smoke);
+    }
+    
+    // 模拟故障, 等待上一次结果过期后读取失败
+    SensorSimSetStatus(SENSOR_TYPE_SMOKE, SENSOR_ERROR_TIMEOUT);
+    usleep(200 * 1000);
+    printf("Read with fault: %s\n", CollectorReadSensor(SENSOR_TYPE_MQ2, &sample) == 0 ? "ok" : "failed");
+    SensorSimSetStatus(SENSOR_TYPE_SMOKE, SENSOR_OK);
+    raw.value[SENSOR_RAW_SMOKE] = 100;
+    SensorSimSetRaw(SENSOR_TYPE_SMOKE, &raw);
+    printf("Simulated reads: %u\n", SensorSimGetReads(SENSOR_TYPE_SMOKE));
+    
+    printf("Cleaning up...\n");
+    CollectorDeinit();
+}
+
+// 测试异步驱动: 采集任务提前触发转换, 到期时读取结果
+void TestAsyncDriver(void)
+{
+    printf("\nTesting async driver...\n");
+    
+    CollectorConfig config = {
+        .collect_interval = TEST_COLLECT_INTERVAL,
+        .cache_size = TEST_CACHE_SIZE,
+        .schedule = {
+            [SENSOR_TYPE_BH1750] = {.period_ms = 500}
+        }
+    };
+    
+    // 模拟BH1750单次高分辨率模式的转换时间
+    SensorSimSetConversion(SENSOR_TYPE_LIGHT, 180);
+    if (CollectorInit(&config) != 0 || CollectorStart() != 0) {
+        printf("Failed to start collector!\n");
+        SensorSimSetConversion(SENSOR_TYPE_LIGHT, 0);
+        return;
+    }
+    
+    sleep(3);
+    CollectorStop();
+    
+    // 转换期间采集任务不等待, 单周期耗时远小于转换时间
+    SensorHealth health;
+    CollectorTimingStats stats;
+    if (CollectorGetSensorHealth(SENSOR_TYPE_BH1750, &health) == 0 && CollectorGetTimingStats(&stats) == 0) {
+        printf("BH1750 reads: %u, failures: %u, max busy: %ums\n",
+            health.total_reads, health.total_failures, stats.max_busy_ms);
+    }
+    
+    // 按需读取及手动触发由采集任务触发转换, 转换完成后读取, 调用者等待
+    SensorData sample;
+    if (CollectorReadSensor(SENSOR_TYPE_BH1750, &sample) == 0) {
+        printf("On-demand light: %.1flux\n", sample.data.bh1750.light);
+    }
+    printf("Trigger BH1750: %s\n", CollectorTrigger(SENSOR_TYPE_BH1750) == 0 ? "ok" : "failed");
+    
+    // 转换未完成时的读取不计数, 每次转换只计一次总线读取(6次周期采集及1次按需读取)
+    SensorReadStats read_stats;
+    if (CollectorGetReadStats(SENSOR_TYPE_BH1750, &read_stats) == 0) {
+        printf("BH1750 bus reads: %u, cache hits: %u\n", read_stats.bus_reads, read_stats.cache_hits);
+    }
+    
+    printf("Cleaning up...\n");
+    CollectorDeinit();
+    SensorSimSetConversion(SENSOR_TYPE_LIGHT, 0);
+}
+
 int main(void)
 {
     printf("Data Collector Test Program\n");
     
+    // 使用模拟驱动, 不依赖传感器硬件
+    SensorSimRegister();
+    
     // 运行测试
     TestBasicFunction();
     TestManualTrigger();
     TestHistoryData();
+    TestAsyncDelivery();
+    TestTriggerCapture();
+    TestSimulatedDriver();
+    TestAsyncDriver();
     
     printf("\nTest completed.\n");
     return 0;
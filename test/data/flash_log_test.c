@@ -0,0 +1,484 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "data/flash_log.h"
+#include "data/flash_backend.h"
+
+// 测试文件
+#define TEST_FILE          "/tmp/flash_log_test.bin"
+
+// 吞吐量测试的分区大小及记录数量
+#define BENCH_SECTORS      64
+#define BENCH_RECORDS      100000
+
+// 单次读取的最大记录数
+#define TEST_READ_MAX      256
+
+static FlashLogEntry g_entries[TEST_READ_MAX];
+
+// 单调时钟(us)
+static uint64_t NowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+// 第i条测试数据, 时间戳即序号
+static void MakeData(SensorData* data, uint32_t i)
+{
+    memset(data, 0, sizeof(SensorData));
+    data->type = (SensorType)(i % SENSOR_TYPE_MAX);
+    data->timestamp = i;
+    data->data.dht11.temperature = (float)i;
+    data->data.dht11.humidity = (float)(i % 100);
+}
+
+// 打开新的测试分区
+static int OpenBlank(FlashBackend* backend, uint32_t sector_size, uint32_t sector_count, uint32_t page_size)
+{
+    unlink(TEST_FILE);
+    return FlashBackendPosixOpen(backend, TEST_FILE, sector_size, sector_count, page_size);
+}
+
+// 读取全部记录, 检查时间戳从first开始连续递增, 返回记录数, 失败返回-1
+static int ReadAll(FlashLog* log, FlashLogCursor* cursor, uint64_t first)
+{
+    uint32_t total = 0;
+    uint32_t count = 0;
+
+    do {
+        if (FlashLogRead(log, cursor, g_entries, TEST_READ_MAX, &count) != 0) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (g_entries[i].data.timestamp != first + total + i ||
+                g_entries[i].data.data.dht11.temperature != (float)(first + total + i)) {
+                printf("Mismatch at %u: ts=%u\n", total + i, (uint32_t)g_entries[i].data.timestamp);
+                return -1;
+            }
+        }
+        total += count;
+    } while (count == TEST_READ_MAX);
+
+    return (int)total;
+}
+
+// 测试追加和读取, 包括页缓冲中尚未写入的记录
+static int TestAppendRead(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLogCursor cursor = {0};
+    FlashLogStats stats;
+    SensorData data;
+
+    printf("\nTesting append and read...\n");
+
+    if (OpenBlank(&backend, 4096, 4, 256) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < 50; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+
+    // 50条记录加扇区头共1216字节, 只写满了4页
+    FlashLogGetStats(&log, &stats);
+    if (ReadAll(&log, &cursor, 0) != 50 || stats.page_writes != 4) {
+        printf("FAILED: unexpected read (page writes %u)\n", stats.page_writes);
+        goto fail;
+    }
+
+    // 游标停在末尾, 只读到新追加的记录
+    for (uint32_t i = 50; i < 60; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    if (ReadAll(&log, &cursor, 50) != 10 || g_entries[0].flags != 0) {
+        printf("FAILED: cursor did not resume\n");
+        goto fail;
+    }
+
+    // 带标志的记录读回时保留标志
+    for (uint32_t i = 60; i < 65; i++) {
+        MakeData(&data, i);
+        FlashLogAppendFlags(&log, &data, FLASH_LOG_FLAG_CAPTURE);
+    }
+    if (ReadAll(&log, &cursor, 60) != 5 || g_entries[4].flags != FLASH_LOG_FLAG_CAPTURE) {
+        printf("FAILED: record flags lost\n");
+        goto fail;
+    }
+
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+
+fail:
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    return -1;
+}
+
+// 测试掉电恢复: 未写入的页缓冲丢失, 写了一半的槽位被跳过
+static int TestRecovery(void)
+{
+    FlashBackend backend;
+    FlashBackend reboot_backend;
+    FlashLog log;
+    FlashLog reboot_log;
+    FlashLogCursor cursor = {0};
+    FlashLogStats stats;
+    SensorData data;
+    uint32_t count = 0;
+    int ret = -1;
+
+    printf("\nTesting recovery...\n");
+
+    if (OpenBlank(&backend, 4096, 4, 256) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    // 写满一个扇区后再写入一部分, 最后3条留在页缓冲中
+    for (uint32_t i = 0; i < log.slots + 20; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    FlashLogFlush(&log);
+    for (uint32_t i = log.slots + 20; i < log.slots + 23; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+
+    // 模拟掉电时写了一半的记录
+    uint8_t torn[4] = {0xA5, 0x00, 0x12, 0x34};
+    backend.write(backend.ctx, 4096 + FLASH_LOG_HEADER_SIZE + 20 * FLASH_LOG_RECORD_SIZE, torn, sizeof(torn));
+
+    // 用同一文件重新打开, 相当于重启后只看到已写入闪存的内容
+    if (FlashBackendPosixOpen(&reboot_backend, TEST_FILE, 4096, 4, 256) != 0 ||
+        FlashLogOpen(&reboot_log, &reboot_backend) != 0) {
+        printf("FAILED: reopen\n");
+        FlashLogClose(&log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    if (reboot_log.active != 1 || reboot_log.write_slot != 21 || reboot_log.boot != 1) {
+        printf("FAILED: recovered slot %u in sector %u, boot %u\n",
+            reboot_log.write_slot, reboot_log.active, reboot_log.boot);
+        goto done;
+    }
+
+    // 重启后继续追加, 写入位置在残缺槽位之后
+    MakeData(&data, log.slots + 20);
+    FlashLogAppend(&reboot_log, &data);
+    FlashLogRead(&reboot_log, &cursor, g_entries, TEST_READ_MAX, &count);
+    FlashLogGetStats(&reboot_log, &stats);
+    if (count != log.slots + 21 || stats.crc_errors != 1 ||
+        g_entries[count - 1].boot != 1 || g_entries[count - 2].boot != 0 ||
+        g_entries[count - 1].data.timestamp != log.slots + 20) {
+        printf("FAILED: read %u records after reboot, crc errors %u\n", count, stats.crc_errors);
+        goto done;
+    }
+
+    ret = 0;
+    printf("PASSED\n");
+
+done:
+    FlashLogClose(&reboot_log);
+    FlashBackendPosixClose(&reboot_backend);
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    return ret;
+}
+
+// 测试扇区轮换: 写满后覆盖最旧扇区, 各扇区擦除次数相差不超过1
+static int TestWrap(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLogCursor cursor = {0};
+    FlashLogCursor stale = {0};
+    FlashLogStats stats;
+    SensorData data;
+    uint32_t count = 0;
+
+    printf("\nTesting sector rotation...\n");
+
+    // 每扇区20个槽位
+    if (OpenBlank(&backend, 512, 4, 64) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < 10; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    FlashLogRead(&log, &stale, g_entries, 5, &count);
+
+    uint32_t total = 20 * 4 * 5 + 7;
+    for (uint32_t i = 10; i < total; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+
+    // 保留最近3个满扇区及当前扇区中的7条记录
+    uint32_t retained = 20 * 3 + 7;
+    if (ReadAll(&log, &cursor, total - retained) != (int)retained) {
+        printf("FAILED: unexpected retained records\n");
+        goto fail;
+    }
+
+    // 游标指向的数据已被覆盖, 从最旧的记录继续
+    FlashLogRead(&log, &stale, g_entries, 1, &count);
+    if (count != 1 || g_entries[0].data.timestamp != total - retained) {
+        printf("FAILED: stale cursor\n");
+        goto fail;
+    }
+
+    FlashLogGetStats(&log, &stats);
+    printf("Erases: %u, erase count min %u max %u\n", stats.erases, stats.min_erase_count, stats.max_erase_count);
+    if (stats.erases != 21 || stats.max_erase_count - stats.min_erase_count > 1) {
+        printf("FAILED: uneven wear\n");
+        goto fail;
+    }
+
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+
+fail:
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    return -1;
+}
+
+// 测试损坏的记录和扇区头被跳过
+static int TestCorruption(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLog reboot_log;
+    FlashLogCursor cursor = {0};
+    FlashLogStats stats;
+    SensorData data;
+    uint32_t count = 0;
+    uint8_t zero = 0;
+
+    printf("\nTesting corruption...\n");
+
+    if (OpenBlank(&backend, 512, 4, 64) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < 50; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    FlashLogClose(&log);
+
+    // 破坏扇区0的扇区头及扇区1中第3条记录的数据
+    backend.write(backend.ctx, 0, &zero, 1);
+    backend.write(backend.ctx, 512 + FLASH_LOG_HEADER_SIZE + 2 * FLASH_LOG_RECORD_SIZE + 23, &zero, 1);
+
+    if (FlashLogOpen(&reboot_log, &backend) != 0) {
+        printf("FAILED: reopen\n");
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+    FlashLogRead(&reboot_log, &cursor, g_entries, TEST_READ_MAX, &count);
+    FlashLogGetStats(&reboot_log, &stats);
+    if (count != 29 || stats.crc_errors != 1 || g_entries[0].data.timestamp != 20 ||
+        g_entries[2].data.timestamp != 23) {
+        printf("FAILED: read %u records, crc errors %u\n", count, stats.crc_errors);
+        FlashLogClose(&reboot_log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    FlashLogClose(&reboot_log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试不属于日志的扇区不会被擦除
+static int TestForeignSector(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLogCursor cursor = {0};
+    FlashLogStats stats;
+    SensorData data;
+    uint8_t foreign[32];
+    uint8_t check[32];
+
+    printf("\nTesting foreign sector...\n");
+
+    if (OpenBlank(&backend, 512, 4, 64) != 0) {
+        printf("FAILED: open backend\n");
+        return -1;
+    }
+
+    // 扇区2中有其他模块写入的数据
+    for (uint32_t i = 0; i < sizeof(foreign); i++) {
+        foreign[i] = (uint8_t)(i * 7);
+    }
+    backend.write(backend.ctx, 2 * 512 + 100, foreign, sizeof(foreign));
+
+    if (FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    // 在其余3个扇区中轮换, 保留最新的60条记录
+    for (uint32_t i = 0; i < 100; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    FlashLogFlush(&log);
+    FlashLogGetStats(&log, &stats);
+
+    backend.read(backend.ctx, 2 * 512 + 100, check, sizeof(check));
+    int total = ReadAll(&log, &cursor, 40);
+    printf("Foreign sectors: %u, Erases: %u, Records: %d\n", stats.foreign_sectors, stats.erases, total);
+    if (stats.foreign_sectors != 1 || memcmp(check, foreign, sizeof(check)) != 0 || total != 60) {
+        printf("FAILED: foreign sector overwritten\n");
+        FlashLogClose(&log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试提前擦除下一个扇区
+static int TestPrepare(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLog reboot_log;
+    FlashLogCursor cursor = {0};
+    FlashLogStats stats;
+    SensorData data;
+
+    printf("\nTesting sector prepare...\n");
+
+    if (OpenBlank(&backend, 512, 4, 64) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    // 写满扇区0和1, 扇区1剩余不多时提前擦除扇区2
+    for (uint32_t i = 0; i < 40; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+        FlashLogPrepare(&log);
+    }
+    FlashLogGetStats(&log, &stats);
+    uint32_t erases = stats.erases;
+
+    // 切换到扇区2时不再擦除
+    MakeData(&data, 40);
+    FlashLogAppend(&log, &data);
+    FlashLogGetStats(&log, &stats);
+    printf("Erases before switch: %u, after: %u\n", erases, stats.erases);
+    if (erases != 3 || stats.erases != erases) {
+        printf("FAILED: erase not done ahead\n");
+        FlashLogClose(&log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    // 重新打开后记录完整
+    FlashLogClose(&log);
+    if (FlashLogOpen(&reboot_log, &backend) != 0 || ReadAll(&reboot_log, &cursor, 0) != 41) {
+        printf("FAILED: reopen\n");
+        FlashLogClose(&reboot_log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    FlashLogClose(&reboot_log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测量写入吞吐量和启动恢复时间
+static int TestBenchmark(void)
+{
+    FlashBackend backend;
+    FlashLog log;
+    FlashLogStats stats;
+    SensorData data;
+
+    printf("\nTesting throughput and recovery time...\n");
+
+    if (OpenBlank(&backend, 4096, BENCH_SECTORS, 256) != 0 || FlashLogOpen(&log, &backend) != 0) {
+        printf("FAILED: open\n");
+        return -1;
+    }
+
+    uint64_t start = NowUs();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        MakeData(&data, i);
+        FlashLogAppend(&log, &data);
+    }
+    FlashLogFlush(&log);
+    uint64_t elapsed = NowUs() - start;
+    FlashLogGetStats(&log, &stats);
+    uint32_t write_slot = log.write_slot;
+    FlashLogClose(&log);
+
+    printf("Append: %u records in %u us (%.0f records/s), %u page writes, %u erases\n",
+        BENCH_RECORDS, (uint32_t)elapsed, BENCH_RECORDS * 1e6 / (elapsed > 0 ? elapsed : 1),
+        stats.page_writes, stats.erases);
+
+    start = NowUs();
+    int ret = FlashLogOpen(&log, &backend);
+    elapsed = NowUs() - start;
+    printf("Recovery: %u sectors in %u us\n", BENCH_SECTORS, (uint32_t)elapsed);
+    if (ret != 0 || log.write_slot != write_slot) {
+        printf("FAILED: recovered slot %u, expected %u\n", log.write_slot, write_slot);
+        FlashLogClose(&log);
+        FlashBackendPosixClose(&backend);
+        return -1;
+    }
+
+    FlashLogClose(&log);
+    FlashBackendPosixClose(&backend);
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Flash Log Test Program\n");
+
+    failed += TestAppendRead() != 0;
+    failed += TestRecovery() != 0;
+    failed += TestWrap() != 0;
+    failed += TestCorruption() != 0;
+    failed += TestForeignSector() != 0;
+    failed += TestPrepare() != 0;
+    failed += TestBenchmark() != 0;
+
+    unlink(TEST_FILE);
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/sample_filter.h"
+
+// 浮点比较容差
+#define TEST_EPSILON 0.01f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试中值滤波去除孤立毛刺
+static int TestMedian(void)
+{
+    SampleFilter filter;
+    ChannelFilterConfig config = {
+        .stage_count = 1,
+        .stages = {{.type = FILTER_STAGE_MEDIAN, .window = 3}}
+    };
+    const float input[] = {25.0f, 25.1f, 85.0f, 25.2f, 25.3f, -40.0f, 25.4f};
+    const float expect[] = {25.0f, 25.1f, 25.1f, 25.2f, 25.3f, 25.2f, 25.3f};
+
+    printf("\nTesting median...\n");
+
+    if (SampleFilterInit(&filter, SENSOR_CHANNEL_TEMPERATURE, &config) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+    for (uint32_t i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+        float output = SampleFilterApply(&filter, input[i], 1000);
+        if (!FloatEqual(output, expect[i])) {
+            printf("FAILED: step %u, output %.2f, expected %.2f\n", i, output, expect[i]);
+            return -1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试变化率限制与指数平滑串联
+static int TestRateLimitAndEma(void)
+{
+    SampleFilter filter;
+    ChannelFilterConfig config = {
+        .stage_count = 2,
+        .stages = {
+            {.type = FILTER_STAGE_RATE_LIMIT, .max_rate = 2.0f},
+            {.type = FILTER_STAGE_EMA, .alpha = 0.5f}
+        }
+    };
+
+    printf("\nTesting rate limit and EMA...\n");
+
+    SampleFilterInit(&filter, SENSOR_CHANNEL_HUMIDITY, &config);
+    SampleFilterApply(&filter, 50.0f, 0);
+
+    // 500ms内最多变化1.0, 限幅为51.0, 平滑后为50.5
+    float output = SampleFilterApply(&filter, 80.0f, 500);
+    printf("Output: %.2f\n", output);
+    if (!FloatEqual(output, 50.5f) || !FloatEqual(filter.state[0].output, 51.0f)) {
+        printf("FAILED: unexpected output\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试定点低通的阶跃响应
+static int TestIir(void)
+{
+    SampleFilter filter;
+    ChannelFilterConfig config = {
+        .stage_count = 1,
+        .stages = {{.type = FILTER_STAGE_IIR, .shift = 2}}
+    };
+    float output = 0.0f;
+
+    printf("\nTesting fixed-point IIR...\n");
+
+    SampleFilterInit(&filter, SENSOR_CHANNEL_SMOKE, &config);
+    SampleFilterApply(&filter, 0.0f, 100);
+
+    // 每步逼近剩余差值的1/4
+    output = SampleFilterApply(&filter, 100.0f, 100);
+    if (!FloatEqual(output, 25.0f)) {
+        printf("FAILED: first step %.2f\n", output);
+        return -1;
+    }
+    for (uint32_t i = 0; i < 60; i++) {
+        output = SampleFilterApply(&filter, 100.0f, 100);
+    }
+    printf("Settled: %.2f\n", output);
+    if (output < 99.85f || output > 100.0f) {
+        printf("FAILED: did not settle\n");
+        return -1;
+    }
+
+    // 零下温度的定点值为负数
+    SampleFilterInit(&filter, SENSOR_CHANNEL_TEMPERATURE, &config);
+    SampleFilterApply(&filter, 0.0f, 100);
+    output = SampleFilterApply(&filter, -10.0f, 100);
+    if (!FloatEqual(output, -2.5f)) {
+        printf("FAILED: negative step %.2f\n", output);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试非法参数被拒绝
+static int TestInvalidConfig(void)
+{
+    SampleFilter filter;
+    ChannelFilterConfig config = {
+        .stage_count = 1,
+        .stages = {{.type = FILTER_STAGE_MEDIAN, .window = 4}}
+    };
+
+    printf("\nTesting invalid config...\n");
+
+    if (SampleFilterInit(&filter, SENSOR_CHANNEL_LIGHT, &config) == 0) {
+        printf("FAILED: even median window accepted\n");
+        return -1;
+    }
+    config.stages[0].type = FILTER_STAGE_EMA;
+    config.stages[0].alpha = 1.5f;
+    if (SampleFilterInit(&filter, SENSOR_CHANNEL_LIGHT, &config) == 0) {
+        printf("FAILED: alpha out of range accepted\n");
+        return -1;
+    }
+    config.stage_count = COLLECTOR_FILTER_STAGES + 1;
+    if (SampleFilterInit(&filter, SENSOR_CHANNEL_LIGHT, &config) == 0) {
+        printf("FAILED: too many stages accepted\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sample Filter Test Program\n");
+
+    failed += TestMedian() != 0;
+    failed += TestRateLimitAndEma() != 0;
+    failed += TestIir() != 0;
+    failed += TestInvalidConfig() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
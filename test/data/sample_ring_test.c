@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/sample_ring.h"
+
+// 测试缓存容量
+#define TEST_RING_SIZE  8
+
+// 生成测试样本, 时间戳即写入序号
+static void MakeSample(SensorData* data, uint32_t seq)
+{
+    memset(data, 0, sizeof(SensorData));
+    data->type = SENSOR_TYPE_MQ2;
+    data->data.mq2.smoke = (float)seq;
+    data->timestamp = seq;
+}
+
+// 测试写满后覆盖最旧样本
+static int TestOverwrite(void)
+{
+    SensorData storage[TEST_RING_SIZE];
+    SensorData out[TEST_RING_SIZE];
+    SampleRing ring;
+    SensorData data;
+    uint32_t count = 0;
+    uint32_t first = 0;
+
+    printf("\nTesting overwrite...\n");
+
+    SampleRingInit(&ring, storage, TEST_RING_SIZE);
+    for (uint32_t i = 0; i < TEST_RING_SIZE * 2 + 3; i++) {
+        MakeSample(&data, i);
+        SampleRingPush(&ring, &data);
+    }
+
+    if (SampleRingRead(&ring, 0, out, TEST_RING_SIZE, &count, &first) != 0) {
+        printf("FAILED: read error\n");
+        return -1;
+    }
+
+    printf("Count: %u, First: %u\n", count, first);
+    if (count != TEST_RING_SIZE || first != TEST_RING_SIZE + 3) {
+        printf("FAILED: unexpected range\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (out[i].timestamp != first + i) {
+            printf("FAILED: sample %u out of order\n", i);
+            return -1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试游标增量读取与清除
+static int TestCursorAndClear(void)
+{
+    SensorData storage[TEST_RING_SIZE];
+    SensorData out[TEST_RING_SIZE];
+    SampleRing ring;
+    SensorData data;
+    uint32_t count = 0;
+    uint32_t first = 0;
+
+    printf("\nTesting cursor and clear...\n");
+
+    SampleRingInit(&ring, storage, TEST_RING_SIZE);
+    for (uint32_t i = 0; i < 5; i++) {
+        MakeSample(&data, i);
+        SampleRingPush(&ring, &data);
+    }
+
+    SampleRingRead(&ring, 3, out, TEST_RING_SIZE, &count, &first);
+    if (count != 2 || first != 3) {
+        printf("FAILED: cursor read count=%u first=%u\n", count, first);
+        return -1;
+    }
+
+    SampleRingClear(&ring);
+    SampleRingRead(&ring, 0, out, TEST_RING_SIZE, &count, &first);
+    if (count != 0) {
+        printf("FAILED: %u samples after clear\n", count);
+        return -1;
+    }
+
+    MakeSample(&data, 5);
+    SampleRingPush(&ring, &data);
+    SampleRingRead(&ring, 0, out, TEST_RING_SIZE, &count, &first);
+    if (count != 1 || out[0].timestamp != 5) {
+        printf("FAILED: read after clear\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试迭代过程中生产者覆盖样本
+static int TestIterOverrun(void)
+{
+    SensorData storage[TEST_RING_SIZE];
+    SampleRing ring;
+    SampleRingIter iter;
+    SensorData data;
+    uint32_t last = 0;
+    uint32_t seen = 0;
+
+    printf("\nTesting iterator overrun...\n");
+
+    SampleRingInit(&ring, storage, TEST_RING_SIZE);
+    for (uint32_t i = 0; i < TEST_RING_SIZE; i++) {
+        MakeSample(&data, i);
+        SampleRingPush(&ring, &data);
+    }
+
+    SampleRingIterInit(&ring, &iter);
+    uint32_t next = TEST_RING_SIZE;
+    while (SampleRingIterNext(&iter, &data)) {
+        // 读取第一个样本后生产者写入4个新样本
+        if (seen == 0) {
+            for (int i = 0; i < 4; i++) {
+                SensorData fresh;
+                MakeSample(&fresh, next++);
+                SampleRingPush(&ring, &fresh);
+            }
+        } else if (data.timestamp <= last) {
+            printf("FAILED: sample out of order\n");
+            return -1;
+        }
+        last = data.timestamp;
+        seen++;
+    }
+
+    // 序号0已读出, 序号1-3被覆盖, 剩余4-7
+    printf("Seen: %u, Last: %u\n", seen, last);
+    if (seen != 5 || last != TEST_RING_SIZE - 1) {
+        printf("FAILED: unexpected iteration\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试按时间戳二分查找
+static int TestFindTime(void)
+{
+    SensorData storage[TEST_RING_SIZE];
+    SampleRing ring;
+    SampleRingIter iter;
+    SensorData data;
+    uint32_t seq = 0;
+
+    printf("\nTesting find by timestamp...\n");
+
+    // 写入20个样本, 时间戳为序号的10倍, 缓存中保留序号12-19
+    SampleRingInit(&ring, storage, TEST_RING_SIZE);
+    for (uint32_t i = 0; i < 20; i++) {
+        MakeSample(&data, i);
+        data.timestamp = i * 10;
+        SampleRingPush(&ring, &data);
+    }
+
+    uint32_t begin = SampleRingFindTime(&ring, 135, false);
+    uint32_t end = SampleRingFindTime(&ring, 170, true);
+    printf("Begin: %u, End: %u\n", begin, end);
+    if (begin != 14 || end != 18) {
+        printf("FAILED: unexpected range\n");
+        return -1;
+    }
+
+    // 早于缓存范围的时间戳收敛到最旧样本
+    if (SampleRingFindTime(&ring, 0, false) != 12 || SampleRingFindTime(&ring, 1000, false) != 20) {
+        printf("FAILED: out of range lookup\n");
+        return -1;
+    }
+
+    // 零拷贝遍历范围内的样本
+    uint32_t count = 0;
+    SampleRingIterInitRange(&ring, &iter, begin, end);
+    const SensorData* ref = NULL;
+    while ((ref = SampleRingIterNextRef(&iter, &seq)) != NULL) {
+        if (ref->timestamp != seq * 10 || !SampleRingIsValid(&ring, seq)) {
+            printf("FAILED: bad reference at %u\n", seq);
+            return -1;
+        }
+        count++;
+    }
+    if (count != 4) {
+        printf("FAILED: iterated %u samples\n", count);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sample Ring Test Program\n");
+
+    failed += TestOverwrite() != 0;
+    failed += TestCursorAndClear() != 0;
+    failed += TestIterOverrun() != 0;
+    failed += TestFindTime() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
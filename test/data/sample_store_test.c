@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/sample_store.h"
+#include "common/clock.h"
+
+// 测试存储容量
+#define TEST_STORE_SIZE  16
+
+// 浮点比较容差
+#define TEST_EPSILON     0.01f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试定点编解码
+static int TestCodec(void)
+{
+    printf("\nTesting fixed-point codec...\n");
+
+    if (!FloatEqual(SampleStoreDecode(SENSOR_CHANNEL_TEMPERATURE,
+        SampleStoreEncode(SENSOR_CHANNEL_TEMPERATURE, 23.45f)), 23.45f)) {
+        printf("FAILED: temperature\n");
+        return -1;
+    }
+    if (!FloatEqual(SampleStoreDecode(SENSOR_CHANNEL_TEMPERATURE,
+        SampleStoreEncode(SENSOR_CHANNEL_TEMPERATURE, -12.3f)), -12.3f)) {
+        printf("FAILED: negative temperature\n");
+        return -1;
+    }
+    if (!FloatEqual(SampleStoreDecode(SENSOR_CHANNEL_LIGHT,
+        SampleStoreEncode(SENSOR_CHANNEL_LIGHT, 54612.0f)), 54612.0f)) {
+        printf("FAILED: light\n");
+        return -1;
+    }
+    if (SampleStoreEncode(SENSOR_CHANNEL_HUMIDITY, 10000.0f) != INT16_MAX) {
+        printf("FAILED: saturation\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试写满覆盖及时间戳还原
+static int TestAppendAndRead(void)
+{
+    SampleStore store;
+    SensorData data;
+    SensorData out[TEST_STORE_SIZE];
+    uint32_t count = 0;
+
+    printf("\nTesting append and read...\n");
+
+    if (SampleStoreInit(&store, SENSOR_TYPE_DHT11, TEST_STORE_SIZE) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+
+    // 写入40个样本, 间隔不等(ms)
+    uint32_t ts = 1000;
+    for (uint32_t i = 0; i < 40; i++) {
+        memset(&data, 0, sizeof(data));
+        data.type = SENSOR_TYPE_DHT11;
+        data.timestamp = ts * CLOCK_US_PER_MS;
+        data.data.dht11.temperature = 20.0f + i * 0.1f;
+        data.data.dht11.humidity = 40.0f + i;
+        SampleStoreAppend(&store, &data);
+        ts += 100 + (i % 3) * 10;
+    }
+
+    SampleStoreRead(&store, 0, out, TEST_STORE_SIZE, &count);
+    printf("Count: %u, First ts: %u ms, Last ts: %u ms\n", count,
+        (uint32_t)(out[0].timestamp / CLOCK_US_PER_MS), (uint32_t)(out[count - 1].timestamp / CLOCK_US_PER_MS));
+    if (count != TEST_STORE_SIZE || out[count - 1].timestamp != data.timestamp) {
+        printf("FAILED: unexpected range\n");
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    // 逐个核对最旧样本之后的数值和时间差
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t seq = 40 - TEST_STORE_SIZE + i;
+        if (!FloatEqual(out[i].data.dht11.temperature, 20.0f + seq * 0.1f) ||
+            !FloatEqual(out[i].data.dht11.humidity, 40.0f + seq)) {
+            printf("FAILED: value mismatch at %u\n", i);
+            SampleStoreDeinit(&store);
+            return -1;
+        }
+        if (i > 0 && out[i].timestamp - out[i - 1].timestamp != (100 + ((seq - 1) % 3) * 10) * CLOCK_US_PER_MS) {
+            printf("FAILED: timestamp mismatch at %u\n", i);
+            SampleStoreDeinit(&store);
+            return -1;
+        }
+    }
+
+    // 按起始时间查询
+    SampleStoreRead(&store, out[count - 4].timestamp, out, TEST_STORE_SIZE, &count);
+    if (count != 4) {
+        printf("FAILED: since query returned %u\n", count);
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    SampleStoreDeinit(&store);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试通道扫描
+static int TestScan(void)
+{
+    SampleStore store;
+    SensorData data;
+    int16_t min = 0;
+    int16_t max = 0;
+    int32_t sum = 0;
+    uint32_t count = 0;
+
+    printf("\nTesting channel scan...\n");
+
+    SampleStoreInit(&store, SENSOR_TYPE_MQ2, TEST_STORE_SIZE);
+    for (uint32_t i = 0; i < 20; i++) {
+        memset(&data, 0, sizeof(data));
+        data.type = SENSOR_TYPE_MQ2;
+        data.timestamp = i * 50 * CLOCK_US_PER_MS;
+        data.data.mq2.smoke = (float)i;
+        SampleStoreAppend(&store, &data);
+    }
+
+    // 最近10个样本: 10-19ppm
+    SampleStoreScan(&store, SENSOR_CHANNEL_SMOKE, 500 * CLOCK_US_PER_MS, &min, &max, &sum, &count);
+    printf("Min: %d, Max: %d, Sum: %d, Count: %u\n", min, max, (int)sum, count);
+    if (count != 10 || min != 100 || max != 190 || sum != 1450) {
+        printf("FAILED: unexpected scan result\n");
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    SampleStoreDeinit(&store);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 追加一个MQ2样本
+static void AppendSmoke(SampleStore* store, uint64_t ts_ms, float smoke)
+{
+    SensorData data;
+
+    memset(&data, 0, sizeof(data));
+    data.type = SENSOR_TYPE_MQ2;
+    data.timestamp = ts_ms * CLOCK_US_PER_MS;
+    data.data.mq2.smoke = smoke;
+    SampleStoreAppend(store, &data);
+}
+
+// 测试长间隔(停止后重新启动)保留之前的样本
+static int TestGap(void)
+{
+    SampleStore store;
+    SensorData out[TEST_STORE_SIZE];
+    uint32_t count = 0;
+
+    printf("\nTesting long gap...\n");
+
+    SampleStoreInit(&store, SENSOR_TYPE_MQ2, TEST_STORE_SIZE);
+    for (uint32_t i = 0; i < 4; i++) {
+        AppendSmoke(&store, 1000 + i * 100, (float)i);
+    }
+    // 间隔70秒和1小时, 超出16位毫秒差值范围
+    AppendSmoke(&store, 71300, 4.0f);
+    AppendSmoke(&store, 71400, 5.0f);
+    AppendSmoke(&store, 3671400, 6.0f);
+
+    SampleStoreRead(&store, 0, out, TEST_STORE_SIZE, &count);
+    printf("Count: %u, First ts: %u ms, Last ts: %u ms\n", count,
+        (uint32_t)(out[0].timestamp / CLOCK_US_PER_MS), (uint32_t)(out[count - 1].timestamp / CLOCK_US_PER_MS));
+    if (count != 7 || out[0].timestamp != 1000 * CLOCK_US_PER_MS || out[4].timestamp != 71300 * CLOCK_US_PER_MS ||
+        out[6].timestamp != 3671400ULL * CLOCK_US_PER_MS || !FloatEqual(out[3].data.mq2.smoke, 3.0f)) {
+        printf("FAILED: samples before gap lost\n");
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    // 按时间范围读取跨越长间隔的样本
+    SampleStoreReadRange(&store, 1200 * CLOCK_US_PER_MS, 71300 * CLOCK_US_PER_MS, out, TEST_STORE_SIZE, &count);
+    if (count != 3 || out[0].timestamp != 1200 * CLOCK_US_PER_MS || out[2].timestamp != 71300 * CLOCK_US_PER_MS) {
+        printf("FAILED: range across gap, count=%u\n", count);
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    // 长间隔超出记录数量时丢弃最早一段样本
+    uint64_t ts = 3671400;
+    for (uint32_t i = 0; i < SAMPLE_STORE_MAX_GAPS - 1; i++) {
+        ts += 100000;
+        AppendSmoke(&store, ts, 7.0f + i);
+    }
+    SampleStoreRead(&store, 0, out, TEST_STORE_SIZE, &count);
+    if (count != 6 || out[0].timestamp != 71300 * CLOCK_US_PER_MS || out[count - 1].timestamp != ts * CLOCK_US_PER_MS) {
+        printf("FAILED: oldest segment, count=%u\n", count);
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    // 写满覆盖时长间隔随样本一起移出
+    for (uint32_t i = 0; i < TEST_STORE_SIZE; i++) {
+        ts += 100;
+        AppendSmoke(&store, ts, 20.0f + i);
+    }
+    SampleStoreRead(&store, 0, out, TEST_STORE_SIZE, &count);
+    if (count != TEST_STORE_SIZE || store.gap_count != 0 || out[0].timestamp != (ts - 1500) * CLOCK_US_PER_MS) {
+        printf("FAILED: overwrite, count=%u gaps=%u\n", count, store.gap_count);
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    SampleStoreDeinit(&store);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 锚点测试的存储容量, 不是锚点间隔的整数倍
+#define ANCHOR_STORE_SIZE  100
+#define ANCHOR_SAMPLES     250
+
+// 测试按锚点二分查找起点, 与逐个比较的结果一致
+static int TestAnchorSearch(void)
+{
+    SampleStore store;
+    static SensorData out[ANCHOR_STORE_SIZE];
+    uint64_t expected[ANCHOR_SAMPLES];
+    uint32_t count = 0;
+
+    printf("\nTesting anchor search...\n");
+
+    if (SampleStoreInit(&store, SENSOR_TYPE_MQ2, ANCHOR_STORE_SIZE) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+
+    // 间隔不等, 中间有一次超出16位差值范围的长间隔
+    uint64_t ts = 1000;
+    for (uint32_t i = 0; i < ANCHOR_SAMPLES; i++) {
+        expected[i] = ts * CLOCK_US_PER_MS;
+        AppendSmoke(&store, ts, (float)i);
+        ts += (i == 180) ? 70000 : 50 + (i * 7) % 40;
+    }
+
+    // 起点分别取每个样本的时间戳及其前后1ms
+    uint32_t oldest = ANCHOR_SAMPLES - ANCHOR_STORE_SIZE;
+    for (uint32_t i = oldest; i < ANCHOR_SAMPLES; i++) {
+        for (int offset = -1; offset <= 1; offset++) {
+            uint64_t since = expected[i] + offset * (int64_t)CLOCK_US_PER_MS;
+            uint32_t first = oldest;
+            while (first < ANCHOR_SAMPLES && expected[first] < since) {
+                first++;
+            }
+
+            SampleStoreReadRange(&store, since, UINT64_MAX, out, ANCHOR_STORE_SIZE, &count);
+            if (count != ANCHOR_SAMPLES - first ||
+                (count > 0 && (out[0].timestamp != expected[first] ||
+                !FloatEqual(out[0].data.mq2.smoke, (float)first)))) {
+                printf("FAILED: since sample %u%+d, count=%u\n", i, offset, count);
+                SampleStoreDeinit(&store);
+                return -1;
+            }
+        }
+    }
+
+    // 超过max_count时返回最新的样本, 时间戳同样由锚点还原
+    SampleStoreRead(&store, 0, out, 10, &count);
+    if (count != 10 || out[0].timestamp != expected[ANCHOR_SAMPLES - 10] ||
+        out[9].timestamp != expected[ANCHOR_SAMPLES - 1]) {
+        printf("FAILED: latest samples\n");
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    SampleStoreDeinit(&store);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试分块复制后解码, 与直接读取的结果一致
+static int TestChunkCopy(void)
+{
+    SampleStore store;
+    static SensorData out[ANCHOR_STORE_SIZE];
+    SensorData data;
+    SampleStoreChunk chunk;
+    uint32_t count = 0;
+
+    printf("\nTesting chunk copy...\n");
+
+    if (SampleStoreInit(&store, SENSOR_TYPE_DHT11, ANCHOR_STORE_SIZE) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+    for (uint32_t i = 0; i < ANCHOR_SAMPLES; i++) {
+        memset(&data, 0, sizeof(data));
+        data.type = SENSOR_TYPE_DHT11;
+        data.timestamp = (1000 + i * 100 + i % 7) * CLOCK_US_PER_MS;
+        data.data.dht11.temperature = 20.0f + i * 0.1f;
+        data.data.dht11.humidity = 40.0f + i % 50;
+        SampleStoreAppend(&store, &data);
+    }
+
+    uint64_t since = (1000 + 200 * 100) * CLOCK_US_PER_MS;
+    uint64_t until = (1000 + 240 * 100) * CLOCK_US_PER_MS;
+    SampleStoreReadRange(&store, since, until, out, ANCHOR_STORE_SIZE, &count);
+
+    // 逐块复制直到块未满
+    uint32_t copied = 0;
+    uint32_t sequence = SampleStoreSeek(&store, since, UINT32_MAX);
+    do {
+        SampleStoreCopy(&store, sequence, until, &chunk);
+        for (uint32_t i = 0; i < chunk.count; i++, copied++) {
+            SampleStoreDecodeChunk(&store, &chunk, i, &data);
+            if (copied >= count || data.timestamp != out[copied].timestamp ||
+                !FloatEqual(data.data.dht11.humidity, out[copied].data.dht11.humidity)) {
+                printf("FAILED: chunk sample %u\n", copied);
+                SampleStoreDeinit(&store);
+                return -1;
+            }
+        }
+        sequence = chunk.next;
+    } while (chunk.count == SAMPLE_STORE_CHUNK_SIZE);
+    if (copied != count) {
+        printf("FAILED: copied %u of %u\n", copied, count);
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    // 已被覆盖的序号从最旧的样本开始, 最新max_count个的起点
+    SampleStoreCopy(&store, 0, UINT64_MAX, &chunk);
+    if (chunk.next != ANCHOR_SAMPLES - ANCHOR_STORE_SIZE + SAMPLE_STORE_CHUNK_SIZE ||
+        SampleStoreSeek(&store, 0, 10) != ANCHOR_SAMPLES - 10) {
+        printf("FAILED: sequence clamp\n");
+        SampleStoreDeinit(&store);
+        return -1;
+    }
+
+    SampleStoreDeinit(&store);
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sample Store Test Program\n");
+
+    failed += TestCodec() != 0;
+    failed += TestAppendAndRead() != 0;
+    failed += TestScan() != 0;
+    failed += TestGap() != 0;
+    failed += TestAnchorSearch() != 0;
+    failed += TestChunkCopy() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include "data/sensor_health.h"
+
+// 测试采集周期(ms)
+#define TEST_PERIOD_MS 2000
+
+static const HealthPolicy g_policy = {
+    .max_retries = 2,
+    .retry_delay_ms = 100,
+    .degrade_threshold = 5,
+    .max_backoff_ms = 10000
+};
+
+// 测试周期内重试
+static int TestRetry(void)
+{
+    SensorHealth health;
+
+    printf("\nTesting retry within period...\n");
+
+    SensorHealthInit(&health);
+
+    // 失败后依次延迟100ms, 200ms重试, 重试用完后等下一周期
+    uint32_t first = SensorHealthReport(&health, &g_policy, false, TEST_PERIOD_MS, 0);
+    uint32_t second = SensorHealthReport(&health, &g_policy, false, TEST_PERIOD_MS, 100);
+    uint32_t third = SensorHealthReport(&health, &g_policy, false, TEST_PERIOD_MS, 300);
+    printf("Delays: %u, %u, %u\n", first, second, third);
+    if (first != 100 || second != 200 || third != 0 || health.state != SENSOR_HEALTH_RETRYING) {
+        printf("FAILED: unexpected retry delays\n");
+        return -1;
+    }
+
+    // 成功后恢复正常
+    if (SensorHealthReport(&health, &g_policy, true, TEST_PERIOD_MS, 2300) != 0 ||
+        health.state != SENSOR_HEALTH_OK || health.consecutive_failures != 0 ||
+        health.last_success_ts != 2300 || health.total_reads != 4 || health.total_failures != 3) {
+        printf("FAILED: recovery not recorded\n");
+        return -1;
+    }
+
+    // 重试延迟不短于周期时不重试
+    if (SensorHealthReport(&health, &g_policy, false, 50, 2400) != 0) {
+        printf("FAILED: retry longer than period\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试降级退避
+static int TestDegrade(void)
+{
+    SensorHealth health;
+    uint32_t delay = 0;
+
+    printf("\nTesting degraded backoff...\n");
+
+    SensorHealthInit(&health);
+    for (uint32_t i = 0; i < g_policy.degrade_threshold - 1; i++) {
+        SensorHealthReport(&health, &g_policy, false, TEST_PERIOD_MS, i);
+    }
+    if (health.state == SENSOR_HEALTH_DEGRADED) {
+        printf("FAILED: degraded too early\n");
+        return -1;
+    }
+
+    // 间隔从两个周期起加倍, 不超过上限
+    static const uint32_t expected[] = {4000, 8000, 10000, 10000};
+    for (uint32_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        delay = SensorHealthReport(&health, &g_policy, false, TEST_PERIOD_MS, 0);
+        printf("Backoff: %u ms\n", delay);
+        if (delay != expected[i] || health.state != SENSOR_HEALTH_DEGRADED || health.backoff_ms != delay) {
+            printf("FAILED: unexpected backoff\n");
+            return -1;
+        }
+    }
+
+    // 一次成功即恢复正常周期
+    if (SensorHealthReport(&health, &g_policy, true, TEST_PERIOD_MS, 0) != 0 ||
+        health.state != SENSOR_HEALTH_OK || health.backoff_ms != 0) {
+        printf("FAILED: not recovered\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sensor Health Test Program\n");
+
+    failed += TestRetry() != 0;
+    failed += TestDegrade() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include "data/sensor_scheduler.h"
+
+// 测试用调度项标识
+#define TEST_ID_SLOW    0    // 慢速传感器(1Hz)
+#define TEST_ID_FAST    1    // 快速传感器(20Hz)
+#define TEST_ID_MEDIUM  2    // 中速传感器(2Hz)
+
+// 模拟时间长度(tick, 1tick=1ms)
+#define TEST_RUN_TICKS  10000
+
+// 测试调度顺序与各调度项的执行次数
+static int TestSchedulingRate(void)
+{
+    SensorScheduler sched;
+    uint32_t runs[3] = {0};
+
+    printf("\nTesting scheduling rate...\n");
+
+    SchedulerInit(&sched);
+    SchedulerAdd(&sched, TEST_ID_SLOW, 1000, 0, 1);
+    SchedulerAdd(&sched, TEST_ID_FAST, 50, 10, 3);
+    SchedulerAdd(&sched, TEST_ID_MEDIUM, 500, 20, 2);
+
+    for (uint32_t now = 0; now < TEST_RUN_TICKS; now++) {
+        SchedulerEntry entry;
+        while (SchedulerPopDue(&sched, now, &entry) == 0) {
+            runs[entry.id]++;
+            SchedulerReschedule(&sched, &entry, now, NULL);
+        }
+    }
+
+    printf("Slow: %u, Fast: %u, Medium: %u\n", runs[TEST_ID_SLOW], runs[TEST_ID_FAST], runs[TEST_ID_MEDIUM]);
+    if (runs[TEST_ID_SLOW] != 10 || runs[TEST_ID_FAST] != 200 || runs[TEST_ID_MEDIUM] != 20) {
+        printf("FAILED: unexpected run count\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试同时到期时按优先级执行
+static int TestPriority(void)
+{
+    SensorScheduler sched;
+    SchedulerEntry entry;
+
+    printf("\nTesting priority...\n");
+
+    SchedulerInit(&sched);
+    SchedulerAdd(&sched, TEST_ID_SLOW, 100, 0, 1);
+    SchedulerAdd(&sched, TEST_ID_FAST, 100, 0, 3);
+    SchedulerAdd(&sched, TEST_ID_MEDIUM, 100, 0, 2);
+
+    const uint8_t expected[] = {TEST_ID_FAST, TEST_ID_MEDIUM, TEST_ID_SLOW};
+    for (int i = 0; i < 3; i++) {
+        if (SchedulerPopDue(&sched, 0, &entry) != 0 || entry.id != expected[i]) {
+            printf("FAILED: wrong order at %d\n", i);
+            return -1;
+        }
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试超时跳过与tick回绕
+static int TestOverrunAndWrap(void)
+{
+    SensorScheduler sched;
+    SchedulerEntry entry;
+    uint32_t skipped = 0;
+    uint32_t start = 0xFFFFFF00U;
+
+    printf("\nTesting overrun and tick wrap...\n");
+
+    SchedulerInit(&sched);
+    SchedulerAdd(&sched, TEST_ID_SLOW, 100, start, 1);
+
+    if (SchedulerPopDue(&sched, start, &entry) != 0) {
+        printf("FAILED: entry not due\n");
+        return -1;
+    }
+
+    // 执行耗时跨越3个周期, 且跨越tick回绕点
+    uint32_t now = start + 350;
+    SchedulerReschedule(&sched, &entry, now, &skipped);
+    SchedulerPeek(&sched, &entry);
+
+    if (skipped != 3 || entry.due != start + 400) {
+        printf("FAILED: skipped=%u due=%u\n", skipped, entry.due);
+        return -1;
+    }
+
+    if (SchedulerPopDue(&sched, now, &entry) == 0) {
+        printf("FAILED: entry due too early\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sensor Scheduler Test Program\n");
+
+    failed += TestSchedulingRate() != 0;
+    failed += TestPriority() != 0;
+    failed += TestOverrunAndWrap() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/subscription.h"
+
+// 各订阅者收到的样本数量
+static uint32_t g_received[3] = {0};
+
+static void OnAll(const SensorData* data)
+{
+    (void)data;
+    g_received[0]++;
+}
+
+static void OnSmoke(const SensorData* data)
+{
+    (void)data;
+    g_received[1]++;
+}
+
+static void OnTemperature(const SensorData* data)
+{
+    (void)data;
+    g_received[2]++;
+}
+
+// 构造测试数据
+static void MakeData(SensorData* data, SensorType type, uint32_t timestamp, float value)
+{
+    memset(data, 0, sizeof(SensorData));
+    data->type = type;
+    data->timestamp = timestamp;
+    switch (type) {
+        case SENSOR_TYPE_DHT11:
+            data->data.dht11.temperature = value;
+            data->data.dht11.humidity = 50.0f;
+            break;
+        case SENSOR_TYPE_MQ2:
+            data->data.mq2.smoke = value;
+            break;
+        default:
+            data->data.bh1750.light = value;
+            break;
+    }
+}
+
+// 测试类型掩码、最小间隔和死区
+static int TestFilters(void)
+{
+    SubscriptionTable table;
+    SensorData data;
+    SubscriptionFilter all = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK_ALL
+    };
+    SubscriptionFilter smoke = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK(SENSOR_TYPE_MQ2),
+        .min_interval_ms = 500
+    };
+    SubscriptionFilter temperature = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK(SENSOR_TYPE_DHT11),
+        .deadband = {[SENSOR_CHANNEL_TEMPERATURE] = 0.5f}
+    };
+
+    printf("\nTesting subscription filters...\n");
+
+    SubscriptionInit(&table);
+    SubscriptionAdd(&table, OnAll, &all, 0);
+    SubscriptionAdd(&table, OnSmoke, &smoke, 500);
+    SubscriptionAdd(&table, OnTemperature, &temperature, 0);
+
+    // 烟雾每100个时间单位一个样本, 持续1000
+    for (uint32_t ts = 0; ts < 1000; ts += 100) {
+        MakeData(&data, SENSOR_TYPE_MQ2, ts, (float)ts);
+        SubscriptionDispatch(&table, &data);
+    }
+
+    // 温度缓慢变化0.1/样本
+    for (uint32_t i = 0; i < 20; i++) {
+        MakeData(&data, SENSOR_TYPE_DHT11, 1000 + i * 100, 25.0f + i * 0.1f);
+        SubscriptionDispatch(&table, &data);
+    }
+
+    printf("All: %u, Smoke: %u, Temperature: %u\n", g_received[0], g_received[1], g_received[2]);
+    if (g_received[0] != 30 || g_received[1] != 2 || g_received[2] != 4) {
+        printf("FAILED: unexpected delivery count\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试订阅表容量及取消订阅
+static int TestAddRemove(void)
+{
+    SubscriptionTable table;
+    SensorData data;
+    SubscriptionFilter all = {
+        .sensor_mask = COLLECTOR_SENSOR_MASK_ALL
+    };
+    int ids[COLLECTOR_MAX_SUBSCRIBERS];
+
+    printf("\nTesting add/remove...\n");
+
+    SubscriptionInit(&table);
+    for (int i = 0; i < COLLECTOR_MAX_SUBSCRIBERS; i++) {
+        ids[i] = SubscriptionAdd(&table, OnAll, &all, 0);
+    }
+    if (SubscriptionAdd(&table, OnAll, &all, 0) != -1) {
+        printf("FAILED: table should be full\n");
+        return -1;
+    }
+
+    SubscriptionRemove(&table, ids[3]);
+    if (SubscriptionRemove(&table, ids[3]) != -1) {
+        printf("FAILED: double remove accepted\n");
+        return -1;
+    }
+
+    MakeData(&data, SENSOR_TYPE_BH1750, 0, 100.0f);
+    if (SubscriptionDispatch(&table, &data) != COLLECTOR_MAX_SUBSCRIBERS - 1) {
+        printf("FAILED: removed subscriber still called\n");
+        return -1;
+    }
+
+    if (SubscriptionAdd(&table, OnAll, &all, 0) != ids[3]) {
+        printf("FAILED: slot not reused\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Subscription Test Program\n");
+
+    failed += TestFilters() != 0;
+    failed += TestAddRemove() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/trigger_capture.h"
+#include "common/clock.h"
+
+// 测试缓冲区容量
+#define TEST_CAPACITY  8
+
+// 生成测试样本, 时间戳单位为秒
+static void MakeSample(SensorData* data, uint32_t second)
+{
+    memset(data, 0, sizeof(SensorData));
+    data->type = SENSOR_TYPE_MQ2;
+    data->data.mq2.smoke = (float)second;
+    data->timestamp = (uint64_t)second * CLOCK_US_PER_SEC;
+}
+
+// 按时间顺序取出视图中的第index个样本
+static const SensorData* ViewAt(const CaptureView* view, uint32_t index)
+{
+    if (index < view->count[0]) {
+        return &view->part[0][index];
+    }
+    return &view->part[1][index - view->count[0]];
+}
+
+// 测试触发前窗口和触发后窗口
+static int TestWindow(void)
+{
+    TriggerCapture capture;
+    CaptureView view;
+    SensorData data;
+    bool done = false;
+
+    printf("\nTesting window...\n");
+
+    // 触发前保留3秒, 触发后采集2秒
+    TriggerCaptureInit(&capture, TEST_CAPACITY, 3000, 2000);
+    for (uint32_t second = 1; second <= 10; second++) {
+        MakeSample(&data, second);
+        TriggerCapturePush(&capture, &data);
+    }
+    if (TriggerCaptureGet(&capture, &view) == 0) {
+        printf("FAILED: view before trigger\n");
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+
+    // 第10秒触发, 只保留7-10秒的样本
+    TriggerCaptureFire(&capture, 10 * CLOCK_US_PER_SEC);
+    for (uint32_t second = 11; second <= 13 && !done; second++) {
+        MakeSample(&data, second);
+        done = TriggerCapturePush(&capture, &data);
+    }
+
+    // 第13秒的样本超出触发后窗口, 不属于本次捕获
+    if (!done || TriggerCaptureGet(&capture, &view) != 0 || view.pre_count != 4 ||
+        view.count[0] + view.count[1] != 6 || view.truncated) {
+        printf("FAILED: done %d, pre %u, total %u\n", done, view.pre_count, view.count[0] + view.count[1]);
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+    for (uint32_t i = 0; i < 6; i++) {
+        if (ViewAt(&view, i)->timestamp != (7 + i) * CLOCK_US_PER_SEC) {
+            printf("FAILED: sample %u out of order\n", i);
+            TriggerCaptureDeinit(&capture);
+            return -1;
+        }
+    }
+
+    // 冻结期间新样本被丢弃, 不能再次触发
+    MakeSample(&data, 14);
+    TriggerCapturePush(&capture, &data);
+    TriggerCaptureGet(&capture, &view);
+    if (ViewAt(&view, 5)->timestamp != 12 * CLOCK_US_PER_SEC || TriggerCaptureFire(&capture, 0) == 0) {
+        printf("FAILED: frozen capture modified\n");
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+
+    // 释放后可以再次触发
+    TriggerCaptureRearm(&capture);
+    if (TriggerCaptureFire(&capture, 20 * CLOCK_US_PER_SEC) != 0) {
+        printf("FAILED: rearm\n");
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+
+    TriggerCaptureDeinit(&capture);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试写满和超时结束
+static int TestEarlyFinish(void)
+{
+    TriggerCapture capture;
+    CaptureView view;
+    SensorData data;
+    uint32_t pushed = 0;
+
+    printf("\nTesting early finish...\n");
+
+    // 触发后写满时提前结束, 触发前样本不被覆盖
+    TriggerCaptureInit(&capture, TEST_CAPACITY, 60000, 60000);
+    for (uint32_t second = 1; second <= 5; second++) {
+        MakeSample(&data, second);
+        TriggerCapturePush(&capture, &data);
+    }
+    TriggerCaptureFire(&capture, 5 * CLOCK_US_PER_SEC);
+    for (uint32_t second = 6; second <= 20; second++) {
+        MakeSample(&data, second);
+        pushed++;
+        if (TriggerCapturePush(&capture, &data)) {
+            break;
+        }
+    }
+    if (pushed != 3 || TriggerCaptureGet(&capture, &view) != 0 || ViewAt(&view, 0)->timestamp != CLOCK_US_PER_SEC ||
+        !view.truncated) {
+        printf("FAILED: full capture, pushed %u\n", pushed);
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+
+    // 触发后没有样本时按时间结束
+    TriggerCaptureRearm(&capture);
+    TriggerCaptureFire(&capture, 100 * CLOCK_US_PER_SEC);
+    if (TriggerCaptureUpdate(&capture, 150 * CLOCK_US_PER_SEC) ||
+        !TriggerCaptureUpdate(&capture, 161 * CLOCK_US_PER_SEC) ||
+        TriggerCaptureGet(&capture, &view) != 0 || view.count[0] + view.count[1] != view.pre_count ||
+        view.truncated) {
+        printf("FAILED: timeout\n");
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+    TriggerCaptureDeinit(&capture);
+
+    // 触发前窗口内的样本多于容量时标记为不完整
+    TriggerCaptureInit(&capture, TEST_CAPACITY, 60000, 1000);
+    for (uint32_t second = 1; second <= 10; second++) {
+        MakeSample(&data, second);
+        TriggerCapturePush(&capture, &data);
+    }
+    TriggerCaptureFire(&capture, 10 * CLOCK_US_PER_SEC);
+    TriggerCaptureUpdate(&capture, 12 * CLOCK_US_PER_SEC);
+    if (TriggerCaptureGet(&capture, &view) != 0 || view.pre_count != TEST_CAPACITY - 1 || !view.truncated) {
+        printf("FAILED: pre window overflow, pre %u\n", view.pre_count);
+        TriggerCaptureDeinit(&capture);
+        return -1;
+    }
+
+    TriggerCaptureDeinit(&capture);
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Trigger Capture Test Program\n");
+
+    failed += TestWindow() != 0;
+    failed += TestEarlyFinish() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/ts_block.h"
+#include "data/sample_store.h"
+#include "common/clock.h"
+
+// 测试样本数量
+#define TEST_SAMPLE_COUNT  2000
+
+// 测试归档块数量
+#define TEST_ARCHIVE_BLOCKS 2
+
+// 浮点比较容差
+#define TEST_EPSILON       0.01f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试单块编解码往返
+static int TestBlockRoundTrip(void)
+{
+    TsBlock block;
+    TsBlockWriter writer;
+    TsBlockReader reader;
+    uint64_t ts = 0;
+    int16_t value = 0;
+
+    printf("\nTesting block round trip...\n");
+
+    // 覆盖各档前缀码: 固定间隔, 小抖动, 大跳变, 数值原值
+    static const uint32_t times[] = {
+        1000, 2000, 3000, 4000, 4990, 6010, 7000, 7300, 12000, 90000, 90001, 90002
+    };
+    static const int16_t values[] = {
+        2345, 2345, 2346, 2340, 2300, 2100, -1500, 32767, -32768, 0, 7, -8
+    };
+    uint32_t total = sizeof(times) / sizeof(times[0]);
+
+    TsBlockWriterInit(&writer, &block);
+    for (uint32_t i = 0; i < total; i++) {
+        if (TsBlockAppend(&writer, times[i], values[i]) != 0) {
+            printf("FAILED: append %u\n", i);
+            return -1;
+        }
+    }
+
+    // 时间戳倒退被拒绝
+    if (TsBlockAppend(&writer, 80000, 0) == 0) {
+        printf("FAILED: backwards timestamp accepted\n");
+        return -1;
+    }
+
+    TsBlockReaderInit(&reader, &block);
+    for (uint32_t i = 0; i < total; i++) {
+        if (!TsBlockReaderNext(&reader, &ts, &value) || ts != times[i] || value != values[i]) {
+            printf("FAILED: mismatch at %u (ts=%u value=%d)\n", i, (uint32_t)ts, value);
+            return -1;
+        }
+    }
+    if (TsBlockReaderNext(&reader, &ts, &value)) {
+        printf("FAILED: extra sample\n");
+        return -1;
+    }
+
+    printf("Samples: %u, Bits: %u\n", block.count, block.bit_len);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试归档写满覆盖、按时间查询及压缩率
+static int TestArchive(void)
+{
+    TsArchive archive;
+    static ChannelSample samples[TEST_SAMPLE_COUNT];
+    uint32_t count = 0;
+
+    printf("\nTesting archive...\n");
+
+    if (TsArchiveInit(&archive, SENSOR_CHANNEL_TEMPERATURE, TEST_ARCHIVE_BLOCKS) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+
+    // 1s采样, 温度缓慢变化并带偶发的调度抖动, 时间戳单位us
+    uint64_t ts = 5000 * CLOCK_US_PER_MS;
+    for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++) {
+        float temperature = 25.0f + (float)((i / 20) % 10) * 0.1f;
+        TsArchiveAppend(&archive, ts, temperature);
+        ts += ((i % 50 == 0) ? 1003 : 1000) * CLOCK_US_PER_MS;
+    }
+
+    TsArchiveQuery(&archive, 0, ts, samples, TEST_SAMPLE_COUNT, &count);
+    uint32_t raw_bytes = count * sizeof(ChannelSample);
+    uint32_t used_bytes = archive.used * sizeof(TsBlock);
+    printf("Retained: %u samples in %u bytes (raw %u bytes, ratio %.1f)\n",
+        count, used_bytes, raw_bytes, (float)raw_bytes / used_bytes);
+    if (count == 0 || count >= TEST_SAMPLE_COUNT || samples[count - 1].timestamp != ts - 1000 * CLOCK_US_PER_MS) {
+        printf("FAILED: unexpected retention\n");
+        TsArchiveDeinit(&archive);
+        return -1;
+    }
+
+    // 时间戳严格递增, 数值在定点精度内还原
+    for (uint32_t i = 0; i < count; i++) {
+        float value = samples[i].value;
+        if (!FloatEqual(value, SampleStoreDecode(SENSOR_CHANNEL_TEMPERATURE,
+            SampleStoreEncode(SENSOR_CHANNEL_TEMPERATURE, value)))) {
+            printf("FAILED: value out of precision at %u\n", i);
+            TsArchiveDeinit(&archive);
+            return -1;
+        }
+        if (i > 0 && samples[i].timestamp <= samples[i - 1].timestamp) {
+            printf("FAILED: timestamp order at %u\n", i);
+            TsArchiveDeinit(&archive);
+            return -1;
+        }
+    }
+
+    // 逐块复制后解码, 与直接查询的结果一致; 已被覆盖的序号从最旧的块开始
+    static ChannelSample copied[TEST_SAMPLE_COUNT];
+    uint32_t copied_count = 0;
+    TsBlock block;
+    uint32_t sequence = 0;
+    if (TsArchiveSeek(&archive, 0) != archive.sequence - archive.used + 1) {
+        printf("FAILED: seek\n");
+        TsArchiveDeinit(&archive);
+        return -1;
+    }
+    while (TsArchiveCopyBlock(&archive, &sequence, &block) == 0) {
+        copied_count += TsBlockQuery(&block, SENSOR_CHANNEL_TEMPERATURE, 0, ts, &copied[copied_count],
+            TEST_SAMPLE_COUNT - copied_count);
+        sequence++;
+    }
+    if (copied_count != count || memcmp(copied, samples, count * sizeof(ChannelSample)) != 0) {
+        printf("FAILED: block copy returned %u\n", copied_count);
+        TsArchiveDeinit(&archive);
+        return -1;
+    }
+
+    // 按时间范围查询
+    uint64_t since = samples[count - 10].timestamp;
+    uint64_t until = samples[count - 6].timestamp;
+    TsArchiveQuery(&archive, since, until, samples, TEST_SAMPLE_COUNT, &count);
+    if (count != 5 || samples[0].timestamp != since || samples[4].timestamp != until) {
+        printf("FAILED: range query returned %u\n", count);
+        TsArchiveDeinit(&archive);
+        return -1;
+    }
+
+    TsArchiveDeinit(&archive);
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Time Series Block Test Program\n");
+
+    failed += TestBlockRoundTrip() != 0;
+    failed += TestArchive() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <string.h>
+#include "data/virtual_sensor.h"
+
+// 浮点比较容差
+#define TEST_EPSILON 0.3f
+
+static int FloatEqual(float a, float b)
+{
+    float diff = a - b;
+    return diff < TEST_EPSILON && diff > -TEST_EPSILON;
+}
+
+// 测试派生公式, 参考值取自气象查算表
+static int TestFormulas(void)
+{
+    printf("\nTesting formulas...\n");
+
+    float dew_point = VirtualDewPoint(25.0f, 60.0f);
+    float heat_index = VirtualHeatIndex(32.0f, 70.0f);
+    float mild = VirtualHeatIndex(20.0f, 50.0f);
+    float absolute = VirtualAbsoluteHumidity(25.0f, 60.0f);
+    printf("Dew point: %.2f, Heat index: %.2f/%.2f, Absolute humidity: %.2f\n",
+        dew_point, heat_index, mild, absolute);
+
+    if (!FloatEqual(dew_point, 16.7f) || !FloatEqual(heat_index, 40.6f) ||
+        !FloatEqual(mild, 19.4f) || !FloatEqual(absolute, 13.8f)) {
+        printf("FAILED: unexpected value\n");
+        return -1;
+    }
+
+    // 湿度为0时露点仍为有限值
+    float dry = VirtualDewPoint(25.0f, 0.0f);
+    if (!(dry < 0.0f && dry > -100.0f)) {
+        printf("FAILED: dew point at 0%% humidity: %.2f\n", dry);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试按注册表计算虚拟传感器
+static int TestCompute(void)
+{
+    SensorData latest[SENSOR_TYPE_MAX];
+    SensorData data;
+
+    printf("\nTesting compute...\n");
+
+    memset(latest, 0, sizeof(latest));
+    latest[SENSOR_TYPE_DHT11].data.dht11.temperature = 25.0f;
+    latest[SENSOR_TYPE_DHT11].data.dht11.humidity = 60.0f;
+    latest[SENSOR_TYPE_DHT11].timestamp = 1000;
+    latest[SENSOR_TYPE_MQ2].data.mq2.smoke = 50.0f;
+    latest[SENSOR_TYPE_MQ2].timestamp = 3000;
+    latest[SENSOR_TYPE_BH1750].data.bh1750.light = 200.0f;
+    latest[SENSOR_TYPE_BH1750].timestamp = 2000;
+
+    if (VirtualSensorCompute(SENSOR_TYPE_DEW_POINT, latest, &data) != 0 ||
+        data.type != SENSOR_TYPE_DEW_POINT || !FloatEqual(data.data.derived.value, 16.7f) ||
+        data.timestamp != 1000) {
+        printf("FAILED: dew point\n");
+        return -1;
+    }
+
+    // 时间戳取输入中最新的
+    if (VirtualSensorCompute(SENSOR_TYPE_SMOKE_LIGHT_RATIO, latest, &data) != 0 ||
+        !FloatEqual(data.data.derived.value, 0.25f) || data.timestamp != 3000) {
+        printf("FAILED: smoke/light ratio\n");
+        return -1;
+    }
+
+    // 黑暗中按最小光照计算
+    latest[SENSOR_TYPE_BH1750].data.bh1750.light = 0.0f;
+    VirtualSensorCompute(SENSOR_TYPE_SMOKE_LIGHT_RATIO, latest, &data);
+    if (!FloatEqual(data.data.derived.value, 50.0f)) {
+        printf("FAILED: ratio in darkness\n");
+        return -1;
+    }
+
+    // 真实传感器不能按虚拟传感器计算
+    if (VirtualSensorCompute(SENSOR_TYPE_DHT11, latest, &data) == 0 ||
+        VirtualSensorCompute(SENSOR_TYPE_MAX, latest, &data) == 0 ||
+        VirtualSensorInputMask(SENSOR_TYPE_MQ2) != 0 ||
+        VirtualSensorInputMask(SENSOR_TYPE_HEAT_INDEX) != (1U << SENSOR_TYPE_DHT11)) {
+        printf("FAILED: type check\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Virtual Sensor Test Program\n");
+
+    failed += TestFormulas() != 0;
+    failed += TestCompute() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "data/window_minmax.h"
+
+// 测试样本数量
+#define TEST_SAMPLE_COUNT 1000
+
+// 测试窗口长度及队列容量
+#define TEST_WINDOW       50
+#define TEST_CAPACITY     64
+
+// 测试与暴力扫描结果一致
+static int TestAgainstScan(void)
+{
+    WindowMinMax win;
+    static ChannelSample history[TEST_SAMPLE_COUNT];
+    ChannelSample min;
+    ChannelSample max;
+
+    printf("\nTesting against full scan...\n");
+
+    if (WindowMinMaxInit(&win, TEST_WINDOW, TEST_CAPACITY) != 0) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+
+    // 间隔1-3的随机游走
+    srand(1);
+    uint64_t ts = 100;
+    float value = 25.0f;
+    for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++) {
+        ts += 1 + rand() % 3;
+        value += (float)(rand() % 5 - 2) * 0.5f;
+        history[i].timestamp = ts;
+        history[i].value = value;
+        WindowMinMaxPush(&win, ts, value);
+
+        float expect_min = value;
+        float expect_max = value;
+        for (uint32_t j = 0; j <= i; j++) {
+            if (ts - history[j].timestamp >= TEST_WINDOW) {
+                continue;
+            }
+            if (history[j].value < expect_min) {
+                expect_min = history[j].value;
+            }
+            if (history[j].value > expect_max) {
+                expect_max = history[j].value;
+            }
+        }
+
+        if (!WindowMinMaxGet(&win, &min, &max) || min.value != expect_min || max.value != expect_max) {
+            printf("FAILED: mismatch at %u (min %.1f/%.1f, max %.1f/%.1f)\n",
+                i, min.value, expect_min, max.value, expect_max);
+            WindowMinMaxDeinit(&win);
+            return -1;
+        }
+    }
+
+    printf("Deque size: min=%u, max=%u\n", win.min.count, win.max.count);
+    WindowMinMaxDeinit(&win);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试窗口过期及修改窗口长度
+static int TestExpireAndResize(void)
+{
+    WindowMinMax win;
+    ChannelSample min;
+    ChannelSample max;
+
+    printf("\nTesting expiry and resize...\n");
+
+    WindowMinMaxInit(&win, 10, TEST_CAPACITY);
+    WindowMinMaxPush(&win, 0, 90.0f);
+    WindowMinMaxPush(&win, 5, 10.0f);
+    WindowMinMaxPush(&win, 9, 50.0f);
+    WindowMinMaxGet(&win, &min, &max);
+    if (max.value != 90.0f || min.value != 10.0f) {
+        printf("FAILED: initial window\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    // 时间10时样本0过期
+    WindowMinMaxPush(&win, 10, 40.0f);
+    WindowMinMaxGet(&win, &min, &max);
+    if (max.value != 50.0f || max.timestamp != 9 || min.value != 10.0f) {
+        printf("FAILED: expiry\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    // 缩短窗口后样本5也过期
+    WindowMinMaxSetWindow(&win, 3);
+    WindowMinMaxPush(&win, 11, 45.0f);
+    WindowMinMaxGet(&win, &min, &max);
+    if (max.value != 50.0f || min.value != 40.0f) {
+        printf("FAILED: resize\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    WindowMinMaxReset(&win);
+    if (WindowMinMaxGet(&win, &min, &max)) {
+        printf("FAILED: reset\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    WindowMinMaxDeinit(&win);
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试队列溢出及修改容量
+static int TestOverflow(void)
+{
+    WindowMinMax win;
+    ChannelSample min;
+    ChannelSample max;
+
+    printf("\nTesting overflow...\n");
+
+    // 窗口100内单调下降的16个样本, 最大值队列需要16个位置
+    WindowMinMaxInit(&win, 100, 8);
+    for (uint64_t ts = 0; ts < 16; ts++) {
+        WindowMinMaxPush(&win, ts, 100.0f - ts);
+    }
+    if (WindowMinMaxGet(&win, &min, &max)) {
+        printf("FAILED: overflow reported max %.1f\n", max.value);
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    // 被丢弃的样本(时间0-7)全部过期后恢复准确
+    WindowMinMaxPush(&win, 110, 50.0f);
+    if (!WindowMinMaxGet(&win, &min, &max) || max.value != 89.0f || min.value != 50.0f) {
+        printf("FAILED: recovery\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    // 扩容后同样的序列不再溢出
+    WindowMinMaxReset(&win);
+    if (WindowMinMaxResize(&win, 32) != 0) {
+        printf("FAILED: resize\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+    for (uint64_t ts = 200; ts < 216; ts++) {
+        WindowMinMaxPush(&win, ts, 100.0f - (ts - 200));
+    }
+    if (!WindowMinMaxGet(&win, &min, &max) || max.value != 100.0f || min.value != 85.0f) {
+        printf("FAILED: after resize\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    // 缩容时保留最新的候选并标记溢出
+    WindowMinMaxResize(&win, 4);
+    if (win.max.count != 4 || WindowMinMaxGet(&win, &min, &max)) {
+        printf("FAILED: shrink\n");
+        WindowMinMaxDeinit(&win);
+        return -1;
+    }
+
+    WindowMinMaxDeinit(&win);
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Window MinMax Test Program\n");
+
+    failed += TestAgainstScan() != 0;
+    failed += TestExpireAndResize() != 0;
+    failed += TestOverflow() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "drivers/sensor/dht11_decode.h"
+
+// 每个抖动等级生成的帧数
+#define JITTER_FRAMES       2000
+// 测量解码耗时的次数
+#define TIMING_ITERATIONS   100000
+
+// 标称脉宽(us)
+#define NOMINAL_RESPONSE_US 80
+#define NOMINAL_LOW_US      50
+#define NOMINAL_ZERO_US     26
+#define NOMINAL_ONE_US      70
+
+// 逻辑分析仪记录的一次传输, 从响应下降沿开始的各脉宽(us)
+// 湿度55.0%, 温度25.5℃
+static const uint16_t g_recorded_widths[DHT11_EDGE_COUNT - 1] = {
+    80, 80, 54, 28, 48, 23, 56, 68, 53, 72,
+    48, 27, 51, 68, 49, 71, 54, 68, 51, 23,
+    56, 26, 48, 27, 49, 24, 48, 27, 54, 23,
+    51, 23, 56, 24, 52, 26, 50, 27, 49, 27,
+    52, 72, 50, 68, 51, 25, 49, 27, 49, 72,
+    48, 27, 51, 26, 56, 26, 53, 26, 55, 25,
+    52, 69, 50, 28, 51, 68, 52, 27, 55, 70,
+    55, 25, 49, 68, 56, 26, 50, 74, 53, 24,
+    55, 71,
+};
+
+static uint32_t g_seed = 12345;
+
+// 确定性伪随机数, 保证每次运行结果一致
+static uint32_t NextRandom(void)
+{
+    g_seed = g_seed * 1103515245U + 12345U;
+    return g_seed >> 8;
+}
+
+// 在[-jitter, jitter]内随机偏移
+static int32_t Jitter(uint32_t jitter)
+{
+    if (jitter == 0) {
+        return 0;
+    }
+    return (int32_t)(NextRandom() % (jitter * 2 + 1)) - (int32_t)jitter;
+}
+
+// 由脉宽序列生成边沿, 第一个边沿为下降沿, start为起始时间
+static uint32_t WidthsToEdges(const uint16_t* widths, uint32_t count, uint32_t start, DHT11Edge* edges)
+{
+    uint32_t time = start;
+    for (uint32_t i = 0; i <= count; i++) {
+        edges[i].time_us = time;
+        edges[i].level = (uint8_t)(i % 2);
+        if (i < count) {
+            time += widths[i];
+        }
+    }
+    return count + 1;
+}
+
+// 按帧数据合成带抖动的脉宽序列
+static void SynthesizeWidths(const uint8_t frame[DHT11_FRAME_BYTES], uint32_t jitter, uint16_t* widths)
+{
+    uint32_t n = 0;
+    widths[n++] = (uint16_t)(NOMINAL_RESPONSE_US + Jitter(jitter));
+    widths[n++] = (uint16_t)(NOMINAL_RESPONSE_US + Jitter(jitter));
+    for (uint32_t bit = 0; bit < DHT11_FRAME_BYTES * 8; bit++) {
+        int32_t high = (frame[bit / 8] & (0x80 >> (bit % 8))) ? NOMINAL_ONE_US : NOMINAL_ZERO_US;
+        widths[n++] = (uint16_t)(NOMINAL_LOW_US + Jitter(jitter));
+        widths[n++] = (uint16_t)(high + Jitter(jitter));
+    }
+}
+
+// 随机帧数据, 校验和正确
+static void RandomFrame(uint8_t frame[DHT11_FRAME_BYTES])
+{
+    frame[0] = (uint8_t)(20 + NextRandom() % 70);
+    frame[1] = 0;
+    frame[2] = (uint8_t)(NextRandom() % 50);
+    frame[3] = (uint8_t)(NextRandom() % 10);
+    frame[4] = (uint8_t)(frame[0] + frame[1] + frame[2] + frame[3]);
+}
+
+// 测试记录的传输
+static int TestRecordedTrace(void)
+{
+    DHT11Edge edges[DHT11_EDGE_COUNT + 1];
+    uint8_t frame[DHT11_FRAME_BYTES];
+    int16_t temperature;
+    int16_t humidity;
+
+    printf("\nTesting recorded trace...\n");
+
+    // 起始时间接近32位回绕
+    uint32_t count = WidthsToEdges(g_recorded_widths, DHT11_EDGE_COUNT - 1, 0xFFFFFF00U, edges);
+    if (DHT11Decode(edges, count, frame) != DHT11_DECODE_OK) {
+        printf("FAILED: decode\n");
+        return -1;
+    }
+
+    DHT11FrameToRaw(frame, &temperature, &humidity);
+    printf("Temperature: %d, Humidity: %d\n", temperature, humidity);
+    if (temperature != 255 || humidity != 550) {
+        printf("FAILED: unexpected value\n");
+        return -1;
+    }
+
+    // 记录到主机释放数据线的上升沿时跳过
+    memmove(&edges[1], &edges[0], count * sizeof(DHT11Edge));
+    edges[0].time_us = edges[1].time_us - 30;
+    edges[0].level = 1;
+    if (DHT11Decode(edges, count + 1, frame) != DHT11_DECODE_OK) {
+        printf("FAILED: leading rising edge\n");
+        return -1;
+    }
+
+    // 负温度标志
+    frame[3] |= 0x80;
+    DHT11FrameToRaw(frame, &temperature, &humidity);
+    if (temperature != -255) {
+        printf("FAILED: negative temperature %d\n", temperature);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试损坏的传输不会被解码为错误数据
+static int TestCorruptedTrace(void)
+{
+    DHT11Edge edges[DHT11_EDGE_COUNT + 2];
+    uint16_t widths[DHT11_EDGE_COUNT - 1];
+    uint8_t frame[DHT11_FRAME_BYTES];
+
+    printf("\nTesting corrupted trace...\n");
+
+    // 传输未完成
+    uint32_t count = WidthsToEdges(g_recorded_widths, DHT11_EDGE_COUNT - 1, 0, edges);
+    if (DHT11Decode(edges, count - 1, frame) != DHT11_DECODE_SHORT ||
+        DHT11Decode(edges, 0, frame) != DHT11_DECODE_SHORT) {
+        printf("FAILED: short trace\n");
+        return -1;
+    }
+
+    // 漏掉一个边沿, 之后的电平不再交替
+    memmove(&edges[40], &edges[41], (count - 41) * sizeof(DHT11Edge));
+    edges[count - 1] = edges[count - 2];
+    edges[count - 1].level ^= 1;
+    edges[count - 1].time_us += 50;
+    if (DHT11Decode(edges, count, frame) == DHT11_DECODE_OK) {
+        printf("FAILED: missing edge\n");
+        return -1;
+    }
+
+    // 高电平中间出现2us的毛刺
+    count = WidthsToEdges(g_recorded_widths, DHT11_EDGE_COUNT - 1, 0, edges);
+    memmove(&edges[9], &edges[7], (count - 7) * sizeof(DHT11Edge));
+    edges[7].time_us = edges[6].time_us + 10;
+    edges[7].level = 0;
+    edges[8].time_us = edges[7].time_us + 2;
+    edges[8].level = 1;
+    if (DHT11Decode(edges, count + 2, frame) == DHT11_DECODE_OK) {
+        printf("FAILED: glitch\n");
+        return -1;
+    }
+
+    // 一位翻转时校验和错误
+    memcpy(widths, g_recorded_widths, sizeof(widths));
+    widths[3] = NOMINAL_ONE_US;
+    count = WidthsToEdges(widths, DHT11_EDGE_COUNT - 1, 0, edges);
+    if (DHT11Decode(edges, count, frame) != DHT11_DECODE_CHECKSUM) {
+        printf("FAILED: checksum\n");
+        return -1;
+    }
+
+    // 校验和按低8位比较
+    const uint8_t overflow[DHT11_FRAME_BYTES] = {90, 9, 80, 9, (uint8_t)(90 + 9 + 80 + 9)};
+    SynthesizeWidths(overflow, 0, widths);
+    count = WidthsToEdges(widths, DHT11_EDGE_COUNT - 1, 0, edges);
+    if (DHT11Decode(edges, count, frame) != DHT11_DECODE_OK || memcmp(frame, overflow, sizeof(overflow)) != 0) {
+        printf("FAILED: checksum overflow\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试不同抖动下的错误率
+static int TestJitter(void)
+{
+    static const uint32_t levels[] = {0, 5, 10, 15, 20, 25};
+    DHT11Edge edges[DHT11_EDGE_COUNT];
+    uint16_t widths[DHT11_EDGE_COUNT - 1];
+    uint8_t expected[DHT11_FRAME_BYTES];
+    uint8_t frame[DHT11_FRAME_BYTES];
+    int ret = 0;
+
+    printf("\nTesting jitter...\n");
+
+    for (uint32_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        uint32_t errors = 0;
+        uint32_t wrong = 0;
+        for (uint32_t n = 0; n < JITTER_FRAMES; n++) {
+            RandomFrame(expected);
+            SynthesizeWidths(expected, levels[i], widths);
+            uint32_t count = WidthsToEdges(widths, DHT11_EDGE_COUNT - 1, NextRandom(), edges);
+            if (DHT11Decode(edges, count, frame) != DHT11_DECODE_OK) {
+                errors++;
+            } else if (memcmp(frame, expected, sizeof(frame)) != 0) {
+                wrong++;
+            }
+        }
+        printf("Jitter +/-%2uus: %u/%u errors (%.2f%%), %u wrong\n", (unsigned)levels[i], (unsigned)errors,
+            (unsigned)JITTER_FRAMES, errors * 100.0 / JITTER_FRAMES, (unsigned)wrong);
+
+        // 抖动不超过15us时全部成功; 不超过20us时高电平不会越过判定阈值
+        if ((levels[i] <= 15 && errors != 0) || (levels[i] <= 20 && wrong != 0)) {
+            ret = -1;
+        }
+    }
+
+    printf(ret == 0 ? "PASSED\n" : "FAILED\n");
+    return ret;
+}
+
+// 测量解码耗时
+static int TestDecodeTime(void)
+{
+    DHT11Edge edges[DHT11_EDGE_COUNT];
+    uint8_t frame[DHT11_FRAME_BYTES];
+    uint32_t ok = 0;
+
+    printf("\nTesting decode time...\n");
+
+    uint32_t count = WidthsToEdges(g_recorded_widths, DHT11_EDGE_COUNT - 1, 0, edges);
+    clock_t start = clock();
+    for (uint32_t i = 0; i < TIMING_ITERATIONS; i++) {
+        edges[0].time_us = i & 0x0F;  // 防止循环被优化掉
+        ok += DHT11Decode(edges, count, frame) == DHT11_DECODE_OK;
+    }
+    clock_t end = clock();
+
+    double us = (double)(end - start) * 1000000.0 / CLOCKS_PER_SEC / TIMING_ITERATIONS;
+    printf("Decode time: %.3fus per frame\n", us);
+    if (ok != TIMING_ITERATIONS) {
+        printf("FAILED: %u/%u decoded\n", (unsigned)ok, (unsigned)TIMING_ITERATIONS);
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("DHT11 Decode Test Program\n");
+
+    failed += TestRecordedTrace() != 0;
+    failed += TestCorruptedTrace() != 0;
+    failed += TestJitter() != 0;
+    failed += TestDecodeTime() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}
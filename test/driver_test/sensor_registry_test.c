@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <unistd.h>
+#include "drivers/sensor/sensor_registry.h"
+#include "drivers/sensor/sensor_sim.h"
+
+static int g_init_calls = 0;
+static int g_deinit_calls = 0;
+
+static sensor_status_t fake_init(void)
+{
+    g_init_calls++;
+    return SENSOR_OK;
+}
+
+static sensor_status_t fake_init_fail(void)
+{
+    g_init_calls++;
+    return SENSOR_ERROR_GPIO;
+}
+
+static sensor_status_t fake_deinit(void)
+{
+    g_deinit_calls++;
+    return SENSOR_OK;
+}
+
+static sensor_status_t fake_read_raw(sensor_raw_t* raw)
+{
+    raw->mask = 1U << SENSOR_RAW_LIGHT;
+    raw->value[SENSOR_RAW_LIGHT] = 1234;
+    return SENSOR_OK;
+}
+
+static const sensor_ops_t g_fake_ops = {
+    .type = SENSOR_TYPE_LIGHT,
+    .init = fake_init,
+    .deinit = fake_deinit,
+    .read_raw = fake_read_raw,
+    .caps = {200, SENSOR_BUS_I2C, 0}
+};
+
+// 测试注册、替换和注销
+static int TestRegister(void)
+{
+    const sensor_ops_t no_raw = {.type = SENSOR_TYPE_SMOKE};
+    const sensor_ops_t bad_type = {.type = SENSOR_TYPE_COUNT, .read_raw = fake_read_raw};
+
+    printf("\nTesting register...\n");
+
+    if (SensorGetOps(SENSOR_TYPE_LIGHT) != NULL || SensorGetOps(SENSOR_TYPE_COUNT) != NULL) {
+        printf("FAILED: registry not empty\n");
+        return -1;
+    }
+
+    // 缺少原始读取接口或类型越界的驱动不能注册
+    if (SensorRegister(NULL) == 0 || SensorRegister(&no_raw) == 0 || SensorRegister(&bad_type) == 0) {
+        printf("FAILED: invalid driver registered\n");
+        return -1;
+    }
+
+    // 模拟驱动注册后可被真实驱动替换
+    if (SensorSimRegister() != 0 || SensorGetOps(SENSOR_TYPE_LIGHT) == NULL ||
+        SensorGetOps(SENSOR_TYPE_LIGHT)->caps.bus != SENSOR_BUS_NONE) {
+        printf("FAILED: simulated driver\n");
+        return -1;
+    }
+    if (SensorRegister(&g_fake_ops) != 0 || SensorGetOps(SENSOR_TYPE_LIGHT) != &g_fake_ops) {
+        printf("FAILED: replace\n");
+        return -1;
+    }
+
+    sensor_raw_t raw = {0};
+    const sensor_ops_t* ops = SensorGetOps(SENSOR_TYPE_LIGHT);
+    if (ops->read_raw(&raw) != SENSOR_OK || raw.value[SENSOR_RAW_LIGHT] != 1234 || ops->caps.min_interval_ms != 200) {
+        printf("FAILED: dispatch\n");
+        return -1;
+    }
+
+    SensorUnregister(SENSOR_TYPE_LIGHT);
+    if (SensorGetOps(SENSOR_TYPE_LIGHT) != NULL) {
+        printf("FAILED: unregister\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试批量初始化和反初始化
+static int TestInitAll(void)
+{
+    sensor_ops_t failing = g_fake_ops;
+
+    printf("\nTesting init all...\n");
+
+    SensorSimRegister();
+    SensorRegister(&g_fake_ops);
+    g_init_calls = 0;
+    if (SensorInitAll() != SENSOR_OK || g_init_calls != 1) {
+        printf("FAILED: init\n");
+        return -1;
+    }
+
+    SensorDeinitAll();
+    if (g_deinit_calls != 1) {
+        printf("FAILED: deinit\n");
+        return -1;
+    }
+
+    // 返回第一个失败的错误码
+    failing.init = fake_init_fail;
+    SensorRegister(&failing);
+    if (SensorInitAll() != SENSOR_ERROR_GPIO) {
+        printf("FAILED: init error\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试模拟驱动的读数和故障
+static int TestSimulated(void)
+{
+    sensor_raw_t raw = {0};
+    sensor_data_t data;
+
+    printf("\nTesting simulated driver...\n");
+
+    SensorSimRegister();
+    const sensor_ops_t* ops = SensorGetOps(SENSOR_TYPE_TEMP_HUMID);
+    if (ops->read_raw(&raw) != SENSOR_OK || raw.value[SENSOR_RAW_TEMPERATURE] != 250 ||
+        ops->read(&data) != SENSOR_OK || data.humidity < 49.9f || data.humidity > 50.1f) {
+        printf("FAILED: default value\n");
+        return -1;
+    }
+
+    raw.value[SENSOR_RAW_TEMPERATURE] = -55;
+    SensorSimSetRaw(SENSOR_TYPE_TEMP_HUMID, &raw);
+    SensorSimSetStatus(SENSOR_TYPE_SMOKE, SENSOR_ERROR_TIMEOUT);
+    if (ops->read_raw(&raw) != SENSOR_OK || raw.value[SENSOR_RAW_TEMPERATURE] != -55 ||
+        SensorGetOps(SENSOR_TYPE_SMOKE)->read_raw(&raw) != SENSOR_ERROR_TIMEOUT) {
+        printf("FAILED: set value\n");
+        return -1;
+    }
+
+    printf("Reads: %u/%u\n", SensorSimGetReads(SENSOR_TYPE_TEMP_HUMID), SensorSimGetReads(SENSOR_TYPE_SMOKE));
+    if (SensorSimGetReads(SENSOR_TYPE_TEMP_HUMID) != 3 || SensorSimGetReads(SENSOR_TYPE_SMOKE) != 1) {
+        printf("FAILED: read count\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+// 测试异步驱动的触发和读取
+static int TestAsync(void)
+{
+    sensor_ops_t no_start = g_fake_ops;
+    sensor_raw_t raw = {0};
+
+    printf("\nTesting async driver...\n");
+
+    // 异步驱动必须提供触发接口
+    no_start.caps.flags = SENSOR_CAP_ASYNC;
+    if (SensorRegister(&no_start) == 0) {
+        printf("FAILED: async driver without start\n");
+        return -1;
+    }
+
+    SensorSimSetConversion(SENSOR_TYPE_LIGHT, 50);
+    SensorSimRegister();
+    const sensor_ops_t* ops = SensorGetOps(SENSOR_TYPE_LIGHT);
+    if (!(ops->caps.flags & SENSOR_CAP_ASYNC) || ops->caps.conversion_ms != 50) {
+        printf("FAILED: caps\n");
+        return -1;
+    }
+
+    // 未触发时读取失败, 转换完成前返回忙, 完成后读取一次
+    if (ops->read_raw(&raw) != SENSOR_ERROR_DATA || ops->start() != SENSOR_OK ||
+        ops->read_raw(&raw) != SENSOR_ERROR_BUSY) {
+        printf("FAILED: before conversion\n");
+        return -1;
+    }
+    usleep(60 * 1000);
+    if (ops->read_raw(&raw) != SENSOR_OK || raw.value[SENSOR_RAW_LIGHT] != 360 ||
+        ops->read_raw(&raw) != SENSOR_ERROR_DATA) {
+        printf("FAILED: after conversion\n");
+        return -1;
+    }
+
+    SensorSimSetConversion(SENSOR_TYPE_LIGHT, 0);
+    if (ops->read_raw(&raw) != SENSOR_OK) {
+        printf("FAILED: back to sync\n");
+        return -1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("Sensor Registry Test Program\n");
+
+    failed += TestRegister() != 0;
+    failed += TestInitAll() != 0;
+    failed += TestSimulated() != 0;
+    failed += TestAsync() != 0;
+
+    printf("\nTest completed, %d failed.\n", failed);
+    return failed;
+}